@@ -0,0 +1,133 @@
+/*============================================================================
+ * attract.c
+ *============================================================================
+ * Attract mode implementation (idle timers, autoplay predictor)
+ * Compiles to nothing unless ATTRACT_MODE is defined
+ *==========================================================================*/
+
+#include "attract.h"
+
+#ifdef ATTRACT_MODE
+
+#include "game_controller.h"
+
+/*============================================================================
+ * HELPER FUNCTIONS
+ *==========================================================================*/
+
+/**
+ * Whole pixel of a Q8.8 coordinate, kept within the field lines
+ */
+static uint8_t field_pixel(int32_t value, uint16_t low, uint16_t high) {
+    if (value < low) value = low;
+    if (value > high) value = high;
+    return (uint8_t)(value >> FIXED_SHIFT);
+}
+
+/**
+ * Ticks a demo spends in a state before the autoplay presses button 1
+ * @return Ticks, 0 for states that end by themselves
+ */
+static uint16_t demo_state_ticks(uint8_t state) {
+    switch (state) {
+        case GAME_STATE_TITLE:        return ATTRACT_TITLE_TICKS;
+        case GAME_STATE_BALL_AT_REST: return ATTRACT_LAUNCH_TICKS;
+        case GAME_STATE_GAME_OVER:    return ATTRACT_GAME_OVER_TICKS;
+        default:                      return 0;
+    }
+}
+
+/*============================================================================
+ * ATTRACT OPERATIONS
+ *==========================================================================*/
+
+void init_attract(Attract* attract) {
+    attract->active = 0;
+    attract->state = GAME_STATE_TITLE;
+    attract->timer = 0;
+    attract->games = 0;
+}
+
+AttractAction attract_update(Attract* attract, uint8_t state, uint8_t pressed) {
+    if (state != attract->state) {
+        attract->state = state;
+        attract->timer = 0;
+    }
+    if (attract->timer < 0xFFFF) attract->timer++;
+
+    if (!attract->active) {
+        // Idle title screen: start the first demo game
+        if (state != GAME_STATE_TITLE || pressed) {
+            attract->timer = 0;
+            return ATTRACT_NONE;
+        }
+        if (attract->timer < ATTRACT_IDLE_TICKS) return ATTRACT_NONE;
+        attract->active = 1;
+        attract->timer = 0;
+        attract->games++;
+        return ATTRACT_PRESS;
+    }
+
+    if (pressed) {
+        attract->active = 0;
+        attract->timer = 0;
+        return ATTRACT_EXIT;
+    }
+
+    uint16_t ticks = demo_state_ticks(state);
+    if (ticks == 0 || attract->timer < ticks) return ATTRACT_NONE;
+    attract->timer = 0;
+    if (state == GAME_STATE_TITLE) attract->games++;                          // Next demo game
+    return ATTRACT_PRESS;
+}
+
+uint8_t attract_steering(const Attract* attract) {
+    if (!attract->active) return 0;
+    return attract->state != GAME_STATE_BALL_MOVING || attract->timer < ATTRACT_PLAY_TICKS;
+}
+
+uint16_t attract_launch_seed(const Attract* attract) {
+    return (uint16_t)(attract->games * ATTRACT_SEED_STRIDE);
+}
+
+AttractPrediction attract_predict(FixedPoint position, FixedVector velocity, const AttractField* field) {
+    int32_t x = position.x;
+    int32_t y = position.y;
+    int16_t vx = velocity.x;
+    int16_t vy = velocity.y;
+
+    AttractPrediction next = {ATTRACT_NO_HIT, field_pixel(x, field->left, field->right),
+                              ATTRACT_NO_HIT, field_pixel(y, field->top, field->bottom)};
+    if (vx == 0 && vy == 0) return next;                                     // At rest
+
+    for (uint8_t step = 1; step <= ATTRACT_PREDICT_STEPS; step++) {
+        x += vx;
+        y += vy;
+
+        // Left or right line: the vertical paddles meet it here, then it
+        // comes back mirrored
+        if (x < field->left || x > field->right) {
+            if (next.vertical_steps == ATTRACT_NO_HIT) {
+                next.vertical_steps = step;
+                next.vertical_y = field_pixel(y, field->top, field->bottom);
+            }
+            x = (x < field->left) ? 2 * (int32_t)field->left - x : 2 * (int32_t)field->right - x;
+            vx = -vx;
+        }
+
+        // Top or bottom line: the horizontal paddles
+        if (y < field->top || y > field->bottom) {
+            if (next.horizontal_steps == ATTRACT_NO_HIT) {
+                next.horizontal_steps = step;
+                next.horizontal_x = field_pixel(x, field->left, field->right);
+            }
+            y = (y < field->top) ? 2 * (int32_t)field->top - y : 2 * (int32_t)field->bottom - y;
+            vy = -vy;
+        }
+
+        if (next.horizontal_steps != ATTRACT_NO_HIT && next.vertical_steps != ATTRACT_NO_HIT) break;
+    }
+    return next;
+}
+
+#endif // ATTRACT_MODE
@@ -0,0 +1,173 @@
+/*============================================================================
+ * attract.h
+ *============================================================================
+ * Attract mode: the game plays itself after the title screen sits idle
+ *
+ * After ATTRACT_IDLE_TICKS on the title screen without a press of button 1,
+ * demo games start and repeat: title (ATTRACT_TITLE_TICKS), ball at rest
+ * (ATTRACT_LAUNCH_TICKS), play until a ball reaches a wall, game over
+ * (ATTRACT_GAME_OVER_TICKS), title again. The autoplay presses button 1
+ * for the game, so every state runs through the real
+ * update_game_controller() / draw_game_controller() / refreshDisplay()
+ * pipeline. A real press of button 1 ends the demo and returns to the title
+ * screen. The autoplay rarely misses, so it lets go of the paddles after
+ * ATTRACT_PLAY_TICKS of play and the game ends.
+ *
+ * The paddles follow a ball-trajectory predictor instead of the joystick:
+ * each ball is stepped forward with its velocity, reflecting off the lines
+ * the paddles guard, to where it next reaches a horizontal paddle and a
+ * vertical one. The paddles head for the ball that gets to them first.
+ * Integer only, no divisions.
+ *
+ * Launch directions come from the demo game count instead of the ADC noise,
+ * so a demo session does not depend on the inputs: the same build plays the
+ * same games every time. That makes it a soak and performance workload:
+ * with PROFILER_ENABLED the worst frame and the deadline misses since boot
+ * are reported with every window (see profiler.h). Demo games skip the
+ * blocking game over flash, which would otherwise be the worst frame.
+ *
+ * Build flags:
+ *     ATTRACT_MODE - compile attract mode in (otherwise ATTRACT_ACTIVE()
+ *                    is 0 and attract.c is empty). Without it the title
+ *                    screen waits for a press, and the display can time out
+ *                    there (power.h), which it never does in attract mode
+ *     ATTRACT_SOAK - demo balls launch at ATTRACT_SOAK_SPEED times the
+ *                    normal speed (combine with PANIC_MODE for multi-ball),
+ *                    and the title, launch and game over pauses are cut to
+ *                    ATTRACT_SOAK_PAUSE_TICKS so the run is mostly play
+ *
+ * USAGE (game_controller.c):
+ *     AttractAction action = attract_update(&ctrl->attract, ctrl->state, pressed);
+ *
+ *     if (attract_steering(&ctrl->attract)) {
+ *         AttractPrediction next = attract_predict(ball.position, ball.velocity, &field);
+ *     }
+ *==========================================================================*/
+
+#ifndef ATTRACT_H
+#define ATTRACT_H
+
+#include <stdint.h>
+#include "physics.h"
+#include "timer.h"
+
+/*============================================================================
+ * ATTRACT CONFIGURATION
+ *==========================================================================*/
+
+#define ATTRACT_IDLE_TICKS       (10 * TICK_RATE_HZ)                // Idle title before the first demo
+#define ATTRACT_PLAY_TICKS       (60 * TICK_RATE_HZ)                // Play before the autoplay lets go
+#define ATTRACT_PREDICT_STEPS    64                                 // Physics steps looked ahead
+#define ATTRACT_NO_HIT           0xFF                               // Not reached within the look-ahead
+#define ATTRACT_SEED_STRIDE      0x9E37                             // Launch seed step per demo game
+#define ATTRACT_SOAK_SPEED       2                                  // Launch speed factor (ATTRACT_SOAK)
+#define ATTRACT_SOAK_PAUSE_TICKS (TICK_RATE_HZ / 4)                 // Every pause in ATTRACT_SOAK
+
+#ifdef ATTRACT_SOAK
+#define ATTRACT_TITLE_TICKS      ATTRACT_SOAK_PAUSE_TICKS
+#define ATTRACT_LAUNCH_TICKS     ATTRACT_SOAK_PAUSE_TICKS
+#define ATTRACT_GAME_OVER_TICKS  ATTRACT_SOAK_PAUSE_TICKS
+#else
+#define ATTRACT_TITLE_TICKS      (3 * TICK_RATE_HZ)                 // Title between demo games
+#define ATTRACT_LAUNCH_TICKS     (1 * TICK_RATE_HZ)                 // Ball at rest before the launch
+#define ATTRACT_GAME_OVER_TICKS  (2 * TICK_RATE_HZ)                 // Final score shown
+#endif
+
+/*============================================================================
+ * ATTRACT TYPES
+ *==========================================================================*/
+
+/**
+ * What the game should do after attract_update()
+ */
+typedef enum {
+    ATTRACT_NONE,               // Nothing: use the real button 1 press
+    ATTRACT_PRESS,              // Act as if button 1 was pressed
+    ATTRACT_EXIT                // Real press: the demo ended, go to the title
+} AttractAction;
+
+/**
+ * Attract mode state (one per game controller)
+ */
+typedef struct {
+    uint8_t active;             // Demo running
+    uint8_t state;              // GameState the timer runs for
+    uint16_t timer;             // Ticks in that state
+    uint16_t games;             // Demo games started
+} Attract;
+
+/**
+ * Lines the ball centre reaches when it touches a paddle (Q8.8)
+ */
+typedef struct {
+    uint16_t left;
+    uint16_t right;
+    uint16_t top;
+    uint16_t bottom;
+} AttractField;
+
+/**
+ * Where a ball next reaches the paddle lines
+ */
+typedef struct {
+    uint8_t horizontal_steps;   // Physics steps to the top or bottom line (ATTRACT_NO_HIT: never)
+    uint8_t horizontal_x;       // Ball x there (pixels)
+    uint8_t vertical_steps;     // Physics steps to the left or right line (ATTRACT_NO_HIT: never)
+    uint8_t vertical_y;         // Ball y there (pixels)
+} AttractPrediction;
+
+/*============================================================================
+ * ATTRACT OPERATIONS
+ *==========================================================================*/
+
+#ifdef ATTRACT_MODE
+
+/**
+ * Reset to the idle title screen
+ * @param attract Attract mode state
+ */
+void init_attract(Attract* attract);
+
+/**
+ * Advance the idle and demo timers by one tick
+ * @param attract Attract mode state
+ * @param state Current GameState
+ * @param pressed Real press of button 1 this tick
+ * @return Action for the game's state machine
+ */
+AttractAction attract_update(Attract* attract, uint8_t state, uint8_t pressed);
+
+/**
+ * Check whether the autoplay steers the paddles
+ * @param attract Attract mode state
+ * @return 1 during a demo game until ATTRACT_PLAY_TICKS of play, 0 otherwise
+ */
+uint8_t attract_steering(const Attract* attract);
+
+/**
+ * Launch seed of the current demo game (replaces the ADC noise)
+ * @param attract Attract mode state
+ * @return Seed value
+ */
+uint16_t attract_launch_seed(const Attract* attract);
+
+/**
+ * Predict where a ball next reaches the paddle lines
+ * Each axis is stepped on its own and reflected at the field lines, as the
+ * paddles would bounce it; other balls and obstacles are ignored
+ * @param position Ball position (Q8.8)
+ * @param velocity Ball velocity (Q8.8 pixels per physics step)
+ * @param field Paddle lines
+ * @return Steps and coordinates of the next horizontal and vertical hits
+ */
+AttractPrediction attract_predict(FixedPoint position, FixedVector velocity, const AttractField* field);
+
+#define ATTRACT_ACTIVE(ctrl)    ((ctrl)->attract.active)
+
+#else
+
+#define ATTRACT_ACTIVE(ctrl)    0
+
+#endif // ATTRACT_MODE
+
+#endif // ATTRACT_H
@@ -0,0 +1,374 @@
+/*============================================================================
+ * bench.c
+ *============================================================================
+ * Rendering micro-benchmark implementation
+ * Host builds always compile it (host/bench_main.c); the firmware only with
+ * BENCH_MODE. The CRCs are taken over buffer, so DISPLAY_STRIP builds
+ * (no buffer) leave it out.
+ *==========================================================================*/
+
+#include "bench.h"
+
+#if defined(BENCH_MODE) && defined(DISPLAY_STRIP)
+#error "BENCH_MODE needs the frame buffer: build it without DISPLAY_STRIP"
+#endif
+
+#if (defined(BENCH_MODE) || defined(HAL_HOST)) && !defined(DISPLAY_STRIP)
+
+#include <stddef.h>
+#include "screens.h"
+#include "shapes.h"
+#include "text.h"
+
+_Static_assert(BENCH_CASE_COUNT <= 256, "case index is 8 bits");
+
+/*============================================================================
+ * CASE TABLES
+ *==========================================================================*/
+
+static const uint8_t SIZES[BENCH_SIZE_COUNT] = {BENCH_SIZE_SMALL, BENCH_SIZE_LARGE};
+
+// Inside (off the byte grid), clipped at the top-left, clipped at the bottom-right
+static const Point POSITIONS[BENCH_POSITION_COUNT] = {{21, 13}, {-7, -5}, {108, 54}};
+
+static const OLED_color COLORS[BENCH_COLOR_COUNT] = {COLOR_WHITE, COLOR_BLACK, COLOR_INVERT};
+
+static const char* const KIND_NAMES[BENCH_KIND_COUNT] = {
+    "pixels", "hline", "vline", "line", "fillRect", "circle", "filledCircle",
+    "sprite", "pageBitmap", "text",
+    "frameFull", "frameBall", "framePaddles", "framePaused", "frameTitle", "frameGameOver"
+};
+
+// Sprite columns (16 rows each): a diamond repeated every 8 columns
+static const uint16_t SPRITE_COLUMNS[BENCH_SIZE_LARGE / 2] = {
+    0x0180, 0x03C0, 0x07E0, 0x0FF0, 0x0FF0, 0x07E0, 0x03C0, 0x0180,
+    0x0180, 0x03C0, 0x07E0, 0x0FF0, 0x0FF0, 0x07E0, 0x03C0, 0x0180
+};
+
+// Page bitmap data: two pages of BENCH_SIZE_LARGE columns in a 4-pixel
+// checker (the small case uses the first 8 columns of the top page)
+static const uint8_t BITMAP_DATA[BENCH_SIZE_LARGE * (BENCH_SIZE_LARGE / 2 / 8)] = {
+    0x0F, 0x0F, 0x0F, 0x0F, 0xF0, 0xF0, 0xF0, 0xF0, 0x0F, 0x0F, 0x0F, 0x0F, 0xF0, 0xF0, 0xF0, 0xF0,
+    0x0F, 0x0F, 0x0F, 0x0F, 0xF0, 0xF0, 0xF0, 0xF0, 0x0F, 0x0F, 0x0F, 0x0F, 0xF0, 0xF0, 0xF0, 0xF0,
+    0xF0, 0xF0, 0xF0, 0xF0, 0x0F, 0x0F, 0x0F, 0x0F, 0xF0, 0xF0, 0xF0, 0xF0, 0x0F, 0x0F, 0x0F, 0x0F,
+    0xF0, 0xF0, 0xF0, 0xF0, 0x0F, 0x0F, 0x0F, 0x0F, 0xF0, 0xF0, 0xF0, 0xF0, 0x0F, 0x0F, 0x0F, 0x0F
+};
+
+/*============================================================================
+ * GOLDEN CHECKSUMS
+ *==========================================================================*/
+
+// Printed by paddlepanic_bench --golden; regenerate only for an intended
+// rendering change
+static const uint32_t GOLDEN_PRIMITIVES[BENCH_PRIMITIVE_CASES] = {
+    0x39E4C081UL, 0x1EDAC572UL, 0xC466D3CCUL, 0xE358D63FUL,
+    0xB7FD1F01UL, 0xB7FD1F01UL, 0x7A3CD09BUL, 0x667154E4UL,
+    0xFF155240UL, 0x9C712598UL, 0x3C566CC6UL, 0x437F9F61UL,
+    0x274AB420UL, 0x5385FE17UL, 0x97979C08UL, 0x0DDDE504UL,
+    0x5612E314UL, 0xB897D02FUL, 0x3739848FUL, 0x393A845CUL,
+    0xED5BD6ECUL, 0xE358D63FUL, 0xE358D63FUL, 0xE358D63FUL,
+    0x071D02A5UL, 0xF366E9B1UL, 0x17233D2BUL, 0x6F944FBCUL,
+    0xFCBDA661UL, 0x70713FE2UL, 0xE358D63FUL, 0xE358D63FUL,
+    0xE358D63FUL, 0x9EE9294EUL, 0xC427266AUL, 0xB996D91BUL,
+    0xBB636FA0UL, 0xE358D63FUL, 0xBB636FA0UL, 0xE358D63FUL,
+    0xE358D63FUL, 0xE358D63FUL, 0xE358D63FUL, 0xD7849602UL,
+    0xD7849602UL, 0xFE9304C7UL, 0xE358D63FUL, 0xFE9304C7UL,
+    0xE358D63FUL, 0xE358D63FUL, 0xE358D63FUL, 0xE358D63FUL,
+    0x898D7638UL, 0x898D7638UL, 0xC5A7725CUL, 0xC5CC190FUL,
+    0xE333BD6CUL, 0x4E780AD4UL, 0xE40FFC18UL, 0x492F20F3UL,
+    0x9C6DD45AUL, 0xDEFF76EAUL, 0xA1CA748FUL, 0xC1A8171EUL,
+    0x118F4E89UL, 0x337F8FA8UL, 0x34B9172BUL, 0xF14CBBC7UL,
+    0x26AD7AD3UL, 0x014FDABAUL, 0x7E68B69CUL, 0x9C7FBA19UL,
+    0xA4E4CF63UL, 0xED8EF5D1UL, 0xAA32EC8DUL, 0xE358D63FUL,
+    0xE358D63FUL, 0xE358D63FUL, 0x12A8FE31UL, 0x04110B10UL,
+    0xF5E1231EUL, 0x05B8867CUL, 0x60549470UL, 0x86B4C433UL,
+    0xE358D63FUL, 0xE358D63FUL, 0xE358D63FUL, 0x6571A25BUL,
+    0xA9015A0AUL, 0x2F282E6EUL, 0x6F892F4BUL, 0xD2EDDFE6UL,
+    0x5E3C2692UL, 0xE358D63FUL, 0xE358D63FUL, 0xE358D63FUL,
+    0x890F2083UL, 0x090DE09CUL, 0x635A1620UL, 0x8F10FB8BUL,
+    0x8DA2AA83UL, 0xFFCD2DE0UL, 0xE358D63FUL, 0xE358D63FUL,
+    0xE358D63FUL, 0xADB20690UL, 0x0D04E3B8UL, 0x6185F398UL,
+    0x3C2A9670UL, 0xBE7F4942UL, 0x610D090DUL, 0xE358D63FUL,
+    0xE358D63FUL, 0xE358D63FUL, 0x57AA8FEAUL, 0x53DBDF20UL,
+    0xE72986F5UL, 0x63029AA3UL, 0xAA26E058UL, 0x2A7CACC4UL,
+    0xE358D63FUL, 0xE358D63FUL, 0xE358D63FUL, 0xD36CACD4UL,
+    0xDE94BA97UL, 0xEEA0C07CUL, 0x4A13CD30UL, 0xF49D35A1UL,
+    0x5DD62EAEUL, 0xE358D63FUL, 0xE358D63FUL, 0xE358D63FUL,
+    0x4AA7C293UL, 0xBC0EFAE7UL, 0x15F1EE4BUL, 0x61D6BA8BUL,
+    0xACA86051UL, 0x2E260CE5UL, 0xE358D63FUL, 0xE358D63FUL,
+    0xE358D63FUL, 0xF4A4AA4CUL, 0x6734931CUL, 0x70C8EF6FUL,
+    0x471B2941UL, 0x7163C559UL, 0xD5203A27UL, 0xE358D63FUL,
+    0xE358D63FUL, 0xE358D63FUL, 0x56C6960AUL, 0xB55E8C5CUL,
+    0x00C0CC69UL, 0x70F20C5AUL, 0x407D2EB2UL, 0xD3D7F4D7UL,
+    0xE358D63FUL, 0xE358D63FUL, 0xE358D63FUL, 0x7CA4097AUL,
+    0xE5719FFFUL, 0x7A8D40BAUL, 0xA46622CCUL, 0xD4D17088UL,
+    0x93EF847BUL, 0xE358D63FUL, 0xE358D63FUL, 0xE358D63FUL,
+    0x9033101BUL, 0xAA65E2ADUL, 0xD90E2489UL, 0x1CB852ACUL,
+    0x0CB635E6UL, 0xF356B175UL, 0xE358D63FUL, 0xE358D63FUL,
+    0xE358D63FUL, 0xA66CD5E4UL, 0xF21CE960UL, 0xB728EABBUL
+};
+
+#ifdef PANIC_MODE
+static const uint32_t GOLDEN_FRAMES[BENCH_FRAME_CASES] = {
+    0x4C5639CAUL, 0xB6885841UL, 0x570B9353UL, 0x38FBAB54UL,
+    0xA3860A52UL, 0x6887F97EUL, 0xEFB5AF2EUL, 0x71F12038UL
+};
+#else
+static const uint32_t GOLDEN_FRAMES[BENCH_FRAME_CASES] = {
+    0x2E582706UL, 0xB66283DDUL, 0x57E148CFUL, 0x381170C8UL,
+    0xC188149EUL, 0xE6E41BB6UL, 0xEFB5AF2EUL, 0x71F12038UL
+};
+#endif
+
+/*============================================================================
+ * HELPER FUNCTIONS
+ *==========================================================================*/
+
+/**
+ * Reset buffer to the case background: every other column white
+ */
+static void draw_background(void) {
+    clearDisplay();
+    for (int16_t x = 0; x < WIDTH; x += 2) {
+        drawVLine((Point){x, 0}, HEIGHT, COLOR_WHITE);
+    }
+}
+
+/**
+ * Draw one primitive case (the timed part)
+ */
+static void draw_primitive(const BenchCase* c) {
+    int16_t x = c->position.x;
+    int16_t y = c->position.y;
+    int16_t size = c->size;
+
+    switch (c->kind) {
+    case BENCH_PIXELS:
+        for (int16_t i = 0; i < size; i++) {
+            drawPixel((Point){x + i, y + i}, c->color);
+        }
+        break;
+    case BENCH_HLINE:
+        drawHLine(c->position, 2 * size, c->color);
+        break;
+    case BENCH_VLINE:
+        drawVLine(c->position, size, c->color);
+        break;
+    case BENCH_LINE:
+        drawLine(c->position, (Point){x + 2 * size - 1, y + size - 1}, c->color);
+        break;
+    case BENCH_FILL_RECT:
+        fillRect(c->position, 2 * size, size, c->color);
+        break;
+    case BENCH_CIRCLE:
+    case BENCH_FILLED_CIRCLE: {
+        Shape circle;
+        CircleSprite sprite;
+        init_circle(&circle, &sprite, c->position, size / 2,
+                    c->kind == BENCH_FILLED_CIRCLE, c->color);
+        draw(&circle);
+        break;
+    }
+    case BENCH_SPRITE:
+        drawSprite(x, y, SPRITE_COLUMNS, (uint8_t)(size / 2), c->color);
+        break;
+    case BENCH_PAGE_BITMAP: {
+        PageBitmap bitmap = {(uint8_t)size, (uint8_t)(size / 2), BITMAP_DATA};
+        drawPageBitmap(x, y, &bitmap, c->color);
+        break;
+    }
+    case BENCH_TEXT:
+        // Text takes unsigned coordinates: negative ones land off the right edge
+        drawText((uint8_t)x, (uint8_t)y, "PANIC", c->color, (uint8_t)(size / 8));
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * Put the ball at a position and every paddle at its home position moved
+ * along its axis by offset; the next draw shows them there
+ */
+static void place_objects(GameController* game, Point ball, int16_t offset) {
+    set_physics_position(&game->balls[0], ball);
+    set_physics_position(&game->paddles[0], (Point){SCREEN_WIDTH / 2 + offset, game->h_paddle_y_top});
+    set_physics_position(&game->paddles[1], (Point){SCREEN_WIDTH / 2 + offset, game->h_paddle_y_bottom});
+    set_physics_position(&game->paddles[2], (Point){game->v_paddle_x_left, SCREEN_HEIGHT / 2 + offset});
+    set_physics_position(&game->paddles[3], (Point){game->v_paddle_x_right, SCREEN_HEIGHT / 2 + offset});
+}
+
+/**
+ * Bring the game into the state a frame case starts from (untimed)
+ */
+static void prepare_frame(GameController* game, const BenchCase* c) {
+    static const Point CENTER = {SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2};
+
+    game->physics_tick = 0;                                                  // Draw at the current positions
+    game->final_score = 12345;                                               // Widest score
+    place_objects(game, CENTER, 0);
+
+    switch (c->kind) {
+    case BENCH_FRAME_BALL:
+    case BENCH_FRAME_PADDLES:
+        // Incremental: draw the frame before the move first
+        game->state = GAME_STATE_BALL_MOVING;
+        invalidate_game_display(game);
+        draw_game_controller(game);
+        place_objects(game, (c->kind == BENCH_FRAME_BALL) ? c->position : CENTER,
+                      (c->kind == BENCH_FRAME_PADDLES) ? 6 : 0);
+        break;
+    case BENCH_FRAME_PAUSED:
+        game->state = GAME_STATE_PAUSED;
+        invalidate_game_display(game);
+        break;
+    case BENCH_FRAME_TITLE:
+        game->state = GAME_STATE_TITLE;
+        invalidate_game_display(game);
+        break;
+    case BENCH_FRAME_GAME_OVER:
+        game->state = GAME_STATE_GAME_OVER;
+        invalidate_game_display(game);
+        break;
+    default:
+        game->state = GAME_STATE_BALL_AT_REST;
+        invalidate_game_display(game);
+        break;
+    }
+}
+
+/*============================================================================
+ * BENCH OPERATIONS
+ *==========================================================================*/
+
+BenchCase bench_case(uint8_t index) {
+    BenchCase c = {BENCH_FRAME_FULL, 0, {0, 0}, COLOR_WHITE};
+
+    if (index < BENCH_PRIMITIVE_CASES) {
+        c.color = COLORS[index % BENCH_COLOR_COUNT];
+        index /= BENCH_COLOR_COUNT;
+        c.position = POSITIONS[index % BENCH_POSITION_COUNT];
+        index /= BENCH_POSITION_COUNT;
+        c.size = SIZES[index % BENCH_SIZE_COUNT];
+        c.kind = (BenchKind)(index / BENCH_SIZE_COUNT);
+        return c;
+    }
+
+    // Frames: the ball case once per position, every other kind once
+    uint8_t frame = index - BENCH_PRIMITIVE_CASES;
+    if (frame < BENCH_FRAME_BALL - BENCH_FRAME_FULL) {
+        c.kind = BENCH_FRAME_FULL;
+    } else if (frame < BENCH_FRAME_BALL - BENCH_FRAME_FULL + BENCH_POSITION_COUNT) {
+        c.kind = BENCH_FRAME_BALL;
+        c.position = POSITIONS[frame - (BENCH_FRAME_BALL - BENCH_FRAME_FULL)];
+    } else {
+        c.kind = (BenchKind)(BENCH_FRAME_FULL + frame - (BENCH_POSITION_COUNT - 1));
+    }
+    return c;
+}
+
+const char* bench_kind_name(BenchKind kind) {
+    return (kind < BENCH_KIND_COUNT) ? KIND_NAMES[kind] : "?";
+}
+
+BenchResult bench_run(GameController* game, uint8_t index, uint16_t repeats) {
+    BenchCase c = bench_case(index);
+    BenchResult result = {0, 0};
+
+    for (uint16_t run = 0; run < repeats; run++) {
+        uint16_t start;
+        if (c.kind < BENCH_PRIMITIVE_COUNT) {
+            draw_background();
+            start = hal_counter_read();
+            draw_primitive(&c);
+        } else {
+            prepare_frame(game, &c);
+            start = hal_counter_read();
+            draw_game_controller(game);
+        }
+        result.counts += (uint16_t)(hal_counter_read() - start);             // Wrap-safe, runs < 65536 ticks
+    }
+
+    result.crc = bench_buffer_crc();
+    return result;
+}
+
+uint32_t bench_golden(uint8_t index) {
+    if (index < BENCH_PRIMITIVE_CASES) return GOLDEN_PRIMITIVES[index];
+    return GOLDEN_FRAMES[index - BENCH_PRIMITIVE_CASES];
+}
+
+uint32_t bench_buffer_crc(void) {
+    const uint8_t* bytes = getDisplayBuffer();
+    uint32_t crc = 0xFFFFFFFFUL;
+    for (uint16_t i = 0; i < WIDTH * PAGES; i++) {
+        crc ^= bytes[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+/*============================================================================
+ * SERIAL REPORT
+ *==========================================================================*/
+
+/**
+ * Blocking serial writer (benchmark builds only)
+ */
+static void serial_write(char c) {
+    hal_serial_write((uint8_t)c);
+}
+
+static void serial_write_text(const char* text) {
+    while (*text) {
+        serial_write(*text++);
+    }
+}
+
+static void serial_write_number(uint32_t number) {
+    char digits[10];
+    uint8_t count = 0;
+    do {
+        digits[count++] = '0' + (number % 10);
+        number /= 10;
+    } while (number > 0);
+    while (count > 0) {
+        serial_write(digits[--count]);
+    }
+}
+
+static void serial_write_hex(uint32_t number) {
+    for (int8_t shift = 28; shift >= 0; shift -= 4) {
+        uint8_t nibble = (number >> shift) & 0x0F;
+        serial_write((nibble < 10) ? '0' + nibble : 'A' + nibble - 10);
+    }
+}
+
+uint16_t bench_report_serial(GameController* game) {
+    uint16_t failures = 0;
+    hal_serial_init(BENCH_BAUD);
+
+    for (uint16_t index = 0; index < BENCH_CASE_COUNT; index++) {
+        BenchResult result = bench_run(game, (uint8_t)index, BENCH_REPEATS);
+        uint8_t ok = (result.crc == bench_golden((uint8_t)index));
+        if (!ok) failures++;
+
+        serial_write_text("B ");
+        serial_write_number(index);
+        serial_write(' ');
+        serial_write_number(result.counts * HAL_COUNTER_DIV / BENCH_REPEATS);  // CPU cycles per run
+        serial_write(' ');
+        serial_write_hex(result.crc);
+        serial_write(' ');
+        serial_write_text(ok ? "OK\r\n" : "BAD\r\n");
+    }
+
+    serial_write_text("BX ");
+    serial_write_number(failures);
+    serial_write_text("\r\n");
+    return failures;
+}
+
+#endif // (BENCH_MODE || HAL_HOST) && !DISPLAY_STRIP
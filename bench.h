@@ -0,0 +1,160 @@
+/*============================================================================
+ * bench.h
+ *============================================================================
+ * Rendering micro-benchmark with golden-frame checksums
+ *
+ * Times every drawing primitive over a sweep of sizes, positions (inside the
+ * screen and clipped at the top-left and bottom-right edges) and colours,
+ * plus whole draw_game_controller() frames, with the HAL free-running
+ * counter the frame profiler uses. After each case the CRC-32 of buffer is
+ * compared against the golden value committed in bench.c, so a renderer
+ * change that alters a single pixel shows up next to its timing.
+ *
+ * Every repeat of a case starts from the same buffer: cleared, then every
+ * other column white (so all three colours change pixels), and only the
+ * draw call itself is timed. Frame cases set the game state directly; they
+ * never read the input controller, so results do not depend on the joystick.
+ *
+ * Case index = ((primitive * BENCH_SIZE_COUNT + size) * BENCH_POSITION_COUNT
+ *               + position) * BENCH_COLOR_COUNT + color
+ * for the primitives, followed by the BENCH_FRAME_CASES frame cases.
+ *
+ * Build flags:
+ *     BENCH_MODE - firmware runs the benchmark once at boot instead of the
+ *                  game and prints it on USART0 TX (PB2); otherwise bench.c
+ *                  is only compiled for the host (host/bench_main.c)
+ *
+ * Serial report (BENCH_MODE), one line per case and a summary:
+ *     B index cycles crc OK|BAD    (cycles per run, crc in hex)
+ *     BX failures
+ *
+ * USAGE:
+ *     BenchResult result = bench_run(&game, index, BENCH_REPEATS);
+ *     if (result.crc != bench_golden(index)) { ... }
+ *==========================================================================*/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include "hal.h"
+#include "game_controller.h"
+#include "sh1106_graphics.h"
+
+/*============================================================================
+ * BENCH CONFIGURATION
+ *==========================================================================*/
+
+#define BENCH_REPEATS        16                                     // Runs per case on the target
+#define BENCH_BAUD           115200UL                               // USART0 rate for BENCH_MODE
+#define BENCH_SIZE_SMALL     8                                      // Pixels (meaning per primitive)
+#define BENCH_SIZE_LARGE     32
+
+#define BENCH_SIZE_COUNT     2
+#define BENCH_POSITION_COUNT 3                                      // Inside, top-left, bottom-right
+#define BENCH_COLOR_COUNT    3                                      // White, black, invert
+
+/*============================================================================
+ * BENCH TYPES
+ *==========================================================================*/
+
+/**
+ * What a case draws: one primitive, or one game frame
+ */
+typedef enum {
+    BENCH_PIXELS,           // size pixels on a diagonal
+    BENCH_HLINE,            // drawHLine(), 2 * size long
+    BENCH_VLINE,            // drawVLine(), size long
+    BENCH_LINE,             // drawLine(), 2 * size by size
+    BENCH_FILL_RECT,        // fillRect(), 2 * size by size
+    BENCH_CIRCLE,           // Outline circle shape, radius size / 2
+    BENCH_FILLED_CIRCLE,    // Filled circle shape, radius size / 2
+    BENCH_SPRITE,           // drawSprite(), size / 2 columns of 16 rows
+    BENCH_PAGE_BITMAP,      // drawPageBitmap(), size by size / 2
+    BENCH_TEXT,             // drawText() "PANIC", scale size / 8
+    BENCH_PRIMITIVE_COUNT,
+
+    BENCH_FRAME_FULL = BENCH_PRIMITIVE_COUNT, // Gameplay frame from scratch
+    BENCH_FRAME_BALL,       // Ball moved (incremental), position swept
+    BENCH_FRAME_PADDLES,    // All paddles moved (incremental)
+    BENCH_FRAME_PAUSED,     // Pause menu frame from scratch
+    BENCH_FRAME_TITLE,      // Title screen streamed from flash
+    BENCH_FRAME_GAME_OVER,  // Game over screen streamed, score on top
+    BENCH_KIND_COUNT
+} BenchKind;
+
+#define BENCH_PRIMITIVE_CASES (BENCH_PRIMITIVE_COUNT * BENCH_SIZE_COUNT * \
+                               BENCH_POSITION_COUNT * BENCH_COLOR_COUNT)
+#define BENCH_FRAME_CASES     (BENCH_KIND_COUNT - BENCH_PRIMITIVE_COUNT + BENCH_POSITION_COUNT - 1)
+#define BENCH_CASE_COUNT      (BENCH_PRIMITIVE_CASES + BENCH_FRAME_CASES)
+
+/**
+ * Parameters of one case
+ */
+typedef struct {
+    BenchKind kind;
+    uint8_t size;           // BENCH_SIZE_SMALL / _LARGE (0 for frames)
+    Point position;         // Top-left (circles: centre, BENCH_FRAME_BALL: ball)
+    OLED_color color;       // Primitives only
+} BenchCase;
+
+/**
+ * Outcome of one case
+ */
+typedef struct {
+    uint32_t counts;        // Counter ticks (HAL_COUNTER_HZ) summed over all runs
+    uint32_t crc;           // CRC-32 of buffer after the last run
+} BenchResult;
+
+/*============================================================================
+ * BENCH OPERATIONS
+ *==========================================================================*/
+
+/**
+ * Get the parameters of a case
+ * @param index Case index (0 to BENCH_CASE_COUNT - 1)
+ * @return Case parameters
+ */
+BenchCase bench_case(uint8_t index);
+
+/**
+ * Get the name of a case kind
+ * @param kind Kind of the case
+ * @return Short name, e.g. "fillRect"
+ */
+const char* bench_kind_name(BenchKind kind);
+
+/**
+ * Run a case
+ * The frame cases change the game state and positions: re-initialize the
+ * game before playing it
+ * @param game Initialized game controller (frame cases)
+ * @param index Case index (0 to BENCH_CASE_COUNT - 1)
+ * @param repeats Number of timed runs (at least 1)
+ * @return Total time and the resulting buffer CRC
+ */
+BenchResult bench_run(GameController* game, uint8_t index, uint16_t repeats);
+
+/**
+ * Get the committed buffer CRC of a case
+ * @param index Case index
+ * @return Golden CRC-32
+ */
+uint32_t bench_golden(uint8_t index);
+
+/**
+ * CRC-32 (IEEE) of buffer in page order
+ * @return Checksum
+ */
+uint32_t bench_buffer_crc(void);
+
+/**
+ * Run every case and print the serial report (blocking, takes seconds)
+ * Sets up the serial port; run with the tick interrupt off so the timings
+ * are not disturbed
+ * @param game Initialized game controller
+ * @return Number of cases whose CRC differs from the golden value
+ */
+uint16_t bench_report_serial(GameController* game);
+
+#endif // BENCH_H
@@ -0,0 +1,135 @@
+/*============================================================================
+ * clock.h
+ *============================================================================
+ * Clock profile: the main clock and every rate derived from it
+ *
+ * One build flag selects the main clock. F_CPU follows from it, and so do
+ * the prescalers that depend on F_CPU, all at compile time:
+ *     SPI     - fastest SCK within the SH1106 limit (CLOCK_SPI_MAX_HZ)
+ *     ADC     - CLK_ADC kept at or below CLOCK_ADC_MAX_HZ, so conversion
+ *               times stay those of the 3.33 MHz reset clock
+ *     counter - HAL_COUNTER_HZ kept at or below CLOCK_COUNTER_MAX_HZ, so
+ *               the 16-bit counter still spans the profiler's phases and a
+ *               latency measurement
+ * The delays, timeouts and µs conversions (timer.c, power.c, profiler.c,
+ * latency.c) are built on HAL_COUNTER_HZ, so they follow as well.
+ *
+ * Profiles (CLOCK_PROFILE):
+ *     CLOCK_PROFILE_RESET  3.33 MHz  20 MHz oscillator / 6 (reset state)
+ *     CLOCK_PROFILE_10MHZ  10 MHz    20 MHz oscillator / 2, the fastest
+ *                                    clock in spec below 4.5 V (default,
+ *                                    3.3 V boards)
+ *     CLOCK_PROFILE_16MHZ  16 MHz    16 MHz oscillator, 4.5-5.5 V only
+ *     CLOCK_PROFILE_20MHZ  20 MHz    20 MHz oscillator, 4.5-5.5 V only
+ *
+ * The oscillator (16 or 20 MHz) is chosen by the OSCCFG fuse, which the
+ * firmware cannot change: program FREQSEL to match CLOCK_OSC_HZ.
+ * hal_clock_init() sets the main clock prescaler.
+ *
+ * Build flags:
+ *     CLOCK_PROFILE - one of the CLOCK_PROFILE_* values (default 10 MHz)
+ *     F_CPU         - may be given by the toolchain; must then match the
+ *                     profile
+ *==========================================================================*/
+
+#ifndef CLOCK_H
+#define CLOCK_H
+
+/*============================================================================
+ * CLOCK PROFILES
+ *==========================================================================*/
+
+#define CLOCK_PROFILE_RESET 0
+#define CLOCK_PROFILE_10MHZ 1
+#define CLOCK_PROFILE_16MHZ 2
+#define CLOCK_PROFILE_20MHZ 3
+
+#ifndef CLOCK_PROFILE
+#define CLOCK_PROFILE CLOCK_PROFILE_10MHZ
+#endif
+
+#if CLOCK_PROFILE == CLOCK_PROFILE_RESET
+#define CLOCK_OSC_HZ   20000000UL
+#define CLOCK_MAIN_DIV 6                                    // Prescaler enabled at reset
+#elif CLOCK_PROFILE == CLOCK_PROFILE_10MHZ
+#define CLOCK_OSC_HZ   20000000UL
+#define CLOCK_MAIN_DIV 2
+#elif CLOCK_PROFILE == CLOCK_PROFILE_16MHZ
+#define CLOCK_OSC_HZ   16000000UL
+#define CLOCK_MAIN_DIV 1
+#elif CLOCK_PROFILE == CLOCK_PROFILE_20MHZ
+#define CLOCK_OSC_HZ   20000000UL
+#define CLOCK_MAIN_DIV 1
+#else
+#error "unknown CLOCK_PROFILE"
+#endif
+
+#define CLOCK_CPU_HZ (CLOCK_OSC_HZ / CLOCK_MAIN_DIV)
+
+#ifndef F_CPU
+#define F_CPU CLOCK_CPU_HZ
+#endif
+
+#if F_CPU != CLOCK_CPU_HZ
+#error "F_CPU does not match CLOCK_PROFILE"
+#endif
+
+/*============================================================================
+ * PERIPHERAL LIMITS
+ *==========================================================================*/
+
+#define CLOCK_SPI_MAX_HZ     4000000UL                      // SH1106 serial clock cycle >= 250 ns
+#define CLOCK_ADC_MAX_HZ     1000000UL                      // Reset clock rate: 3.33 MHz / 4 = 833 kHz
+#define CLOCK_COUNTER_MAX_HZ 320000UL                       // 16-bit counter spans >= 200 ms
+
+/*============================================================================
+ * DERIVED PRESCALERS
+ *==========================================================================*/
+
+// SPI0: f_clk / 2, 4, 8, 16, 32, 64 or 128 (CLK2X halves every PRESC step)
+#if F_CPU / 2 <= CLOCK_SPI_MAX_HZ
+#define CLOCK_SPI_DIV 2
+#elif F_CPU / 4 <= CLOCK_SPI_MAX_HZ
+#define CLOCK_SPI_DIV 4
+#elif F_CPU / 8 <= CLOCK_SPI_MAX_HZ
+#define CLOCK_SPI_DIV 8
+#elif F_CPU / 16 <= CLOCK_SPI_MAX_HZ
+#define CLOCK_SPI_DIV 16
+#else
+#define CLOCK_SPI_DIV 32
+#endif
+
+// ADC0: CLK_PER / 2 to 64 (the even steps the PRESC field offers)
+#if F_CPU / 2 <= CLOCK_ADC_MAX_HZ
+#define CLOCK_ADC_DIV 2
+#elif F_CPU / 4 <= CLOCK_ADC_MAX_HZ
+#define CLOCK_ADC_DIV 4
+#elif F_CPU / 8 <= CLOCK_ADC_MAX_HZ
+#define CLOCK_ADC_DIV 8
+#elif F_CPU / 10 <= CLOCK_ADC_MAX_HZ
+#define CLOCK_ADC_DIV 10
+#elif F_CPU / 16 <= CLOCK_ADC_MAX_HZ
+#define CLOCK_ADC_DIV 16
+#elif F_CPU / 20 <= CLOCK_ADC_MAX_HZ
+#define CLOCK_ADC_DIV 20
+#elif F_CPU / 32 <= CLOCK_ADC_MAX_HZ
+#define CLOCK_ADC_DIV 32
+#else
+#define CLOCK_ADC_DIV 64
+#endif
+
+// TCA0 (free-running counter): CLK_PER / 1, 2, 4, 8, 16, 64, 256 or 1024
+#if F_CPU / 8 <= CLOCK_COUNTER_MAX_HZ
+#define CLOCK_COUNTER_DIV 8
+#elif F_CPU / 16 <= CLOCK_COUNTER_MAX_HZ
+#define CLOCK_COUNTER_DIV 16
+#elif F_CPU / 64 <= CLOCK_COUNTER_MAX_HZ
+#define CLOCK_COUNTER_DIV 64
+#else
+#define CLOCK_COUNTER_DIV 256
+#endif
+
+#define CLOCK_SPI_HZ (F_CPU / CLOCK_SPI_DIV)
+#define CLOCK_ADC_HZ (F_CPU / CLOCK_ADC_DIV)
+
+#endif // CLOCK_H
@@ -0,0 +1,253 @@
+/*============================================================================
+ * display_list.c
+ *============================================================================
+ * Retained display list implementation (page-strip renderer)
+ *==========================================================================*/
+
+#include "display_list.h"
+
+#ifdef DISPLAY_STRIP
+
+#include "text.h"
+#include <stddef.h>
+#include <string.h>
+
+/*============================================================================
+ * DISPLAY LIST STATE
+ *==========================================================================*/
+
+static DisplayCommand commands[DISPLAY_LIST_SIZE];
+static uint8_t command_count = 0;
+static uint8_t dropped_count = 0;
+static uint8_t replaying = 0;                                                // Draw calls draw, not record
+
+static uint16_t signatures[PAGES];                                           // Valid while signatures_valid
+static uint8_t signatures_valid = 0;
+
+// Page bit lookups (avoid variable-length shifts on AVR): bit n = page n,
+// pages from n to the last / from the first to n
+static const uint8_t PAGE_BIT[8]     = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+static const uint8_t PAGES_FROM[8]   = {0xFF, 0xFE, 0xFC, 0xF8, 0xF0, 0xE0, 0xC0, 0x80};
+static const uint8_t PAGES_TO[8]     = {0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF};
+
+/*============================================================================
+ * HELPER FUNCTIONS
+ *==========================================================================*/
+
+/**
+ * Pages covered by the rows [top, bottom), clipped to the screen
+ * @return Page bits, 0 if no row is on screen
+ */
+static uint8_t rows_to_pages(int16_t top, int16_t bottom) {
+    if (top < 0) top = 0;
+    if (bottom > HEIGHT) bottom = HEIGHT;
+    if (bottom <= top) return 0;
+    return PAGES_FROM[top >> 3] & PAGES_TO[(bottom - 1) >> 3];
+}
+
+/**
+ * Start recording a command
+ * @return Zeroed command to fill in, NULL if it must not be recorded
+ */
+static DisplayCommand* append(uint8_t kind, uint8_t pages, OLED_color color) {
+    if (pages == 0) return NULL;                                             // Entirely off screen
+    if (command_count == DISPLAY_LIST_SIZE) {
+        if (dropped_count < 255) dropped_count++;
+        return NULL;
+    }
+
+    DisplayCommand* cmd = &commands[command_count++];
+    memset(cmd, 0, sizeof(*cmd));
+    cmd->kind = kind;
+    cmd->color = (uint8_t)color;
+    cmd->pages = pages;
+    signatures_valid = 0;
+    return cmd;
+}
+
+/**
+ * Fletcher-16 of every page's commands, in list order
+ */
+static void compute_signatures(void) {
+    for (uint8_t page = 0; page < PAGES; page++) {
+        uint16_t sum1 = 0;
+        uint16_t sum2 = 0;
+        for (uint8_t i = 0; i < command_count; i++) {
+            if (!(commands[i].pages & PAGE_BIT[page])) continue;
+            const uint8_t* bytes = (const uint8_t*)&commands[i];
+            for (uint8_t b = 0; b < sizeof(DisplayCommand); b++) {
+                sum1 += bytes[b];                                            // Both sums stay below 255
+                if (sum1 >= 255) sum1 -= 255;
+                sum2 += sum1;
+                if (sum2 >= 255) sum2 -= 255;
+            }
+        }
+        signatures[page] = (sum2 << 8) | sum1;
+    }
+    signatures_valid = 1;
+}
+
+/*============================================================================
+ * DISPLAY LIST OPERATIONS
+ *==========================================================================*/
+
+void display_list_reset(void) {
+    command_count = 0;
+    dropped_count = 0;
+    signatures_valid = 0;
+}
+
+uint16_t display_list_signature(uint8_t page) {
+    if (!signatures_valid) compute_signatures();
+    return signatures[page];
+}
+
+void display_list_render(uint8_t page) {
+    uint8_t bit = PAGE_BIT[page];
+    replaying = 1;
+
+    for (uint8_t i = 0; i < command_count; i++) {
+        DisplayCommand* cmd = &commands[i];
+        if (!(cmd->pages & bit)) continue;                                   // Culled: misses this page
+        OLED_color color = (OLED_color)cmd->color;
+
+        switch (cmd->kind) {
+        case DISPLAY_CMD_SHAPE:
+            draw(&cmd->args.shape);
+            break;
+        case DISPLAY_CMD_TEXT:
+            drawText(cmd->args.text.x, cmd->args.text.y, cmd->args.text.text, color,
+                     cmd->args.text.scale);
+            break;
+        case DISPLAY_CMD_NUMBER:
+            drawNumber(cmd->args.text.x, cmd->args.text.y, cmd->args.text.number, color,
+                       cmd->args.text.scale);
+            break;
+        case DISPLAY_CMD_SCREEN:
+            streamScreen(cmd->args.screen);
+            break;
+        case DISPLAY_CMD_PAGE_BITMAP:
+            drawPageBitmap(cmd->args.blit.x, cmd->args.blit.y,
+                           (const PageBitmap*)cmd->args.blit.data, color);
+            break;
+        case DISPLAY_CMD_BITMAP:
+            drawBitmap((Point){(uint8_t)cmd->args.blit.x, (uint8_t)cmd->args.blit.y},
+                       (uint8_t*)cmd->args.blit.data, cmd->args.blit.width,
+                       cmd->args.blit.height, color);
+            break;
+        case DISPLAY_CMD_SPRITE:
+            drawSprite(cmd->args.blit.x, cmd->args.blit.y, (const uint16_t*)cmd->args.blit.data,
+                       (uint8_t)cmd->args.blit.width, color);
+            break;
+        case DISPLAY_CMD_FILL_RECT:
+            fillRect((Point){(uint8_t)cmd->args.rect.x, (uint8_t)cmd->args.rect.y},
+                     cmd->args.rect.width, cmd->args.rect.height, color);
+            break;
+        case DISPLAY_CMD_VLINE:
+            drawVLine((Point){(uint8_t)cmd->args.rect.x, (uint8_t)cmd->args.rect.y},
+                      cmd->args.rect.height, color);
+            break;
+        case DISPLAY_CMD_LINE:
+            drawLine(cmd->args.line.start, cmd->args.line.end, color);
+            break;
+        case DISPLAY_CMD_PIXEL:
+            drawPixel(cmd->args.line.start, color);
+            break;
+        default:
+            break;
+        }
+    }
+
+    replaying = 0;
+}
+
+uint8_t display_list_dropped(void) {
+    return dropped_count;
+}
+
+/*============================================================================
+ * RECORDERS
+ *==========================================================================*/
+
+uint8_t display_list_shape(const Shape* shape) {
+    if (replaying) return 0;
+
+    ShapeBounds bounds = get_shape_bounds((Shape*)shape);
+    DisplayCommand* cmd = append(DISPLAY_CMD_SHAPE, rows_to_pages(bounds.tl.y, bounds.br.y),
+                                 (OLED_color)shape->color);
+    if (cmd != NULL) {
+        memcpy(&cmd->args.shape, shape, sizeof(Shape));                      // Padding too: it is hashed
+    }
+    return 1;
+}
+
+uint8_t display_list_text(uint8_t x, uint8_t y, const char* text, uint16_t number,
+                          OLED_color color, uint8_t scale) {
+    if (replaying) return 0;
+
+    uint8_t kind = (text != NULL) ? DISPLAY_CMD_TEXT : DISPLAY_CMD_NUMBER;
+    DisplayCommand* cmd = append(kind, rows_to_pages(y, y + DIGIT_HEIGHT * scale), color);
+    if (cmd != NULL) {
+        cmd->args.text.x = x;
+        cmd->args.text.y = y;
+        cmd->args.text.scale = scale;
+        cmd->args.text.number = number;
+        cmd->args.text.text = text;
+    }
+    return 1;
+}
+
+uint8_t display_list_screen(const uint8_t* image) {
+    if (replaying) return 0;
+
+    display_list_reset();                                                    // The image covers everything
+    DisplayCommand* cmd = append(DISPLAY_CMD_SCREEN, PAGES_TO[PAGES - 1], COLOR_WHITE);
+    if (cmd != NULL) {
+        cmd->args.screen = image;
+    }
+    return 1;
+}
+
+uint8_t display_list_blit(uint8_t kind, int16_t x, int16_t y, int16_t width, int16_t height,
+                          const void* data, OLED_color color) {
+    if (replaying) return 0;
+
+    DisplayCommand* cmd = append(kind, rows_to_pages(y, y + height), color);
+    if (cmd != NULL) {
+        cmd->args.blit.x = x;
+        cmd->args.blit.y = y;
+        cmd->args.blit.width = width;
+        cmd->args.blit.height = height;
+        cmd->args.blit.data = data;
+    }
+    return 1;
+}
+
+uint8_t display_list_rect(uint8_t kind, int16_t x, int16_t y, int16_t width, int16_t height,
+                          OLED_color color) {
+    if (replaying) return 0;
+
+    DisplayCommand* cmd = append(kind, rows_to_pages(y, y + height), color);
+    if (cmd != NULL) {
+        cmd->args.rect.x = x;
+        cmd->args.rect.y = y;
+        cmd->args.rect.width = width;
+        cmd->args.rect.height = height;
+    }
+    return 1;
+}
+
+uint8_t display_list_line(uint8_t kind, Point start, Point end, OLED_color color) {
+    if (replaying) return 0;
+
+    int16_t top = (start.y < end.y) ? start.y : end.y;
+    int16_t bottom = (start.y < end.y) ? end.y : start.y;
+    DisplayCommand* cmd = append(kind, rows_to_pages(top, bottom + 1), color);
+    if (cmd != NULL) {
+        cmd->args.line.start = start;
+        cmd->args.line.end = end;
+    }
+    return 1;
+}
+
+#endif // DISPLAY_STRIP
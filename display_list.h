@@ -0,0 +1,182 @@
+/*============================================================================
+ * display_list.h
+ *============================================================================
+ * Retained display list for the page-strip renderer (DISPLAY_STRIP)
+ *
+ * In strip mode there is no 1KB frame buffer. Every drawing call (shapes,
+ * text, numbers, bitmaps, sprites, spans, lines, pixels, full-screen
+ * images) is recorded here as one fixed-size command with the set of pages
+ * its bounding box touches. refreshDisplay() then rasterizes the display one
+ * page at a time into a 128-byte strip by replaying, in order, only the
+ * commands that touch that page, and sends the strip while the next page is
+ * rasterized into a second one.
+ *
+ * Every page also gets a Fletcher-16 signature over its commands; a page
+ * whose signature matches what was sent last time is neither rasterized nor
+ * sent. Since nothing is retained between frames, the whole scene is
+ * recorded every frame (clearDisplay() empties the list).
+ *
+ * Commands keep pointers, not copies, of strings, bitmaps, sprite columns
+ * and screen images: they must stay valid (and unchanged) until the frame
+ * has been sent. Shapes are copied.
+ *
+ * Build flags:
+ *     DISPLAY_STRIP     - render through the display list (otherwise every
+ *                         DISPLAY_LIST_* macro expands to 0 and
+ *                         display_list.c is empty)
+ *     DISPLAY_LIST_SIZE - commands per frame (default below); commands past
+ *                         it are dropped and counted
+ *
+ * USAGE (inside a drawing function, before it touches any pixel):
+ *     if (DISPLAY_LIST_RECT(DISPLAY_CMD_FILL_RECT, x, y, w, h, color)) return;
+ *==========================================================================*/
+
+#ifndef DISPLAY_LIST_H
+#define DISPLAY_LIST_H
+
+#include <stdint.h>
+#include "sh1106_graphics.h"
+#include "shapes.h"
+
+/*============================================================================
+ * DISPLAY LIST CONFIGURATION
+ *==========================================================================*/
+
+#ifndef DISPLAY_LIST_SIZE
+#ifdef PROFILER_ENABLED
+#define DISPLAY_LIST_SIZE 48                                        // Overlay adds 21 commands
+#else
+#define DISPLAY_LIST_SIZE 32                                        // Panic mode scene: 25
+#endif
+#endif
+
+#define DISPLAY_SIGNATURE_NONE 0xFFFF                               // Never a Fletcher-16 value
+
+/*============================================================================
+ * DISPLAY LIST TYPES
+ *==========================================================================*/
+
+/**
+ * Recorded drawing call
+ */
+typedef enum {
+    DISPLAY_CMD_SHAPE,          // draw()
+    DISPLAY_CMD_TEXT,           // drawText()
+    DISPLAY_CMD_NUMBER,         // drawNumber()
+    DISPLAY_CMD_SCREEN,         // streamScreen()
+    DISPLAY_CMD_PAGE_BITMAP,    // drawPageBitmap()
+    DISPLAY_CMD_BITMAP,         // drawBitmap()
+    DISPLAY_CMD_SPRITE,         // drawSprite()
+    DISPLAY_CMD_FILL_RECT,      // fillRect() (and drawHLine())
+    DISPLAY_CMD_VLINE,          // drawVLine()
+    DISPLAY_CMD_LINE,           // drawLine()
+    DISPLAY_CMD_PIXEL           // drawPixel()
+} DisplayCommandKind;
+
+/**
+ * One recorded call and the arguments to replay it with
+ * Zeroed before it is filled, so its bytes (padding included) can be
+ * hashed into the page signatures
+ */
+typedef struct {
+    uint8_t kind;                                                   // DisplayCommandKind
+    uint8_t color;                                                  // OLED_color
+    uint8_t pages;                                                  // Bit n: touches page n
+    union {
+        Shape shape;                                                // SHAPE (copy)
+        struct {
+            uint8_t x, y, scale;
+            uint16_t number;                                        // NUMBER
+            const char* text;                                       // TEXT
+        } text;
+        struct {
+            int16_t x, y;
+            int16_t width, height;                                  // BITMAP, SPRITE (width)
+            const void* data;                                       // PageBitmap, rows or columns
+        } blit;
+        struct {
+            int16_t x, y;
+            int16_t width, height;                                  // VLINE: height only
+        } rect;
+        struct {
+            Point start, end;                                       // PIXEL: start only
+        } line;
+        const uint8_t* screen;                                      // SCREEN
+    } args;
+} DisplayCommand;
+
+#ifdef DISPLAY_STRIP
+// Static RAM of the list: commands, count, dropped count, signature cache
+#define DISPLAY_LIST_RAM_BYTES (DISPLAY_LIST_SIZE * sizeof(DisplayCommand) + 2 + \
+                                PAGES * sizeof(uint16_t) + 1)
+#else
+#define DISPLAY_LIST_RAM_BYTES 0
+#endif
+
+/*============================================================================
+ * DISPLAY LIST OPERATIONS
+ *==========================================================================*/
+
+#ifdef DISPLAY_STRIP
+
+/**
+ * Empty the list (start of a new frame)
+ */
+void display_list_reset(void);
+
+/**
+ * Get the signature of everything recorded for a page
+ * @param page Page index (0 to PAGES - 1)
+ * @return Fletcher-16 over the page's commands in order (never
+ *         DISPLAY_SIGNATURE_NONE)
+ */
+uint16_t display_list_signature(uint8_t page);
+
+/**
+ * Replay the commands that touch a page (draws for real while it runs)
+ * The caller has pointed the drawing primitives at the page's strip;
+ * writes to other pages are discarded by them
+ * @param page Page index (0 to PAGES - 1)
+ */
+void display_list_render(uint8_t page);
+
+/**
+ * Get the number of commands dropped since the last reset (list full)
+ * @return Dropped commands; non-zero means DISPLAY_LIST_SIZE is too small
+ */
+uint8_t display_list_dropped(void);
+
+/**
+ * Recorders behind the DISPLAY_LIST_* macros
+ * Each returns 1 if the call was recorded (or dropped, or is entirely off
+ * screen) and must not draw, 0 while the list is being replayed
+ */
+uint8_t display_list_shape(const Shape* shape);
+uint8_t display_list_text(uint8_t x, uint8_t y, const char* text, uint16_t number,
+                          OLED_color color, uint8_t scale);
+uint8_t display_list_screen(const uint8_t* image);
+uint8_t display_list_blit(uint8_t kind, int16_t x, int16_t y, int16_t width, int16_t height,
+                          const void* data, OLED_color color);
+uint8_t display_list_rect(uint8_t kind, int16_t x, int16_t y, int16_t width, int16_t height,
+                          OLED_color color);
+uint8_t display_list_line(uint8_t kind, Point start, Point end, OLED_color color);
+
+#define DISPLAY_LIST_SHAPE(shape)                   display_list_shape(shape)
+#define DISPLAY_LIST_TEXT(x, y, text, num, c, s)    display_list_text((x), (y), (text), (num), (c), (s))
+#define DISPLAY_LIST_SCREEN(image)                  display_list_screen(image)
+#define DISPLAY_LIST_BLIT(k, x, y, w, h, data, c)   display_list_blit((k), (x), (y), (w), (h), (data), (c))
+#define DISPLAY_LIST_RECT(k, x, y, w, h, c)         display_list_rect((k), (x), (y), (w), (h), (c))
+#define DISPLAY_LIST_LINE(k, start, end, c)         display_list_line((k), (start), (end), (c))
+
+#else
+
+#define DISPLAY_LIST_SHAPE(shape)                   0
+#define DISPLAY_LIST_TEXT(x, y, text, num, c, s)    0
+#define DISPLAY_LIST_SCREEN(image)                  0
+#define DISPLAY_LIST_BLIT(k, x, y, w, h, data, c)   0
+#define DISPLAY_LIST_RECT(k, x, y, w, h, c)         0
+#define DISPLAY_LIST_LINE(k, start, end, c)         0
+
+#endif // DISPLAY_STRIP
+
+#endif // DISPLAY_LIST_H
@@ -8,6 +8,9 @@
 #include "shapes.h"
 #include "sh1106_graphics.h"
 #include "text.h"
+#include "screens.h"
+#include "profiler.h"
+#include "telemetry.h"
 #include <stddef.h>
 
 /*============================================================================
@@ -23,7 +26,7 @@ void paddle_hit(PhysicsObject* self, PhysicsObject* other) {
 }
 
 void ball_hit(PhysicsObject* self, PhysicsObject* other) {
-    collision_bounce(self, other);  // Ball bounces off everything
+    collision_bounce(self, other);  // Ball bounces off everything (other balls too)
 }
 
 /*============================================================================
@@ -31,19 +34,19 @@ void ball_hit(PhysicsObject* self, PhysicsObject* other) {
  *==========================================================================*/
 
 /**
- * 8 predefined direction vectors for ball movement
- * Using speed of 2 pixels/frame for good gameplay pace
+ * 8 predefined direction vectors for ball movement (Q8.8 pixels/physics step)
+ * Using speed of ~2.2 pixels/physics step for good gameplay pace
  * Mix of diagonal and angled directions to avoid pure horizontal/vertical
  */
-static const Vector2D DIRECTIONS[8] = {
-    { 2,  1},  // ENE (≈26°)
-    { 1,  2},  // NNE (≈63°)
-    {-1,  2},  // NNW (≈117°)
-    {-2,  1},  // WNW (≈154°)
-    {-2, -1},  // WSW (≈206°)
-    {-1, -2},  // SSW (≈243°)
-    { 1, -2},  // SSE (≈297°)
-    { 2, -1},  // ESE (≈334°)
+static const FixedVector DIRECTIONS[8] = {
+    {INT_TO_FIXED( 2), INT_TO_FIXED( 1)},  // ENE (≈26°)
+    {INT_TO_FIXED( 1), INT_TO_FIXED( 2)},  // NNE (≈63°)
+    {INT_TO_FIXED(-1), INT_TO_FIXED( 2)},  // NNW (≈117°)
+    {INT_TO_FIXED(-2), INT_TO_FIXED( 1)},  // WNW (≈154°)
+    {INT_TO_FIXED(-2), INT_TO_FIXED(-1)},  // WSW (≈206°)
+    {INT_TO_FIXED(-1), INT_TO_FIXED(-2)},  // SSW (≈243°)
+    {INT_TO_FIXED( 1), INT_TO_FIXED(-2)},  // SSE (≈297°)
+    {INT_TO_FIXED( 2), INT_TO_FIXED(-1)},  // ESE (≈334°)
 };
 
 /**
@@ -52,11 +55,81 @@ static const Vector2D DIRECTIONS[8] = {
  * @param seed Random seed (typically ADC value at button press)
  * @return Random velocity vector from predefined set
  */
-static Vector2D generate_random_direction(uint16_t seed) {
+static FixedVector generate_random_direction(uint16_t seed) {
     uint8_t index = seed & 0x07;  // Mask to get 0-7 range
     return DIRECTIONS[index];
 }
 
+#define BALL_DIRECTION_STRIDE 3   // Odd: balls 0-7 of one seed all get different directions
+
+#ifdef PANIC_MODE
+_Static_assert(PANIC_BALL_COUNT >= 2 && PANIC_BALL_COUNT <= 8, "PANIC_BALL_COUNT must be 2-8");
+_Static_assert(PANIC_OBSTACLE_COUNT >= 1 && PANIC_OBSTACLE_COUNT <= 4, "PANIC_OBSTACLE_COUNT must be 1-4");
+
+// Ball start positions: 4x2 block around the centre, 8 pixels apart so
+// resting balls never touch
+static const Point BALL_SPAWNS[8] = {
+    {SCREEN_WIDTH/2 - 12, SCREEN_HEIGHT/2 - 4}, {SCREEN_WIDTH/2 - 4, SCREEN_HEIGHT/2 - 4},
+    {SCREEN_WIDTH/2 + 4,  SCREEN_HEIGHT/2 - 4}, {SCREEN_WIDTH/2 + 12, SCREEN_HEIGHT/2 - 4},
+    {SCREEN_WIDTH/2 - 12, SCREEN_HEIGHT/2 + 4}, {SCREEN_WIDTH/2 - 4, SCREEN_HEIGHT/2 + 4},
+    {SCREEN_WIDTH/2 + 4,  SCREEN_HEIGHT/2 + 4}, {SCREEN_WIDTH/2 + 12, SCREEN_HEIGHT/2 + 4},
+};
+
+// Obstacle centres, one per quadrant between the balls and the paddles
+static const Point OBSTACLE_POSITIONS[4] = {
+    {SCREEN_WIDTH/4, SCREEN_HEIGHT/2 - 12}, {3 * SCREEN_WIDTH/4, SCREEN_HEIGHT/2 - 12},
+    {SCREEN_WIDTH/4, SCREEN_HEIGHT/2 + 12}, {3 * SCREEN_WIDTH/4, SCREEN_HEIGHT/2 + 12},
+};
+#else
+static const Point BALL_SPAWNS[1] = {{SCREEN_WIDTH/2, SCREEN_HEIGHT/2}};
+#endif
+
+_Static_assert(8 + GAME_OBSTACLE_COUNT + GAME_BALL_COUNT <= PHYSICS_WORLD_MAX_OBJECTS,
+               "PHYSICS_WORLD_MAX_OBJECTS too small for the game objects");
+
+#ifdef TELEMETRY_ENABLED
+/**
+ * Check whether an object is one of the balls
+ */
+static uint8_t is_ball(GameController* ctrl, PhysicsObject* obj) {
+    return obj >= ctrl->balls && obj < ctrl->balls + GAME_BALL_COUNT;
+}
+
+/**
+ * Queue the telemetry record of a contact involving a ball
+ * (normal toward the ball, ball state after the bounce)
+ */
+static void record_contact(GameController* ctrl, const PhysicsContact* contact) {
+    PhysicsObject* ball = contact->a;
+    PhysicsObject* other = contact->b;
+    Contact hit = contact->contact;
+    if (!is_ball(ctrl, ball)) {
+        ball = contact->b;
+        other = contact->a;
+        hit.normal.x = -hit.normal.x;
+        hit.normal.y = -hit.normal.y;
+    }
+
+    uint8_t target = TELEMETRY_TARGET_WALL;
+    uint8_t index = 0;
+    if (other >= ctrl->paddles && other < ctrl->paddles + 4) {
+        target = TELEMETRY_TARGET_PADDLE;
+        index = (uint8_t)(other - ctrl->paddles);
+    } else if (is_ball(ctrl, other)) {
+        target = TELEMETRY_TARGET_BALL;
+        index = (uint8_t)(other - ctrl->balls);
+#ifdef PANIC_MODE
+    } else if (other >= ctrl->obstacles && other < ctrl->obstacles + GAME_OBSTACLE_COUNT) {
+        target = TELEMETRY_TARGET_OBSTACLE;
+        index = (uint8_t)(other - ctrl->obstacles);
+#endif
+    } else if (other >= ctrl->walls && other < ctrl->walls + 4) {
+        index = (uint8_t)(other - ctrl->walls);
+    }
+    TELEMETRY_COLLISION((uint8_t)(ball - ctrl->balls), target, index, &hit, ball);
+}
+#endif
+
 /**
  * Normalize raw 12-bit ADC value to int16_t (-2048 to +2047)
  * Applies deadzone
@@ -76,40 +149,112 @@ static int16_t normalize_adc(uint16_t raw_value) {
     return delta;
 }
 
+#ifdef ATTRACT_MODE
+/**
+ * Paddle velocity toward a target coordinate, boost speed at most
+ */
+static int8_t steer_paddle(uint16_t position, uint8_t target) {
+    const int16_t LIMIT = MAX_PADDLE_SPEED * PADDLE_SPEED_BOOST_MULTIPLIER;
+
+    int16_t distance = (int16_t)target - (int16_t)(position >> FIXED_SHIFT);
+    if (distance > LIMIT) distance = LIMIT;
+    if (distance < -LIMIT) distance = -LIMIT;
+    return (int8_t)distance;
+}
+
+/**
+ * Autoplay: steer each pair of paddles to where the first ball reaching
+ * their lines will arrive (centre when no ball is on its way)
+ */
+static void autoplay_paddles(GameController* ctrl, int8_t* velocity_x, int8_t* velocity_y) {
+    // Ball centre lines at contact with the paddle faces
+    const AttractField field = {
+        (uint16_t)((ctrl->v_paddle_x_left + PADDLE_WIDTH/2 + BALL_RADIUS) << FIXED_SHIFT),
+        (uint16_t)((ctrl->v_paddle_x_right - PADDLE_WIDTH/2 - BALL_RADIUS) << FIXED_SHIFT),
+        (uint16_t)((ctrl->h_paddle_y_top + PADDLE_WIDTH/2 + BALL_RADIUS) << FIXED_SHIFT),
+        (uint16_t)((ctrl->h_paddle_y_bottom - PADDLE_WIDTH/2 - BALL_RADIUS) << FIXED_SHIFT)
+    };
+
+    uint8_t target_x = SCREEN_WIDTH/2;
+    uint8_t target_y = SCREEN_HEIGHT/2;
+    uint8_t first_horizontal = ATTRACT_NO_HIT;
+    uint8_t first_vertical = ATTRACT_NO_HIT;
+    for (int i = 0; i < GAME_BALL_COUNT; i++) {
+        AttractPrediction next = attract_predict(ctrl->balls[i].position, ctrl->balls[i].velocity, &field);
+        if (next.horizontal_steps < first_horizontal) {
+            first_horizontal = next.horizontal_steps;
+            target_x = next.horizontal_x;
+        }
+        if (next.vertical_steps < first_vertical) {
+            first_vertical = next.vertical_steps;
+            target_y = next.vertical_y;
+        }
+    }
+
+    *velocity_x = steer_paddle(ctrl->paddles[0].position.x, target_x);       // Top and bottom move together
+    *velocity_y = steer_paddle(ctrl->paddles[2].position.y, target_y);       // Left and right move together
+}
+#endif
+
+/*
+ * Velocity curve thresholds, computed by the compiler from the breakpoints
+ * in game_controller.h
+ *
+ * The curve is piecewise linear through (0, 0), (DEFLECTION_LOW, SPEED_LOW),
+ * (DEFLECTION_MID, SPEED_MID) and (2048, SPEED_HIGH), truncated to whole
+ * pixels. VELOCITY_THRESHOLD(v) is the smallest deflection that reaches v,
+ * so a deflection maps to the number of thresholds it passes - the same
+ * result as evaluating the curve, without the divisions.
+ */
+#define VELOCITY_TABLE_SIZE  16                          // Highest MAX_PADDLE_SPEED supported
+#define VELOCITY_UNREACHABLE 0xFFFF
+#define CEIL_DIV(a, b)       (((a) + (b) - 1) / (b))
+#define SPAN_OR_ONE(a)       ((a) > 0 ? (a) : 1)         // Keeps unused branches free of x / 0
+
+#define VELOCITY_THRESHOLD(v) \
+    ((v) > MAX_PADDLE_SPEED ? VELOCITY_UNREACHABLE : \
+     (v) <= PADDLE_SPEED_LOW ? \
+        CEIL_DIV((v) * PADDLE_DEFLECTION_LOW, SPAN_OR_ONE(PADDLE_SPEED_LOW)) : \
+     (v) <= PADDLE_SPEED_MID ? \
+        PADDLE_DEFLECTION_LOW + CEIL_DIV(((v) - PADDLE_SPEED_LOW) * (PADDLE_DEFLECTION_MID - PADDLE_DEFLECTION_LOW), \
+                                         SPAN_OR_ONE(PADDLE_SPEED_MID - PADDLE_SPEED_LOW)) : \
+     (v) <= PADDLE_SPEED_HIGH ? \
+        PADDLE_DEFLECTION_MID + CEIL_DIV(((v) - PADDLE_SPEED_MID) * (2048 - PADDLE_DEFLECTION_MID), \
+                                         SPAN_OR_ONE(PADDLE_SPEED_HIGH - PADDLE_SPEED_MID)) : \
+     VELOCITY_UNREACHABLE)
+
+_Static_assert(MAX_PADDLE_SPEED <= VELOCITY_TABLE_SIZE, "MAX_PADDLE_SPEED exceeds VELOCITY_TABLE_SIZE");
+_Static_assert(0 < PADDLE_DEFLECTION_LOW && PADDLE_DEFLECTION_LOW < PADDLE_DEFLECTION_MID &&
+               PADDLE_DEFLECTION_MID < 2048, "PADDLE_DEFLECTION_* must increase within 0-2048");
+_Static_assert(PADDLE_SPEED_LOW <= PADDLE_SPEED_MID && PADDLE_SPEED_MID <= PADDLE_SPEED_HIGH,
+               "PADDLE_SPEED_* must not decrease");
+
+// Entry v - 1 holds the threshold of v pixels per physics step
+static const uint16_t VELOCITY_THRESHOLDS[VELOCITY_TABLE_SIZE] = {
+    VELOCITY_THRESHOLD(1),  VELOCITY_THRESHOLD(2),  VELOCITY_THRESHOLD(3),  VELOCITY_THRESHOLD(4),
+    VELOCITY_THRESHOLD(5),  VELOCITY_THRESHOLD(6),  VELOCITY_THRESHOLD(7),  VELOCITY_THRESHOLD(8),
+    VELOCITY_THRESHOLD(9),  VELOCITY_THRESHOLD(10), VELOCITY_THRESHOLD(11), VELOCITY_THRESHOLD(12),
+    VELOCITY_THRESHOLD(13), VELOCITY_THRESHOLD(14), VELOCITY_THRESHOLD(15), VELOCITY_THRESHOLD(16),
+};
+
 /**
  * Map normalized joystick value to paddle velocity with custom curve
- * Piecewise linear mapping using configurable breakpoints
+ * Piecewise linear mapping using configurable breakpoints (looked up in
+ * VELOCITY_THRESHOLDS)
  * @param normalized_value Normalized joystick (-2048 to +2047, 0 at center)
- * @return Velocity (±MAX_PADDLE_SPEED pixels per frame)
+ * @return Velocity (±MAX_PADDLE_SPEED pixels per physics step)
  */
 static int8_t map_to_velocity(int16_t normalized_value) {
-    // Preserve sign
-    int8_t sign = (normalized_value < 0) ? -1 : 1;
-    int16_t abs_value = (normalized_value < 0) ? -normalized_value : normalized_value;
-
-    int32_t velocity;
-
-    // Piecewise linear mapping with configurable breakpoints
-    if (abs_value < PADDLE_DEFLECTION_LOW) {
-        // 0% to 25%: maps to 0 to PADDLE_SPEED_LOW
-        velocity = (abs_value * PADDLE_SPEED_LOW) / PADDLE_DEFLECTION_LOW;
-    } else if (abs_value < PADDLE_DEFLECTION_MID) {
-        // 25% to 75%: maps to PADDLE_SPEED_LOW to PADDLE_SPEED_MID
-        velocity = PADDLE_SPEED_LOW +
-                   ((abs_value - PADDLE_DEFLECTION_LOW) * (PADDLE_SPEED_MID - PADDLE_SPEED_LOW)) /
-                   (PADDLE_DEFLECTION_MID - PADDLE_DEFLECTION_LOW);
-    } else {
-        // 75% to 100%: maps to PADDLE_SPEED_MID to PADDLE_SPEED_HIGH
-        velocity = PADDLE_SPEED_MID +
-                   ((abs_value - PADDLE_DEFLECTION_MID) * (PADDLE_SPEED_HIGH - PADDLE_SPEED_MID)) /
-                   (2048 - PADDLE_DEFLECTION_MID);
-    }
+    uint16_t abs_value = (normalized_value < 0) ? -normalized_value : normalized_value;
 
-    // Clamp to max speed (safety)
-    if (velocity > MAX_PADDLE_SPEED) velocity = MAX_PADDLE_SPEED;
+    // Thresholds increase: count the ones reached (at most MAX_PADDLE_SPEED)
+    int8_t velocity = 0;
+    while (velocity < MAX_PADDLE_SPEED && abs_value >= VELOCITY_THRESHOLDS[velocity]) {
+        velocity++;
+    }
 
     // Restore sign
-    return (int8_t)(velocity * sign);
+    return (normalized_value < 0) ? -velocity : velocity;
 }
 
 /**
@@ -139,19 +284,13 @@ static int8_t smooth_accelerate(int8_t current, int8_t target) {
  * @param is_horizontal True for X clamping (horizontal paddles), False for Y clamping (vertical paddles)
  */
 static void clamp_paddle(PhysicsObject* paddle, uint8_t min_coord, uint8_t max_coord, uint8_t is_horizontal) {
-    Point pos = get_physics_position(paddle);
-
     if (is_horizontal) {
         // Clamp X coordinate
-        if (pos.x < min_coord) pos.x = min_coord;
-        if (pos.x > max_coord) pos.x = max_coord;
+        clamp_physics_position(paddle, (Point){min_coord, 0}, (Point){max_coord, 255});
     } else {
         // Clamp Y coordinate
-        if (pos.y < min_coord) pos.y = min_coord;
-        if (pos.y > max_coord) pos.y = max_coord;
+        clamp_physics_position(paddle, (Point){0, min_coord}, (Point){255, max_coord});
     }
-
-    set_physics_position(paddle, pos);
 }
 
 /*============================================================================
@@ -200,6 +339,11 @@ void init_game_controller(GameController* controller) {
                  (ShapeParams){.rect = {WALL_THICKNESS, SCREEN_HEIGHT, ANCHOR_TOP_LEFT, 1, COLOR_WHITE}},
                  wall_hit);
 
+    // Walls never move: drawn once per state change
+    for (int i = 0; i < 4; i++) {
+        set_physics_static(&controller->walls[i], 1);
+    }
+
     // Create paddles (all start centered)
     init_physics(&controller->paddles[0], (Point){SCREEN_WIDTH/2, controller->h_paddle_y_top}, (Vector2D){0, 0},
                  SHAPE_RECTANGLE,
@@ -228,19 +372,69 @@ void init_game_controller(GameController* controller) {
     for (int i = 0; i < 4; i++) {
         controller->paddle_collision_cooldown[i] = 0;
     }
+    controller->physics_tick = 0;
     controller->paddle_current_velocity_x = 0;
     controller->paddle_current_velocity_y = 0;
-    controller->paused_ball_velocity = (Vector2D){0, 0};
+    for (int i = 0; i < GAME_BALL_COUNT; i++) {
+        controller->paused_ball_velocity[i] = (FixedVector){0, 0};
+    }
     controller->countdown_timer = 0;
-    controller->button1_prev_state = 0;
+#ifdef ATTRACT_MODE
+    init_attract(&controller->attract);
+#endif
+    controller->render_valid = 0;
+    controller->render_state = GAME_STATE_TITLE;
+    controller->drawn_countdown = 0;
+
+    // Pause menu shapes live in the controller (no allocation while paused)
+    init_rectangle(&controller->pause_bg,
+                   (Point){SCREEN_WIDTH/2, SCREEN_HEIGHT/2}, 60, 30,
+                   ANCHOR_CENTER, 1, COLOR_BLACK);                           // Filled
+    init_rectangle(&controller->pause_border,
+                   (Point){SCREEN_WIDTH/2, SCREEN_HEIGHT/2}, 60, 30,
+                   ANCHOR_CENTER, 0, COLOR_WHITE);                           // Outline only
 
     // Create ball (starts at rest in center)
-    init_physics(&controller->ball,
-                 (Point){SCREEN_WIDTH/2, SCREEN_HEIGHT/2},
+    init_physics(&controller->balls[0],
+                 BALL_SPAWNS[0],
                  (Vector2D){0, 0},  // At rest initially
                  SHAPE_CIRCLE,
                  (ShapeParams){.circle = {BALL_RADIUS, 1, COLOR_WHITE}},
                  ball_hit);
+
+#ifdef PANIC_MODE
+    // Spare balls are copies of ball 0 (they draw its sprite)
+    for (int i = 1; i < GAME_BALL_COUNT; i++) {
+        init_physics_shape(&controller->balls[i], BALL_SPAWNS[i], (Vector2D){0, 0},
+                           &controller->balls[0].visual, ball_hit);
+    }
+
+    // Obstacles never move: drawn with the walls
+    for (int i = 0; i < GAME_OBSTACLE_COUNT; i++) {
+        init_physics(&controller->obstacles[i], OBSTACLE_POSITIONS[i], (Vector2D){0, 0},
+                     SHAPE_RECTANGLE,
+                     (ShapeParams){.rect = {OBSTACLE_WIDTH, OBSTACLE_HEIGHT, ANCHOR_CENTER, 1, COLOR_WHITE}},
+                     wall_hit);
+        set_physics_static(&controller->obstacles[i], 1);
+    }
+#endif
+
+    // Everything collides through the world (in render item order)
+    init_physics_world(&controller->world);
+    for (int i = 0; i < 4; i++) {
+        physics_world_add(&controller->world, &controller->walls[i]);
+    }
+#ifdef PANIC_MODE
+    for (int i = 0; i < GAME_OBSTACLE_COUNT; i++) {
+        physics_world_add(&controller->world, &controller->obstacles[i]);
+    }
+#endif
+    for (int i = 0; i < 4; i++) {
+        physics_world_add(&controller->world, &controller->paddles[i]);
+    }
+    for (int i = 0; i < GAME_BALL_COUNT; i++) {
+        physics_world_add(&controller->world, &controller->balls[i]);
+    }
 }
 
 void destroy_game_controller(GameController* ctrl) {
@@ -255,22 +449,61 @@ void destroy_game_controller(GameController* ctrl) {
         destroy(&ctrl->paddles[i]);
     }
 
-    // Destroy ball
-    destroy(&ctrl->ball);
+    // Destroy balls (only ball 0 holds a pool shape)
+    for (int i = 0; i < GAME_BALL_COUNT; i++) {
+        destroy(&ctrl->balls[i]);
+    }
 }
 
 /*============================================================================
  * GAME CONTROLLER UPDATE
  *==========================================================================*/
 
+uint8_t game_controller_idle(GameController* ctrl) {
+    if (ctrl == NULL) return 0;
+
+    // Static screens only change on a button 1 press
+    switch (ctrl->state) {
+        case GAME_STATE_TITLE:
+        case GAME_STATE_PAUSED:
+        case GAME_STATE_GAME_OVER:
+            return !input_controller_button1_clicked(&ctrl->input_ctrl);
+        default:
+            return 0;
+    }
+}
+
 void update_game_controller(GameController* ctrl) {
     if (ctrl == NULL) return;
 
     // Update input controller (polls hardware)
+    PROFILE_BEGIN(PROFILE_INPUT);
     update_input_controller(&ctrl->input_ctrl);
+    PROFILE_END(PROFILE_INPUT);
+
+    // Movement and collisions advance every PHYSICS_STEP_TICKS ticks;
+    // buttons, state machine and timers run every tick
+    uint8_t physics_step = 0;
+    uint8_t physics_timed = 0;                                               // PROFILE_PHYSICS sample open
+    if (++ctrl->physics_tick >= PHYSICS_STEP_TICKS) {
+        ctrl->physics_tick = 0;
+        physics_step = 1;
+
+        // Objects that do not move this step are drawn where they are
+        for (int i = 0; i < GAME_BALL_COUNT; i++) {
+            settle_physics(&ctrl->balls[i]);
+        }
+        for (int i = 0; i < 4; i++) {
+            settle_physics(&ctrl->paddles[i]);
+        }
+    }
 
     // Only update paddles during gameplay states (not during pause/title/game over)
-    if (ctrl->state == GAME_STATE_BALL_AT_REST || ctrl->state == GAME_STATE_BALL_MOVING) {
+    if (physics_step &&
+        (ctrl->state == GAME_STATE_BALL_AT_REST || ctrl->state == GAME_STATE_BALL_MOVING)) {
+        PROFILE_BEGIN(PROFILE_PHYSICS);                                      // Whole step: ends after the balls move
+        physics_timed = 1;
+
         // Get raw ADC values
         uint16_t raw_x = input_controller_joystick_x(&ctrl->input_ctrl);  // 0-4095
         uint16_t raw_y = input_controller_joystick_y(&ctrl->input_ctrl);  // 0-4095
@@ -280,8 +513,8 @@ void update_game_controller(GameController* ctrl) {
         int16_t norm_y = -normalize_adc(raw_y);  // Inverted: -2048 to +2047
 
         // Map to target velocities
-        int8_t target_velocity_x = map_to_velocity(norm_x);  // ±MAX_PADDLE_SPEED pixels/frame
-        int8_t target_velocity_y = map_to_velocity(norm_y);  // ±MAX_PADDLE_SPEED pixels/frame
+        int8_t target_velocity_x = map_to_velocity(norm_x);  // ±MAX_PADDLE_SPEED pixels/step
+        int8_t target_velocity_y = map_to_velocity(norm_y);  // ±MAX_PADDLE_SPEED pixels/step
 
         // Apply speed boost if joystick button pressed
         uint8_t button2_pressed = input_controller_button2_pressed(&ctrl->input_ctrl);
@@ -296,6 +529,18 @@ void update_game_controller(GameController* ctrl) {
             if (target_velocity_y < -127) target_velocity_y = -127;
         }
 
+#ifdef ATTRACT_MODE
+        // Demo game: the predictor steers instead of the joystick (the
+        // paddles stop once it lets go)
+        if (ATTRACT_ACTIVE(ctrl)) {
+            target_velocity_x = 0;
+            target_velocity_y = 0;
+            if (attract_steering(&ctrl->attract)) {
+                autoplay_paddles(ctrl, &target_velocity_x, &target_velocity_y);
+            }
+        }
+#endif
+
         // Smoothly accelerate current velocity toward target velocity
         ctrl->paddle_current_velocity_x = smooth_accelerate(ctrl->paddle_current_velocity_x, target_velocity_x);
         ctrl->paddle_current_velocity_y = smooth_accelerate(ctrl->paddle_current_velocity_y, target_velocity_y);
@@ -319,9 +564,38 @@ void update_game_controller(GameController* ctrl) {
         clamp_paddle(&ctrl->paddles[3], ctrl->v_paddle_min_y, ctrl->v_paddle_max_y, 0);  // Vertical
     }
 
-    // Button edge detection
-    uint8_t button1_current = input_controller_button1_pressed(&ctrl->input_ctrl);
-    uint8_t button1_pressed = button1_current && !ctrl->button1_prev_state;
+    // Press of button 1 since the last tick (queued by the input controller)
+    uint8_t button1_pressed = input_controller_button1_clicked(&ctrl->input_ctrl);
+
+#ifdef PROFILER_ENABLED
+    // Button 1 while holding button 2 toggles the profiler overlay
+    if (button1_pressed && input_controller_button2_pressed(&ctrl->input_ctrl)) {
+        profiler_toggle_overlay();
+        button1_pressed = 0;
+    }
+#endif
+
+#ifdef ATTRACT_MODE
+    // Attract mode: presses button 1 for the demo; a real press ends it
+    switch (attract_update(&ctrl->attract, ctrl->state, button1_pressed)) {
+        case ATTRACT_PRESS:
+            button1_pressed = 1;
+            break;
+        case ATTRACT_EXIT:
+            ctrl->state = GAME_STATE_TITLE;
+            button1_pressed = 0;
+            break;
+        default:
+            break;
+    }
+#endif
+
+    // One PROFILE_PHYSICS sample per step: it closes here, after the
+    // transition has been decided (attract mode may have left for the
+    // title), unless the balls move this tick; then it closes once they have
+    if (physics_timed && !(ctrl->state == GAME_STATE_BALL_MOVING && !button1_pressed)) {
+        PROFILE_END(PROFILE_PHYSICS);
+    }
 
     // State machine
     switch (ctrl->state) {
@@ -330,8 +604,10 @@ void update_game_controller(GameController* ctrl) {
             if (button1_pressed) {
                 // Reset game state
                 ctrl->score = 0;
-                set_physics_position(&ctrl->ball, (Point){SCREEN_WIDTH/2, SCREEN_HEIGHT/2});
-                set_physics_velocity(&ctrl->ball, (Vector2D){0, 0});
+                for (int i = 0; i < GAME_BALL_COUNT; i++) {
+                    set_physics_position(&ctrl->balls[i], BALL_SPAWNS[i]);
+                    set_physics_velocity(&ctrl->balls[i], (Vector2D){0, 0});
+                }
                 for (int i = 0; i < 4; i++) {
                     ctrl->paddle_collision_cooldown[i] = 0;
                 }
@@ -341,59 +617,95 @@ void update_game_controller(GameController* ctrl) {
 
         case GAME_STATE_BALL_AT_REST:
             if (button1_pressed) {
-                // Generate random direction using ADC as seed
-                uint16_t seed = input_controller_joystick_x(&ctrl->input_ctrl);
-                Vector2D velocity = generate_random_direction(seed);
-                set_physics_velocity(&ctrl->ball, velocity);
+                // Generate random directions (ADC noise, or the recorded seed)
+                uint16_t seed = input_controller_random_seed(&ctrl->input_ctrl);
+#ifdef ATTRACT_MODE
+                if (ATTRACT_ACTIVE(ctrl)) {
+                    seed = attract_launch_seed(&ctrl->attract);              // Same games every demo session
+                }
+#endif
+                for (int i = 0; i < GAME_BALL_COUNT; i++) {
+                    FixedVector velocity = generate_random_direction(seed + i * BALL_DIRECTION_STRIDE);
+#ifdef ATTRACT_SOAK
+                    if (ATTRACT_ACTIVE(ctrl)) {
+                        velocity.x *= ATTRACT_SOAK_SPEED;
+                        velocity.y *= ATTRACT_SOAK_SPEED;
+                    }
+#endif
+                    set_physics_velocity_fx(&ctrl->balls[i], velocity);
+                }
                 ctrl->state = GAME_STATE_BALL_MOVING;
             }
             break;
 
         case GAME_STATE_BALL_MOVING:
             if (button1_pressed) {
-                // Pause game - save ball velocity and stop movement
-                ctrl->paused_ball_velocity = get_physics_velocity(&ctrl->ball);
-                set_physics_velocity(&ctrl->ball, (Vector2D){0, 0});
+                // Pause game - save ball velocities and stop movement
+                for (int i = 0; i < GAME_BALL_COUNT; i++) {
+                    ctrl->paused_ball_velocity[i] = get_physics_velocity_fx(&ctrl->balls[i]);
+                    set_physics_velocity(&ctrl->balls[i], (Vector2D){0, 0});
+                }
                 ctrl->state = GAME_STATE_PAUSED;
-            } else {
+            } else if (physics_step) {
                 // Update ball physics (applies velocity to position)
-                update(&ctrl->ball);
-
-                // Check collisions with paddles first - increment score
-                // Check per-paddle cooldown (prevents paddle trapping)
-                for (int i = 0; i < 4; i++) {
-                    if (ctrl->paddle_collision_cooldown[i] == 0) {
-                        if (check_collision(&ctrl->ball, &ctrl->paddles[i])) {
-                            ctrl->score++;
-                            ctrl->paddle_collision_cooldown[i] = PADDLE_COLLISION_COOLDOWN_FRAMES;
-                            // Don't break - ball can hit multiple paddles in corners
-                        }
+                for (int i = 0; i < GAME_BALL_COUNT; i++) {
+                    update(&ctrl->balls[i]);
+                }
+                PROFILE_END(PROFILE_PHYSICS);
+
+                // Find all contacts of this step (bounces run as callbacks)
+                PROFILE_BEGIN(PROFILE_COLLISION);
+                physics_world_step(&ctrl->world);
+#ifdef TELEMETRY_ENABLED
+                for (uint8_t c = 0; c < ctrl->world.contact_count; c++) {
+                    record_contact(ctrl, &ctrl->world.contacts[c]);              // Every contact has a ball
+                }
+#endif
+
+                // Paddles and walls only ever touch balls: a touched paddle
+                // scores, a touched wall ends the game (ball-ball and obstacle
+                // contacts only bounce). Read from the touched mask, which
+                // unlike the contact list never runs out of room
+                for (uint8_t paddle = 0; paddle < 4; paddle++) {
+                    if (!physics_world_touched(&ctrl->world, &ctrl->paddles[paddle])) continue;
+
+                    // Per-paddle cooldown (prevents scoring a trapped ball repeatedly)
+                    if (ctrl->paddle_collision_cooldown[paddle] == 0) {
+                        ctrl->score++;
+                        ctrl->paddle_collision_cooldown[paddle] = PADDLE_COLLISION_COOLDOWN_TICKS;
+                        // Don't stop - ball can hit multiple paddles in corners
                     }
                 }
+                uint8_t hit_wall = 0;
+                for (uint8_t wall = 0; wall < 4; wall++) {
+                    hit_wall |= physics_world_touched(&ctrl->world, &ctrl->walls[wall]);
+                }
 
-                // Check collisions with walls - game over
-                for (int i = 0; i < 4; i++) {
-                    if (check_collision(&ctrl->ball, &ctrl->walls[i])) {
-                        // Game over - flash screen
+                if (hit_wall) {
+                    // Game over - flash screen (not in demo games: the
+                    // blocking flash would be the soak's worst frame)
+                    if (!ATTRACT_ACTIVE(ctrl)) {
                         invertDisplay(1);
-                        for (volatile uint32_t delay = 0; delay < 50000; delay++) {}
+                        delay_ms(GAME_OVER_FLASH_MS);
                         invertDisplay(0);
+                    }
 
-                        // Save final score and stop ball
-                        ctrl->final_score = ctrl->score;
-                        set_physics_velocity(&ctrl->ball, (Vector2D){0, 0});
-                        ctrl->state = GAME_STATE_GAME_OVER;
-                        break;
+                    // Save final score and stop balls
+                    ctrl->final_score = ctrl->score;
+                    for (int i = 0; i < GAME_BALL_COUNT; i++) {
+                        set_physics_velocity(&ctrl->balls[i], (Vector2D){0, 0});
                     }
+                    ctrl->state = GAME_STATE_GAME_OVER;
                 }
+                PROFILE_END(PROFILE_COLLISION);
             }
             break;
 
         case GAME_STATE_PAUSED:
             // Game is paused - wait for button press to resume
             if (button1_pressed) {
-                // Start countdown (3 seconds at ~12 fps = 36 frames)
-                ctrl->countdown_timer = 36;
+                // Start countdown (3 seconds)
+                ctrl->countdown_timer = COUNTDOWN_TICKS;
                 ctrl->state = GAME_STATE_COUNTDOWN;
             }
             break;
@@ -404,9 +716,11 @@ void update_game_controller(GameController* ctrl) {
                 ctrl->countdown_timer--;
             }
 
-            // When countdown reaches 0, restore ball velocity and resume
+            // When countdown reaches 0, restore ball velocities and resume
             if (ctrl->countdown_timer == 0) {
-                set_physics_velocity(&ctrl->ball, ctrl->paused_ball_velocity);
+                for (int i = 0; i < GAME_BALL_COUNT; i++) {
+                    set_physics_velocity_fx(&ctrl->balls[i], ctrl->paused_ball_velocity[i]);
+                }
                 ctrl->state = GAME_STATE_BALL_MOVING;
             }
             break;
@@ -419,117 +733,259 @@ void update_game_controller(GameController* ctrl) {
             break;
     }
 
-    // Update button previous state
-    ctrl->button1_prev_state = button1_current;
-
     // Decrement collision cooldowns for all paddles
     for (int i = 0; i < 4; i++) {
         if (ctrl->paddle_collision_cooldown[i] > 0) {
             ctrl->paddle_collision_cooldown[i]--;
         }
     }
+
+    // Telemetry stream: state at the end of the tick
+    TELEMETRY_STATE(ctrl);
 }
 
 /*============================================================================
  * GAME CONTROLLER DRAWING
  *==========================================================================*/
 
-void draw_game_controller(GameController* ctrl) {
-    if (ctrl == NULL) return;
+/*============================================================================
+ * RETAINED RENDERING
+ *==========================================================================*/
+// buffer keeps the last frame. A state change clears it and draws the whole
+// scene once; afterwards only moving items are erased at the bounds they were
+// drawn at, and anything overlapping the erased areas is drawn again. Clean
+// blocks stay clean, so the refresh only carries the moved areas.
+
+// One bit per render item
+#if RENDER_ITEM_COUNT > 16
+typedef uint32_t RenderMask;
+#else
+typedef uint16_t RenderMask;
+#endif
+
+// Large countdown digit (scale 6 = 18x30 pixels), centered
+#define COUNTDOWN_SCALE 6
+#define COUNTDOWN_X     (SCREEN_WIDTH/2 - (DIGIT_WIDTH * COUNTDOWN_SCALE) / 2)
+#define COUNTDOWN_Y     (SCREEN_HEIGHT/2 - (DIGIT_HEIGHT * COUNTDOWN_SCALE) / 2)
+
+/**
+ * Get the physics object behind a render item (NULL for the countdown)
+ */
+static PhysicsObject* render_object(GameController* ctrl, uint8_t item) {
+    if (item < RENDER_OBSTACLE_FIRST) return &ctrl->walls[item];
+#ifdef PANIC_MODE
+    if (item < RENDER_PADDLE_FIRST) return &ctrl->obstacles[item - RENDER_OBSTACLE_FIRST];
+#endif
+    if (item < RENDER_BALL_FIRST) return &ctrl->paddles[item - RENDER_PADDLE_FIRST];
+    if (item < RENDER_COUNTDOWN_ITEM) return &ctrl->balls[item - RENDER_BALL_FIRST];
+    return NULL;
+}
+
+/**
+ * Countdown digit for the current state (0 = not counting down)
+ */
+static uint8_t countdown_digit(GameController* ctrl) {
+    if (ctrl->state != GAME_STATE_COUNTDOWN) return 0;
+
+    // Calculate which number to show (3, 2, 1), one second each
+    if (ctrl->countdown_timer > 2 * TICK_RATE_HZ) return 3;
+    if (ctrl->countdown_timer > TICK_RATE_HZ) return 2;
+    return 1;
+}
+
+/**
+ * Get where an item would be drawn this frame (empty if not shown)
+ */
+static ShapeBounds render_bounds(GameController* ctrl, uint8_t item) {
+    if (item == RENDER_COUNTDOWN_ITEM) {
+        ShapeBounds bounds = {{0, 0}, {0, 0}};
+        if (countdown_digit(ctrl) != 0) {
+            bounds.tl = (Point){COUNTDOWN_X, COUNTDOWN_Y};
+            bounds.br = (Point){COUNTDOWN_X + DIGIT_WIDTH * COUNTDOWN_SCALE,
+                                COUNTDOWN_Y + DIGIT_HEIGHT * COUNTDOWN_SCALE};
+        }
+        return bounds;
+    }
+    return get_shape_bounds(&render_object(ctrl, item)->visual);
+}
+
+/**
+ * Draw one item at its current position
+ */
+static void render_item(GameController* ctrl, uint8_t item) {
+    if (item == RENDER_COUNTDOWN_ITEM) {
+        uint8_t digit = countdown_digit(ctrl);
+        if (digit != 0) {
+            drawNumber(COUNTDOWN_X, COUNTDOWN_Y, digit, COLOR_WHITE, COUNTDOWN_SCALE);
+        }
+        ctrl->drawn_countdown = digit;
+        return;
+    }
+    draw(&render_object(ctrl, item)->visual);
+}
+
+static uint8_t bounds_empty(ShapeBounds b) {
+    return b.br.x <= b.tl.x || b.br.y <= b.tl.y;
+}
+
+static uint8_t bounds_equal(ShapeBounds a, ShapeBounds b) {
+    return a.tl.x == b.tl.x && a.tl.y == b.tl.y && a.br.x == b.br.x && a.br.y == b.br.y;
+}
+
+static uint8_t bounds_overlap(ShapeBounds a, ShapeBounds b) {
+    return a.tl.x < b.br.x && b.tl.x < a.br.x && a.tl.y < b.br.y && b.tl.y < a.br.y;
+}
+
+/**
+ * Draw the pause menu over the playfield
+ */
+static void draw_pause_menu(GameController* ctrl) {
+    // Draw semi-transparent overlay (centered rectangle) and its border
+    draw(&ctrl->pause_bg);
+    draw(&ctrl->pause_border);
+
+    // Draw "SCORE" label
+    // Scale 1: "SCORE" = 5 chars = 20 pixels, center = (128-20)/2 = 54
+    drawText(54, SCREEN_HEIGHT/2 - 10, "SCORE", COLOR_WHITE, 1);
+
+    // Draw score number (scale 2 for display)
+    // Center on screen - approximate offset for 1-3 digits
+    drawNumber(SCREEN_WIDTH/2 - 6, SCREEN_HEIGHT/2 + 0, ctrl->score, COLOR_WHITE, 2);
+}
 
-    // Title screen
+/**
+ * Clear buffer and draw the whole scene for the current state
+ */
+static void draw_full_frame(GameController* ctrl) {
+    // Title screen: sent straight from flash (layout in host/screen_encoder.c)
     if (ctrl->state == GAME_STATE_TITLE) {
-        // Draw "PADDLE PANIC" centered at top
-        // Scale 2: each char is 6 pixels wide + 2 spacing = 8 pixels per char
-        // "PADDLE PANIC" = 12 chars = 96 pixels, center = (128-96)/2 = 16
-        drawText(16, 15, "PADDLE PANIC", COLOR_WHITE, 2);
-
-        // "PRESS START" at bottom
-        // Scale 1: each char is 3 pixels wide + 1 spacing = 4 pixels per char
-        // "PRESS START" = 11 chars = 44 pixels, center = (128-44)/2 = 42
-        drawText(42, 50, "PRESS START", COLOR_WHITE, 1);
+        streamScreen(TITLE_SCREEN);
         return;
     }
 
-    // Game over screen
+    // Game over screen: image from flash, final score drawn on top
     if (ctrl->state == GAME_STATE_GAME_OVER) {
-        // Draw "GAME OVER" centered
-        // Scale 2: "GAME OVER" = 9 chars = 72 pixels, center = (128-72)/2 = 28
-        drawText(28, 15, "GAME OVER", COLOR_WHITE, 2);
+        streamScreen(GAME_OVER_SCREEN);
+        drawNumber(GAME_OVER_SCORE_X, GAME_OVER_SCORE_Y, ctrl->final_score,
+                   COLOR_WHITE, GAME_OVER_SCORE_SCALE);
+        return;
+    }
 
-        // Draw "SCORE" label
-        // Scale 1: "SCORE" = 5 chars = 20 pixels, center = (128-20)/2 = 54
-        drawText(54, 35, "SCORE", COLOR_WHITE, 1);
+    clearDisplay();
 
-        // Draw final score centered below
-        drawNumber(SCREEN_WIDTH/2 - 10, 45, ctrl->final_score, COLOR_WHITE, 2);
-        return;
+    // Gameplay states: walls, paddles, ball, countdown
+    for (uint8_t item = 0; item < RENDER_ITEM_COUNT; item++) {
+        render_item(ctrl, item);
+        ctrl->drawn_bounds[item] = render_bounds(ctrl, item);
     }
 
-    // Draw game objects (for all gameplay states)
-    // Draw walls
-    for (int i = 0; i < 4; i++) {
-        draw(ctrl->walls[i].visual);
+    // Pause menu is static while paused - nothing moves under it
+    if (ctrl->state == GAME_STATE_PAUSED) {
+        draw_pause_menu(ctrl);
     }
+}
 
-    // Draw paddles
-    for (int i = 0; i < 4; i++) {
-        draw(ctrl->paddles[i].visual);
+/**
+ * Erase items that moved and redraw them plus anything they uncovered
+ */
+static void draw_moved_items(GameController* ctrl) {
+    // Title and game over screens have nothing that moves
+    if (ctrl->state == GAME_STATE_TITLE || ctrl->state == GAME_STATE_GAME_OVER) return;
+
+    ShapeBounds erased[RENDER_ITEM_COUNT];
+    uint8_t erased_count = 0;
+    RenderMask redraw = 0;                                                   // One bit per item
+
+    // Erase every moving item whose bounds (or digit) changed
+    for (uint8_t item = 0; item < RENDER_ITEM_COUNT; item++) {
+        PhysicsObject* obj = render_object(ctrl, item);
+        if (obj != NULL && obj->is_static) continue;
+
+        ShapeBounds now = render_bounds(ctrl, item);
+        uint8_t changed = !bounds_equal(now, ctrl->drawn_bounds[item]);
+        if (item == RENDER_COUNTDOWN_ITEM) {
+            changed |= (countdown_digit(ctrl) != ctrl->drawn_countdown);
+        }
+        if (!changed) continue;
+
+        ShapeBounds old = ctrl->drawn_bounds[item];
+        if (!bounds_empty(old)) {
+            fillRect(old.tl, old.br.x - old.tl.x, old.br.y - old.tl.y, COLOR_BLACK);
+            erased[erased_count++] = old;
+        }
+        ctrl->drawn_bounds[item] = now;
+        redraw |= (RenderMask)1 << item;
     }
 
-    // Draw ball
-    draw(ctrl->ball.visual);
+    if (redraw == 0) return;                                                 // Frame unchanged
 
-    // Draw pause menu (if paused)
-    if (ctrl->state == GAME_STATE_PAUSED) {
-        // Draw semi-transparent overlay (centered rectangle)
-        Shape* pause_bg = create_rectangle(
-            (Point){SCREEN_WIDTH/2, SCREEN_HEIGHT/2},
-            60, 30,
-            ANCHOR_CENTER,
-            1,  // Filled
-            COLOR_BLACK
-        );
-        draw(pause_bg);
-        destroy_shape(pause_bg);
-
-        // Draw border around pause menu
-        Shape* pause_border = create_rectangle(
-            (Point){SCREEN_WIDTH/2, SCREEN_HEIGHT/2},
-            60, 30,
-            ANCHOR_CENTER,
-            0,  // Not filled (outline only)
-            COLOR_WHITE
-        );
-        draw(pause_border);
-        destroy_shape(pause_border);
-
-        // Draw "SCORE" label
-        // Scale 1: "SCORE" = 5 chars = 20 pixels, center = (128-20)/2 = 54
-        drawText(54, SCREEN_HEIGHT/2 - 10, "SCORE", COLOR_WHITE, 1);
-
-        // Draw score number (scale 2 for display)
-        // Center on screen - approximate offset for 1-3 digits
-        drawNumber(SCREEN_WIDTH/2 - 6, SCREEN_HEIGHT/2 + 0, ctrl->score, COLOR_WHITE, 2);
-    }
-
-    // Draw countdown (if counting down)
-    if (ctrl->state == GAME_STATE_COUNTDOWN) {
-        // Calculate which number to show (3, 2, 1)
-        // countdown_timer: 36-25 = 3, 24-13 = 2, 12-1 = 1
-        uint8_t countdown_num;
-        if (ctrl->countdown_timer > 24) {
-            countdown_num = 3;
-        } else if (ctrl->countdown_timer > 12) {
-            countdown_num = 2;
-        } else {
-            countdown_num = 1;
+    // Anything overlapping an erased area lost pixels: draw it again
+    for (uint8_t item = 0; item < RENDER_ITEM_COUNT; item++) {
+        if (redraw & ((RenderMask)1 << item)) continue;
+        for (uint8_t i = 0; i < erased_count; i++) {
+            if (bounds_overlap(ctrl->drawn_bounds[item], erased[i])) {
+                redraw |= (RenderMask)1 << item;
+                break;
+            }
         }
+    }
+
+    for (uint8_t item = 0; item < RENDER_ITEM_COUNT; item++) {
+        if (redraw & ((RenderMask)1 << item)) {
+            render_item(ctrl, item);
+        }
+    }
+
+    if (ctrl->state == GAME_STATE_PAUSED) {
+        draw_pause_menu(ctrl);
+    }
+}
+
+// physics_tick * FIXED_ONE / PHYSICS_STEP_TICKS as a multiply: a rounded-up
+// reciprocal in Q8 is exact for every physics_tick below PHYSICS_STEP_TICKS
+// as long as PHYSICS_STEP_TICKS² <= 256
+#define INTERPOLATION_RECIPROCAL ((65536UL + PHYSICS_STEP_TICKS - 1) / PHYSICS_STEP_TICKS)
+_Static_assert(PHYSICS_STEP_TICKS * PHYSICS_STEP_TICKS <= 256, "INTERPOLATION_RECIPROCAL is inexact");
+_Static_assert(FIXED_ONE == 256, "INTERPOLATION_RECIPROCAL assumes Q8.8");
+
+/**
+ * Place moving objects between their last two physics steps
+ * The physics step is PHYSICS_STEP_TICKS ticks long; rendering more often
+ * shows the fraction of the step elapsed instead of holding each position
+ */
+static void interpolate_moving_objects(GameController* ctrl) {
+    uint16_t alpha = FIXED_ONE;                                              // Paused etc.: current position
+    if (ctrl->state == GAME_STATE_BALL_AT_REST || ctrl->state == GAME_STATE_BALL_MOVING) {
+        alpha = (uint16_t)(((uint32_t)ctrl->physics_tick * INTERPOLATION_RECIPROCAL) >> 8);
+    }
+
+    for (uint8_t i = 0; i < GAME_BALL_COUNT; i++) {
+        interpolate_physics(&ctrl->balls[i], alpha);
+    }
+    for (uint8_t i = 0; i < 4; i++) {
+        interpolate_physics(&ctrl->paddles[i], alpha);
+    }
+}
+
+void draw_game_controller(GameController* ctrl) {
+    if (ctrl == NULL) return;
+
+    interpolate_moving_objects(ctrl);
+
+#ifdef DISPLAY_STRIP
+    ctrl->render_valid = 0;                                                  // Nothing retained: record the whole scene
+#endif
+    if (!ctrl->render_valid || ctrl->render_state != ctrl->state) {
+        draw_full_frame(ctrl);
+        ctrl->render_state = ctrl->state;
+        ctrl->render_valid = 1;
+    } else {
+        draw_moved_items(ctrl);
+    }
+}
 
-        // Draw large countdown number (scale 6 = 18x30 pixels)
-        // Center on screen (adjust for text size)
-        uint8_t countdown_x = SCREEN_WIDTH/2 - 9;   // 18 pixels wide / 2
-        uint8_t countdown_y = SCREEN_HEIGHT/2 - 15; // 30 pixels tall / 2
-        drawNumber(countdown_x, countdown_y, countdown_num, COLOR_WHITE, 6);
+void invalidate_game_display(GameController* ctrl) {
+    if (ctrl != NULL) {
+        ctrl->render_valid = 0;
     }
 }
@@ -9,6 +9,15 @@
  * - Collision detection and response
  * - Input interpretation (raw ADC → normalized → pixel position)
  *
+ * Build flags:
+ *     PANIC_MODE - panic mode: PANIC_BALL_COUNT balls in play at once and
+ *                  PANIC_OBSTACLE_COUNT bricks they bounce off; any ball
+ *                  reaching a wall ends the game. Collisions go through the
+ *                  physics world grid, so the cost follows the number of
+ *                  objects close to each ball rather than all pairs.
+ *     ATTRACT_MODE - the game plays itself after the title screen sits idle
+ *                  (attract.h)
+ *
  * Architecture:
  *     main.c (orchestration)
  *         ↓
@@ -25,6 +34,10 @@
 #include <stdint.h>
 #include "physics.h"
 #include "input_controller.h"
+#include "timer.h"
+#include "display_list.h"
+#include "telemetry.h"
+#include "attract.h"
 
 /*============================================================================
  * GAME CONFIGURATION
@@ -40,24 +53,43 @@
 #define PADDLE_MARGIN 3
 #define BALL_RADIUS 3
 
+// Panic mode (PANIC_MODE): balls spawn in a 4x2 block at the centre
+#define PANIC_BALL_COUNT     8          // Balls in play (2-8)
+#define PANIC_OBSTACLE_COUNT 4          // Bricks (1-4)
+#define OBSTACLE_WIDTH       10
+#define OBSTACLE_HEIGHT      4
+
+#ifdef PANIC_MODE
+#define GAME_BALL_COUNT     PANIC_BALL_COUNT
+#define GAME_OBSTACLE_COUNT PANIC_OBSTACLE_COUNT
+#else
+#define GAME_BALL_COUNT     1
+#define GAME_OBSTACLE_COUNT 0
+#endif
+
 // Joystick configuration
 #define JOYSTICK_DEADZONE 10  // Raw ADC units (out of 4095)
 
+// Timing configuration (update_game_controller() runs once per tick, see timer.h)
+#define PHYSICS_STEP_TICKS 5            // Ticks per physics step (64 Hz / 5 = 12.8 steps/s, the original frame pace)
+#define COUNTDOWN_TICKS (3 * TICK_RATE_HZ)  // Resume countdown length (3 seconds)
+#define GAME_OVER_FLASH_MS 200              // Inverted flash when the ball hits a wall
+
 // Paddle velocity configuration
-#define MAX_PADDLE_SPEED 8              // Maximum paddle speed (pixels per frame)
+#define MAX_PADDLE_SPEED 8              // Maximum paddle speed (pixels per physics step)
 #define PADDLE_SPEED_BOOST_MULTIPLIER 2 // Speed multiplier when joystick button pressed
-#define PADDLE_ACCELERATION 2           // Acceleration rate (pixels per frame²)
+#define PADDLE_ACCELERATION 2           // Acceleration rate (pixels per physics step²)
 
 // Collision configuration
-#define PADDLE_COLLISION_COOLDOWN_FRAMES 8  // Frames to wait before allowing paddle collision again
+#define PADDLE_COLLISION_COOLDOWN_TICKS (8 * PHYSICS_STEP_TICKS)  // Ticks to wait before allowing paddle collision again
 
 // Velocity curve breakpoints (piecewise linear mapping)
 #define PADDLE_DEFLECTION_LOW  512      // 25% joystick deflection (0-2048 range)
 #define PADDLE_DEFLECTION_MID  1536     // 75% joystick deflection (0-2048 range)
 
-#define PADDLE_SPEED_LOW   2            // Speed at 25% deflection (pixels per frame)
-#define PADDLE_SPEED_MID   4            // Speed at 75% deflection (pixels per frame)
-#define PADDLE_SPEED_HIGH  8            // Speed at 100% deflection (pixels per frame)
+#define PADDLE_SPEED_LOW   2            // Speed at 25% deflection (pixels per physics step)
+#define PADDLE_SPEED_MID   4            // Speed at 75% deflection (pixels per physics step)
+#define PADDLE_SPEED_HIGH  8            // Speed at 100% deflection (pixels per physics step)
 
 /*============================================================================
  * GAME CONTROLLER STRUCTURE
@@ -76,6 +108,17 @@ typedef enum {
     GAME_STATE_GAME_OVER       // Game over, showing final score
 } GameState;
 
+/**
+ * Items tracked by the retained renderer, in draw order:
+ * walls, obstacles, paddles, balls, countdown digit
+ * (walls 0-3, paddles 4-7, ball 8, countdown 9 in the normal game)
+ */
+#define RENDER_OBSTACLE_FIRST 4
+#define RENDER_PADDLE_FIRST   (RENDER_OBSTACLE_FIRST + GAME_OBSTACLE_COUNT)
+#define RENDER_BALL_FIRST     (RENDER_PADDLE_FIRST + 4)
+#define RENDER_COUNTDOWN_ITEM (RENDER_BALL_FIRST + GAME_BALL_COUNT)
+#define RENDER_ITEM_COUNT     (RENDER_COUNTDOWN_ITEM + 1)
+
 /**
  * GameController structure
  * Owns all game objects and input controller
@@ -104,28 +147,61 @@ typedef struct {
     // Game state
     GameState state;
 
-    // Ball object
-    PhysicsObject ball;
+    // Ball objects (ball 0 owns the sprite the others share)
+    PhysicsObject balls[GAME_BALL_COUNT];
+
+#ifdef PANIC_MODE
+    // Panic mode bricks
+    PhysicsObject obstacles[GAME_OBSTACLE_COUNT];
+#endif
+
+    // Collision world (walls, obstacles, paddles, balls)
+    PhysicsWorld world;
 
     // Score tracking
     uint16_t score;
     uint16_t final_score;  // Saved score for game over screen
 
     // Collision cooldown per paddle (prevents paddle trapping)
-    uint8_t paddle_collision_cooldown[4];  // One cooldown per paddle
+    uint8_t paddle_collision_cooldown[4];  // One cooldown per paddle (in ticks)
+
+    // Fixed-timestep bookkeeping
+    uint8_t physics_tick;                  // Ticks since the last physics step
 
     // Current paddle velocities (for smooth acceleration)
     int8_t paddle_current_velocity_x;  // Current X velocity (horizontal paddles)
     int8_t paddle_current_velocity_y;  // Current Y velocity (vertical paddles)
 
+#ifdef ATTRACT_MODE
+    // Attract mode idle and demo timers
+    Attract attract;
+#endif
+
     // Pause state
-    Vector2D paused_ball_velocity;     // Ball velocity saved when paused
-    uint8_t countdown_timer;           // Countdown timer (in frames, 60 fps ≈ 1 sec)
+    FixedVector paused_ball_velocity[GAME_BALL_COUNT];  // Ball velocities saved when paused (Q8.8)
+    uint16_t countdown_timer;          // Countdown timer (in ticks, TICK_RATE_HZ ticks = 1 sec)
+
+    // Retained rendering (buffer keeps the last frame between renders)
+    uint8_t render_valid;                          // 0 = clear and redraw everything next frame
+    GameState render_state;                        // State the static layer was drawn for
+    ShapeBounds drawn_bounds[RENDER_ITEM_COUNT];   // Where each item was drawn last frame
+    uint8_t drawn_countdown;                       // Countdown digit on screen (0 = none)
 
-    // Button edge detection
-    uint8_t button1_prev_state;
+    // Pause menu overlay (persistent, built once at init)
+    Shape pause_bg;                                // Filled black box
+    Shape pause_border;                            // White outline
 } GameController;
 
+/**
+ * Static RAM of the whole game: display driver (and display list), pools,
+ * telemetry ring (TELEMETRY_ENABLED) and the controller
+ * main.c checks it plus the stack reserve against HAL_SRAM_BYTES;
+ * host/memory_report.c breaks it down
+ */
+#define GAME_STACK_RESERVE_BYTES 192    // Stack, timer/profiler/latency test state, compiler temporaries
+#define GAME_STATIC_RAM_BYTES    (DISPLAY_RAM_BYTES + DISPLAY_LIST_RAM_BYTES + SHAPE_POOL_BYTES + \
+                                  INPUT_POOL_BYTES + TELEMETRY_RAM_BYTES + sizeof(GameController))
+
 /*============================================================================
  * GAME CONTROLLER OPERATIONS
  *==========================================================================*/
@@ -146,20 +222,39 @@ void destroy_game_controller(GameController* ctrl);
 
 /**
  * Update game state
- * - Polls input controller
- * - Updates paddle positions based on joystick
- * - Checks collisions (when ball exists)
+ * - Polls input controller (every tick)
+ * - Updates paddle positions based on joystick (every physics step)
+ * - Checks collisions (when ball exists, every physics step)
  *
- * Call once per frame in game loop
+ * Call exactly once per tick (TICK_RATE_HZ), independent of rendering
  * @param ctrl Pointer to game controller
  */
 void update_game_controller(GameController* ctrl);
 
+/**
+ * Check whether the game is on a static screen with nothing happening
+ * True on the title, pause and game over screens during ticks without a
+ * button 1 press; the power manager may then sleep deeper
+ * @param ctrl Pointer to game controller
+ * @return 1 if idle, 0 otherwise
+ */
+uint8_t game_controller_idle(GameController* ctrl);
+
 /**
  * Draw all game objects
- * Call between clearDisplay() and refreshDisplay()
+ * The previous frame is kept in buffer: on a state change everything is
+ * cleared and redrawn (static layer), otherwise only items that moved are
+ * erased at their old bounds and redrawn. Do not call clearDisplay() first;
+ * call refreshDisplay() / refreshDisplayAsync() afterwards.
  * @param ctrl Pointer to game controller
  */
 void draw_game_controller(GameController* ctrl);
 
+/**
+ * Force a full redraw on the next draw_game_controller() call
+ * Use after drawing something else over the frame (e.g. an overlay)
+ * @param ctrl Pointer to game controller
+ */
+void invalidate_game_display(GameController* ctrl);
+
 #endif // GAME_CONTROLLER_H
@@ -0,0 +1,361 @@
+/*============================================================================
+ * hal.h
+ *============================================================================
+ * Hardware abstraction layer for PaddlePanic
+ *
+ * All register accesses of the game go through this interface, so the same
+ * game code builds for the ATtiny1627 and for a desktop simulator.
+ *
+ * Architecture:
+ *     sh1106_graphics.c / io_hardware.c / timer.c / profiler.c
+ *         ↓
+ *     hal.h (this interface)
+ *         ↓                               ↓
+ *     hal_attiny1627.c/h (target)    host/hal_host.c (mock, HAL_HOST builds)
+ *
+ * Functions used once per byte or pixel (SPI data, D/C, CS) are static
+ * inline on the target (hal_attiny1627.h) and plain functions on the host.
+ *
+ * Build flags:
+ *     HAL_HOST - build against the host mock instead of the ATtiny1627
+ *==========================================================================*/
+
+#ifndef HAL_H
+#define HAL_H
+
+#include <stdint.h>
+#include "clock.h"
+
+/*============================================================================
+ * HAL CONFIGURATION
+ *==========================================================================*/
+
+// F_CPU and the peripheral prescalers come from the clock profile (clock.h)
+#define HAL_COUNTER_DIV CLOCK_COUNTER_DIV                // Free-running counter prescaler
+#define HAL_COUNTER_HZ  (F_CPU / HAL_COUNTER_DIV)        // Counter rate (156 kHz = 6.4 µs at 10 MHz)
+
+/*============================================================================
+ * HAL TYPES
+ *==========================================================================*/
+
+/**
+ * Handler called from an interrupt (or from the mock on the host)
+ */
+typedef void (*HalHandler)(void);
+
+/**
+ * GPIO ports used by the game
+ */
+typedef enum {
+    HAL_PORTA,
+    HAL_PORTB,
+    HAL_PORTC
+} HalPort;
+
+/**
+ * Called from a pin-change interrupt
+ * @param port Port that raised the interrupt
+ * @param pins Bitmask of the pins that changed (already acknowledged)
+ */
+typedef void (*HalPinHandler)(HalPort port, uint8_t pins);
+
+/**
+ * CPU sleep modes, lightest first
+ */
+typedef enum {
+    HAL_SLEEP_IDLE,                                      // CPU stopped, peripherals run (SPI, ADC, timers)
+    HAL_SLEEP_STANDBY,                                   // Peripheral clock stopped; RTC and pin changes wake
+    HAL_SLEEP_POWER_DOWN                                 // Only pin changes (and an enabled PIT) wake
+} HalSleepMode;
+
+/**
+ * SPI interrupt sources for the display stream
+ */
+typedef enum {
+    HAL_SPI_IRQ_NONE,                                    // No SPI interrupts
+    HAL_SPI_IRQ_DATA_EMPTY,                              // Transmit buffer has room
+    HAL_SPI_IRQ_TX_COMPLETE                              // Transmit buffer and shifter empty
+} HalSpiInterrupt;
+
+/*============================================================================
+ * GENERAL
+ *==========================================================================*/
+
+/**
+ * Switch the main clock to the clock profile's F_CPU (clock.h)
+ * Call first: every peripheral rate and delay is derived from F_CPU
+ */
+void hal_clock_init(void);
+
+/**
+ * Enable global interrupts
+ */
+void hal_interrupts_enable(void);
+
+/**
+ * Disable global interrupts (start of a critical section)
+ * @return Previous interrupt state, for hal_interrupts_restore()
+ */
+uint8_t hal_interrupts_disable(void);
+
+/**
+ * Restore the interrupt state saved by hal_interrupts_disable()
+ * @param state Value returned by hal_interrupts_disable()
+ */
+void hal_interrupts_restore(uint8_t state);
+
+/**
+ * Sleep until an interrupt
+ * Call with interrupts disabled after checking that there is nothing to do;
+ * interrupts are enabled atomically with going to sleep, so a wake-up
+ * between the check and the sleep is not lost. Returns with interrupts
+ * enabled, after the waking handler ran. A background ADC scan stopped by
+ * STANDBY or POWER_DOWN is restarted.
+ * @param mode Sleep mode
+ */
+void hal_sleep(HalSleepMode mode);
+
+/*============================================================================
+ * DISPLAY LINK (SH1106 over SPI0)
+ *==========================================================================*/
+
+/**
+ * Configure SPI0 (host mode, Mode 3, buffer mode, f_clk / CLOCK_SPI_DIV)
+ * and the display CS, D/C and RES pins; CS is left deasserted
+ */
+void hal_display_init(void);
+
+/**
+ * Drive the display RES line
+ * @param level 1 = released (high), 0 = held in reset (low)
+ */
+void hal_display_reset(uint8_t level);
+
+/**
+ * Register the handler for SPI interrupts (see hal_spi_set_interrupt())
+ * @param handler Function called for each enabled SPI interrupt
+ */
+void hal_spi_set_handler(HalHandler handler);
+
+#ifdef HAL_HOST
+
+/**
+ * Drive the display D/C line; only change while hal_spi_idle()
+ * @param data_mode 1 = data, 0 = command
+ */
+void hal_display_dc(uint8_t data_mode);
+
+/**
+ * Drive the display CS line
+ * @param selected 1 = asserted (low), 0 = released (high)
+ */
+void hal_display_select(uint8_t selected);
+
+/**
+ * Queue one byte for transmission, waiting for room in the transmit buffer
+ * @param byte Byte to send
+ */
+void hal_spi_write(uint8_t byte);
+
+/**
+ * Check whether every queued byte has been shifted out
+ * @return 1 if the bus is idle, 0 while bytes are still being sent
+ */
+uint8_t hal_spi_idle(void);
+
+/**
+ * Select which SPI interrupt calls the registered handler
+ * @param irq Interrupt source (HAL_SPI_IRQ_NONE to disable)
+ */
+void hal_spi_set_interrupt(HalSpiInterrupt irq);
+
+#ifndef PIN0_bm
+#define PIN0_bm 0x01
+#define PIN1_bm 0x02
+#define PIN2_bm 0x04
+#define PIN3_bm 0x08
+#define PIN4_bm 0x10
+#define PIN5_bm 0x20
+#define PIN6_bm 0x40
+#define PIN7_bm 0x80
+#endif
+
+#define HAL_STORAGE_BYTES 16384                          // Mock non-volatile storage (file-backed)
+#define HAL_SRAM_BYTES    2048                           // Target SRAM (memory report)
+
+#else
+
+#include "hal_attiny1627.h"
+
+#endif // HAL_HOST
+
+/*============================================================================
+ * GPIO
+ *==========================================================================*/
+
+/**
+ * Configure a pin as a digital input
+ * @param port Port of the pin
+ * @param pin_bm Pin bitmask (e.g. PIN4_bm)
+ * @param pullup 1 to enable the internal pull-up
+ */
+void hal_pin_input(HalPort port, uint8_t pin_bm, uint8_t pullup);
+
+/**
+ * Read a digital input
+ * @param port Port of the pin
+ * @param pin_bm Pin bitmask
+ * @return 1 if the pin is high, 0 if low
+ */
+uint8_t hal_pin_read(HalPort port, uint8_t pin_bm);
+
+/**
+ * Configure a pin as a digital output (driven low)
+ * @param port Port of the pin
+ * @param pin_bm Pin bitmask
+ */
+void hal_pin_output(HalPort port, uint8_t pin_bm);
+
+/**
+ * Invert the level of an output pin
+ * @param port Port of the pin
+ * @param pin_bm Pin bitmask
+ */
+void hal_pin_toggle(HalPort port, uint8_t pin_bm);
+
+/**
+ * Register the handler for pin-change interrupts (all ports)
+ * @param handler Function called with the pins that changed
+ */
+void hal_pin_set_change_handler(HalPinHandler handler);
+
+/**
+ * Raise a pin-change interrupt on both edges of an input
+ * Keeps the pull-up setting from hal_pin_input()
+ * @param port Port of the pin
+ * @param pin_bm Pin bitmask
+ */
+void hal_pin_change_enable(HalPort port, uint8_t pin_bm);
+
+/*============================================================================
+ * ADC
+ *==========================================================================*/
+
+/**
+ * Configure ADC0 for 12-bit single-ended conversions on the joystick pins
+ */
+void hal_adc_init(void);
+
+/**
+ * Run one blocking conversion
+ * @param channel Analog input (AIN1-AIN7)
+ * @param result Receives the 12-bit result (0-4095)
+ * @return 1 on success, 0 if the channel is not supported or a scan is running
+ */
+uint8_t hal_adc_read(uint8_t channel, uint16_t* result);
+
+/**
+ * Samples accumulated per background result (hardware burst accumulation)
+ */
+#define HAL_ADC_ACCUMULATE_LOG2 6                        // 64 samples
+
+/**
+ * Called from the ADC interrupt with each background result
+ * @param index Position of the channel in the scan list
+ * @param result Averaged 12-bit result (0-4095)
+ */
+typedef void (*HalAdcHandler)(uint8_t index, uint16_t result);
+
+/**
+ * Convert channels in turn in the background (never returns to blocking use)
+ * Each result is the average of 2^HAL_ADC_ACCUMULATE_LOG2 samples; the
+ * next channel is started from the result-ready interrupt
+ * @param channels Analog inputs to scan (AIN1-AIN7, must stay valid)
+ * @param count Number of channels (1 or more)
+ * @param handler Function receiving each result
+ */
+void hal_adc_start_scan(const uint8_t* channels, uint8_t count, HalAdcHandler handler);
+
+/*============================================================================
+ * TIMERS
+ *==========================================================================*/
+
+/**
+ * Start the 64 Hz periodic tick (RTC PIT, 32768 / 512)
+ * @param handler Function called on every tick
+ */
+void hal_tick_init(HalHandler handler);
+
+/**
+ * Pause or resume the tick interrupt (the PIT keeps its phase)
+ * @param enabled 1 = ticks fire, 0 = no ticks (POWER_DOWN then only wakes on pins)
+ */
+void hal_tick_enable(uint8_t enabled);
+
+/**
+ * Start the free-running 16-bit counter at HAL_COUNTER_HZ (TCA0)
+ */
+void hal_counter_init(void);
+
+/**
+ * Read the free-running counter
+ * @return Counter value (wraps at 65536)
+ */
+uint16_t hal_counter_read(void);
+
+/*============================================================================
+ * SERIAL
+ *==========================================================================*/
+
+/**
+ * Configure USART0 for transmit only (TXD on PB2)
+ * @param baud Baud rate
+ */
+void hal_serial_init(uint32_t baud);
+
+/**
+ * Send one byte (blocking; returns at once from the data register empty
+ * handler, where the transmit buffer has room)
+ * @param byte Byte to send
+ */
+void hal_serial_write(uint8_t byte);
+
+/**
+ * Register the handler for the transmit data register empty interrupt
+ * (see hal_serial_set_interrupt())
+ * @param handler Function called each time the transmit buffer has room
+ */
+void hal_serial_set_handler(HalHandler handler);
+
+/**
+ * Enable or disable the data register empty interrupt
+ * While enabled, the handler sends one byte with hal_serial_write() per
+ * call, or disables the interrupt when it has nothing left to send. On the
+ * host, bytes leave at the baud rate: each hal_host_tick() runs the handler
+ * for one tick's worth of bytes.
+ * @param enabled 1 = enable, 0 = disable
+ */
+void hal_serial_set_interrupt(uint8_t enabled);
+
+/*============================================================================
+ * STORAGE
+ *==========================================================================*/
+
+/**
+ * Read from non-volatile storage (EEPROM, HAL_STORAGE_BYTES)
+ * @param offset First byte
+ * @param data Receives the bytes
+ * @param length Number of bytes (must end within HAL_STORAGE_BYTES)
+ */
+void hal_storage_read(uint16_t offset, uint8_t* data, uint8_t length);
+
+/**
+ * Write to non-volatile storage (blocking: one erase/write cycle of a few
+ * ms per EEPROM page touched)
+ * @param offset First byte
+ * @param data Bytes to write
+ * @param length Number of bytes (must end within HAL_STORAGE_BYTES)
+ */
+void hal_storage_write(uint16_t offset, const uint8_t* data, uint8_t length);
+
+#endif // HAL_H
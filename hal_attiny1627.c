@@ -0,0 +1,423 @@
+/*============================================================================
+ * hal_attiny1627.c
+ *============================================================================
+ * ATtiny1627 implementation of the hardware abstraction layer
+ * All peripheral register accesses and interrupt vectors live here (and in
+ * hal_attiny1627.h)
+ *==========================================================================*/
+
+#include "hal.h"
+
+#ifndef HAL_HOST
+
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <stddef.h>
+
+/*============================================================================
+ * CLOCK PROFILE REGISTER VALUES (clock.h)
+ *==========================================================================*/
+
+// Register group name from a divider, e.g. HAL_GROUP(ADC_PRESC_DIV, 4, _gc)
+#define HAL_GROUP_(prefix, div, suffix) prefix##div##suffix
+#define HAL_GROUP(prefix, div, suffix)  HAL_GROUP_(prefix, div, suffix)
+
+#if CLOCK_MAIN_DIV == 1
+#define HAL_MCLK_PRESCALER 0                                                 // Prescaler off
+#else
+#define HAL_MCLK_PRESCALER (HAL_GROUP(CLKCTRL_PDIV_, CLOCK_MAIN_DIV, X_gc) | CLKCTRL_PEN_bm)
+#endif
+
+// CLK2X doubles the rate of each PRESC step
+#if CLOCK_SPI_DIV == 2
+#define HAL_SPI_PRESCALER (SPI_PRESC_DIV4_gc | SPI_CLK2X_bm)
+#elif CLOCK_SPI_DIV == 4
+#define HAL_SPI_PRESCALER SPI_PRESC_DIV4_gc
+#elif CLOCK_SPI_DIV == 8
+#define HAL_SPI_PRESCALER (SPI_PRESC_DIV16_gc | SPI_CLK2X_bm)
+#elif CLOCK_SPI_DIV == 16
+#define HAL_SPI_PRESCALER SPI_PRESC_DIV16_gc
+#else
+#define HAL_SPI_PRESCALER (SPI_PRESC_DIV64_gc | SPI_CLK2X_bm)
+#endif
+
+#define HAL_ADC_PRESCALER     HAL_GROUP(ADC_PRESC_DIV, CLOCK_ADC_DIV, _gc)
+#define HAL_COUNTER_PRESCALER HAL_GROUP(TCA_SINGLE_CLKSEL_DIV, CLOCK_COUNTER_DIV, _gc)
+
+/*============================================================================
+ * INTERRUPT HANDLERS
+ *==========================================================================*/
+
+static HalHandler spi_handler = NULL;
+static HalHandler tick_handler = NULL;
+static HalAdcHandler adc_handler = NULL;
+static HalPinHandler pin_handler = NULL;
+static HalHandler serial_handler = NULL;
+
+/**
+ * SPI interrupt (data register empty / transmit complete)
+ */
+ISR(SPI0_INT_vect) {
+    if (spi_handler != NULL) {
+        spi_handler();
+    } else {
+        SPI0.INTCTRL = 0;                                                    // Nobody listening
+    }
+}
+
+/**
+ * USART0 data register empty - room for the next byte
+ */
+ISR(USART0_DRE_vect) {
+    if (serial_handler != NULL) {
+        serial_handler();
+    } else {
+        USART0.CTRLA = 0;                                                    // Nobody listening
+    }
+}
+
+/**
+ * RTC periodic interrupt - one tick
+ */
+ISR(RTC_PIT_vect) {
+    RTC.PITINTFLAGS = RTC_PI_bm;                                             // Clear interrupt flag
+    if (tick_handler != NULL) {
+        tick_handler();
+    }
+}
+
+/**
+ * ADC result ready - one accumulated burst done
+ * Defined with the rest of the ADC code below
+ */
+static void adc_result_ready(void);
+
+ISR(ADC0_RESRDY_vect) {
+    adc_result_ready();
+}
+
+/**
+ * Pin change on a port - acknowledge and report the changed pins
+ */
+static void port_changed(HalPort port, volatile PORT_t* regs) {
+    uint8_t pins = regs->INTFLAGS;
+    regs->INTFLAGS = pins;                                                   // Clear by writing ones
+    if (pin_handler != NULL) {
+        pin_handler(port, pins);
+    }
+}
+
+ISR(PORTA_PORT_vect) {
+    port_changed(HAL_PORTA, &PORTA);
+}
+
+ISR(PORTB_PORT_vect) {
+    port_changed(HAL_PORTB, &PORTB);
+}
+
+ISR(PORTC_PORT_vect) {
+    port_changed(HAL_PORTC, &PORTC);
+}
+
+/*============================================================================
+ * GENERAL
+ *==========================================================================*/
+
+void hal_clock_init(void) {
+    // Main clock stays on the internal oscillator (OSCCFG fuse: CLOCK_OSC_HZ)
+    _PROTECTED_WRITE(CLKCTRL.MCLKCTRLB, HAL_MCLK_PRESCALER);
+}
+
+void hal_interrupts_enable(void) {
+    sei();
+}
+
+uint8_t hal_interrupts_disable(void) {
+    uint8_t state = SREG;
+    cli();
+    return state;
+}
+
+void hal_interrupts_restore(uint8_t state) {
+    SREG = state;                                                            // Re-enables only if they were on
+}
+
+void hal_sleep(HalSleepMode mode) {
+    switch (mode) {
+        case HAL_SLEEP_IDLE:      SLPCTRL.CTRLA = SLPCTRL_SMODE_IDLE_gc | SLPCTRL_SEN_bm;  break;
+        case HAL_SLEEP_STANDBY:   SLPCTRL.CTRLA = SLPCTRL_SMODE_STDBY_gc | SLPCTRL_SEN_bm; break;
+        default:                  SLPCTRL.CTRLA = SLPCTRL_SMODE_PDOWN_gc | SLPCTRL_SEN_bm; break;
+    }
+
+    sei();                                                                   // Takes effect after the next instruction
+    sleep_cpu();                                                             // ... so no interrupt slips in before this
+    SLPCTRL.CTRLA = 0;
+
+    // The ADC does not run in STANDBY / POWER_DOWN: restart the scan burst
+    if (mode != HAL_SLEEP_IDLE && adc_handler != NULL) {
+        ADC0.COMMAND = ADC_MODE_BURST_gc | ADC_START_IMMEDIATE_gc;
+    }
+}
+
+/*============================================================================
+ * DISPLAY LINK
+ *==========================================================================*/
+
+void hal_display_init(void) {
+    PORTMUX.SPIROUTEA |= PORTMUX_SPI0_ALT1_gc;                               // Route SPI0 to alternate pin locations
+
+    PORTC.DIR |= PIN0_bm | PIN2_bm | HAL_DISPLAY_CS_bm;                      // Set as outputs: PC0=SCLK, PC2=MOSI, PC3=SS
+    PORTB.DIR |= HAL_DISPLAY_RES_bm | HAL_DISPLAY_DC_bm;                     // Set as outputs: PB0=RESET, PB1=D/C
+
+    SPI0.CTRLA |= SPI_MASTER_bm | HAL_SPI_PRESCALER;                         // Host mode, f_clk / CLOCK_SPI_DIV
+    SPI0.CTRLB |= SPI_BUFEN_bm | SPI_MODE_3_gc;                              // Buffer mode, CPOL=1, CPHA=1 (idle high, sample on rising edge)
+    SPI0.CTRLA |= SPI_ENABLE_bm;                                             // Enable SPI peripheral
+
+    PORTC.OUTSET = HAL_DISPLAY_CS_bm;                                        // Deassert CS (active low, so idle high)
+}
+
+void hal_display_reset(uint8_t level) {
+    if (level) {
+        PORTB.OUTSET = HAL_DISPLAY_RES_bm;
+    } else {
+        PORTB.OUTCLR = HAL_DISPLAY_RES_bm;
+    }
+}
+
+void hal_spi_set_handler(HalHandler handler) {
+    spi_handler = handler;
+}
+
+/*============================================================================
+ * GPIO
+ *==========================================================================*/
+
+/**
+ * Map a HalPort to its register block
+ */
+static volatile PORT_t* port_registers(HalPort port) {
+    switch (port) {
+        case HAL_PORTA: return &PORTA;
+        case HAL_PORTB: return &PORTB;
+        default:        return &PORTC;
+    }
+}
+
+/**
+ * Get the PINnCTRL register of a pin
+ */
+static volatile uint8_t* pin_control(volatile PORT_t* regs, uint8_t pin_bm) {
+    // Calculate pin index from bitmask
+    uint8_t pin_index = 0;
+    uint8_t mask = pin_bm;
+    while (mask > 1) {
+        mask >>= 1;
+        pin_index++;
+    }
+
+    return (volatile uint8_t*)&regs->PIN0CTRL + pin_index;
+}
+
+void hal_pin_input(HalPort port, uint8_t pin_bm, uint8_t pullup) {
+    volatile PORT_t* regs = port_registers(port);
+    regs->DIRCLR = pin_bm;                                                   // Set pin as input
+
+    if (pullup) {
+        *pin_control(regs, pin_bm) = PORT_PULLUPEN_bm;
+    }
+}
+
+uint8_t hal_pin_read(HalPort port, uint8_t pin_bm) {
+    return (port_registers(port)->IN & pin_bm) ? 1 : 0;
+}
+
+void hal_pin_output(HalPort port, uint8_t pin_bm) {
+    volatile PORT_t* regs = port_registers(port);
+    regs->OUTCLR = pin_bm;
+    regs->DIRSET = pin_bm;
+}
+
+void hal_pin_toggle(HalPort port, uint8_t pin_bm) {
+    port_registers(port)->OUTTGL = pin_bm;
+}
+
+void hal_pin_set_change_handler(HalPinHandler handler) {
+    pin_handler = handler;
+}
+
+void hal_pin_change_enable(HalPort port, uint8_t pin_bm) {
+    volatile PORT_t* regs = port_registers(port);
+    volatile uint8_t* ctrl = pin_control(regs, pin_bm);
+    regs->INTFLAGS = pin_bm;                                                 // Drop a stale edge
+    *ctrl = (*ctrl & ~PORT_ISC_gm) | PORT_ISC_BOTHEDGES_gc;
+}
+
+/*============================================================================
+ * ADC
+ *==========================================================================*/
+
+void hal_adc_init(void) {
+    // Reference: ATtiny1627 Datasheet Section 30 (ADC)
+
+    // Configure PA1 and PA2 as analog inputs
+    // Disable digital input buffers for accurate ADC readings
+    PORTA.DIRCLR = PIN1_bm | PIN2_bm;                                        // Set PA1 and PA2 as inputs
+    PORTA.PIN1CTRL = PORT_ISC_INPUT_DISABLE_gc;                              // Disable digital buffer on PA1
+    PORTA.PIN2CTRL = PORT_ISC_INPUT_DISABLE_gc;                              // Disable digital buffer on PA2
+
+    ADC0.COMMAND |= ADC_MODE_SINGLE_12BIT_gc;
+
+    // Enable ADC (12-bit resolution)
+    ADC0.CTRLA = ADC_ENABLE_bm;
+
+    // Configure ADC prescaler (CLK_PER / CLOCK_ADC_DIV)
+    ADC0.CTRLB = HAL_ADC_PRESCALER;
+
+    // Configure voltage reference
+    ADC0.CTRLC = ADC_REFSEL_VDD_gc;
+}
+
+/**
+ * Select an input channel
+ * @return 0 if the channel is not supported
+ */
+static uint8_t adc_select(uint8_t channel) {
+    // Select ADC channel using proper MUX constants
+    // Must use ADC_MUXPOS_AINx_gc constants, not raw channel numbers
+    switch (channel) {
+        case 1: ADC0.MUXPOS = ADC_MUXPOS_AIN1_gc; break;
+        case 2: ADC0.MUXPOS = ADC_MUXPOS_AIN2_gc; break;
+        case 3: ADC0.MUXPOS = ADC_MUXPOS_AIN3_gc; break;
+        case 4: ADC0.MUXPOS = ADC_MUXPOS_AIN4_gc; break;
+        case 5: ADC0.MUXPOS = ADC_MUXPOS_AIN5_gc; break;
+        case 6: ADC0.MUXPOS = ADC_MUXPOS_AIN6_gc; break;
+        case 7: ADC0.MUXPOS = ADC_MUXPOS_AIN7_gc; break;
+        default: return 0;                                                   // Invalid channel
+    }
+    return 1;
+}
+
+uint8_t hal_adc_read(uint8_t channel, uint16_t* result) {
+    if (adc_handler != NULL) return 0;                                       // Scan owns the ADC
+    if (!adc_select(channel)) return 0;
+
+    // Start conversion (use |= to preserve mode bits)
+    ADC0.COMMAND |= ADC_START_IMMEDIATE_gc;
+
+    // Wait for conversion to complete
+    while (!(ADC0.INTFLAGS & ADC_RESRDY_bm));
+
+    // Read result (12-bit: 0-4095)
+    *result = ADC0.RESULT;
+    return 1;
+}
+
+static const uint8_t* scan_channels;
+static uint8_t scan_count;
+static uint8_t scan_index;
+
+void hal_adc_start_scan(const uint8_t* channels, uint8_t count, HalAdcHandler handler) {
+    scan_channels = channels;
+    scan_count = count;
+    scan_index = 0;
+    adc_handler = handler;
+
+    ADC0.CTRLF = ADC_SAMPNUM_ACC64_gc;                                       // 2^HAL_ADC_ACCUMULATE_LOG2 samples per result
+    ADC0.INTCTRL = ADC_RESRDY_bm;
+    adc_select(channels[0]);
+    ADC0.COMMAND = ADC_MODE_BURST_gc | ADC_START_IMMEDIATE_gc;               // One burst = 64 accumulated conversions
+}
+
+static void adc_result_ready(void) {
+    // 32-bit accumulated sum; reading RESULT clears RESRDY
+    uint16_t average = (uint16_t)(ADC0.RESULT >> HAL_ADC_ACCUMULATE_LOG2);
+    uint8_t index = scan_index;
+
+    // Start the next channel before handing out this result
+    if (++scan_index == scan_count) scan_index = 0;
+    adc_select(scan_channels[scan_index]);
+    ADC0.COMMAND = ADC_MODE_BURST_gc | ADC_START_IMMEDIATE_gc;
+
+    adc_handler(index, average);
+}
+
+/*============================================================================
+ * TIMERS
+ *==========================================================================*/
+
+void hal_tick_init(HalHandler handler) {
+    tick_handler = handler;
+
+    while (RTC.STATUS > 0) {}                                                // Wait for RTC registers to sync
+    RTC.CLKSEL = RTC_CLKSEL_INT32K_gc;                                       // 32.768 kHz internal oscillator
+
+    while (RTC.PITSTATUS > 0) {}                                             // Wait for PIT registers to sync
+    RTC.PITINTCTRL = RTC_PI_bm;                                              // Enable periodic interrupt
+    RTC.PITCTRLA = RTC_PERIOD_CYC512_gc | RTC_PITEN_bm;                      // 32768 / 512 = 64 Hz
+}
+
+void hal_tick_enable(uint8_t enabled) {
+    RTC.PITINTFLAGS = RTC_PI_bm;                                             // No stale tick on resume
+    RTC.PITINTCTRL = enabled ? RTC_PI_bm : 0;
+}
+
+void hal_counter_init(void) {
+    TCA0.SINGLE.PER = 0xFFFF;                                                // Free-running 16-bit
+    TCA0.SINGLE.CTRLA = HAL_COUNTER_PRESCALER | TCA_SINGLE_ENABLE_bm;        // CLK_PER / HAL_COUNTER_DIV
+}
+
+uint16_t hal_counter_read(void) {
+    return TCA0.SINGLE.CNT;
+}
+
+/*============================================================================
+ * SERIAL
+ *==========================================================================*/
+
+void hal_serial_init(uint32_t baud) {
+    PORTB.DIRSET = PIN2_bm;                                                  // TXD on PB2
+    USART0.BAUD = (uint16_t)((64UL * F_CPU) / (16UL * baud));
+    USART0.CTRLB = USART_TXEN_bm;
+}
+
+void hal_serial_write(uint8_t byte) {
+    while (!(USART0.STATUS & USART_DREIF_bm)) {}
+    USART0.TXDATAL = byte;
+}
+
+void hal_serial_set_handler(HalHandler handler) {
+    serial_handler = handler;
+}
+
+void hal_serial_set_interrupt(uint8_t enabled) {
+    USART0.CTRLA = enabled ? USART_DREIE_bm : 0;                             // No receive interrupts
+}
+
+/*============================================================================
+ * STORAGE
+ *==========================================================================*/
+
+void hal_storage_read(uint16_t offset, uint8_t* data, uint8_t length) {
+    const volatile uint8_t* eeprom = (const volatile uint8_t*)(EEPROM_START + offset);
+    while (NVMCTRL.STATUS & NVMCTRL_EEBUSY_bm) {}                            // Reads stall during a write
+    for (uint8_t i = 0; i < length; i++) {
+        data[i] = eeprom[i];
+    }
+}
+
+void hal_storage_write(uint16_t offset, const uint8_t* data, uint8_t length) {
+    volatile uint8_t* eeprom = (volatile uint8_t*)(EEPROM_START + offset);
+    for (uint8_t i = 0; i < length; i++) {
+        while (NVMCTRL.STATUS & NVMCTRL_EEBUSY_bm) {}
+        eeprom[i] = data[i];                                                 // Loads the page buffer
+
+        // Erase/write the loaded bytes at the end of each page and at the end
+        uint16_t address = offset + i;
+        if (i + 1 == length || ((address + 1) & (EEPROM_PAGE_SIZE - 1)) == 0) {
+            _PROTECTED_WRITE_SPM(NVMCTRL.CTRLA, NVMCTRL_CMD_PAGEERASEWRITE_gc);
+        }
+    }
+    while (NVMCTRL.STATUS & NVMCTRL_EEBUSY_bm) {}
+}
+
+#endif // HAL_HOST
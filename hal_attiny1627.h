@@ -0,0 +1,67 @@
+/*============================================================================
+ * hal_attiny1627.h
+ *============================================================================
+ * Inline part of the ATtiny1627 HAL (included by hal.h, do not include
+ * directly)
+ *
+ * Hot-path display link operations are defined here so each SPI byte costs
+ * a register access rather than a function call. See hal.h for the
+ * documentation of each function.
+ *
+ * Pin assignments:
+ *     PC0 = SCK, PC2 = MOSI, PC3 = CS  (SPI0 alternate pins)
+ *     PB0 = RES, PB1 = D/C
+ *==========================================================================*/
+
+#ifndef HAL_ATTINY1627_H
+#define HAL_ATTINY1627_H
+
+#include <xc.h>
+
+#define HAL_DISPLAY_CS_bm  PIN3_bm                       // PORTC
+#define HAL_DISPLAY_RES_bm PIN0_bm                       // PORTB
+#define HAL_DISPLAY_DC_bm  PIN1_bm                       // PORTB
+
+#define HAL_SRAM_BYTES     2048                          // ATtiny1627 internal SRAM
+#define HAL_STORAGE_BYTES  EEPROM_SIZE                   // 256-byte EEPROM
+
+static inline void hal_display_dc(uint8_t data_mode) {
+    if (data_mode) {
+        PORTB.OUTSET = HAL_DISPLAY_DC_bm;
+    } else {
+        PORTB.OUTCLR = HAL_DISPLAY_DC_bm;
+    }
+}
+
+static inline void hal_display_select(uint8_t selected) {
+    if (selected) {
+        PORTC.OUTCLR = HAL_DISPLAY_CS_bm;                                    // Active low
+    } else {
+        PORTC.OUTSET = HAL_DISPLAY_CS_bm;
+    }
+}
+
+// Buffer mode: DREIF means the transmit buffer can take another byte,
+// TXCIF means the buffer and shift register are both empty. TXCIF is cleared
+// after every write so it only reports completion of the latest byte, and it
+// is left set while the bus is idle.
+
+static inline void hal_spi_write(uint8_t byte) {
+    while ((SPI0.INTFLAGS & SPI_DREIF_bm) == 0) {}                           // Wait for free buffer slot
+    SPI0.DATA = byte;
+    SPI0.INTFLAGS = SPI_TXCIF_bm;                                            // Clear stale completion flag
+}
+
+static inline uint8_t hal_spi_idle(void) {
+    return (SPI0.INTFLAGS & SPI_TXCIF_bm) ? 1 : 0;
+}
+
+static inline void hal_spi_set_interrupt(HalSpiInterrupt irq) {
+    switch (irq) {
+        case HAL_SPI_IRQ_DATA_EMPTY:  SPI0.INTCTRL = SPI_DREIE_bm; break;
+        case HAL_SPI_IRQ_TX_COMPLETE: SPI0.INTCTRL = SPI_TXCIE_bm; break;
+        default:                      SPI0.INTCTRL = 0;            break;
+    }
+}
+
+#endif // HAL_ATTINY1627_H
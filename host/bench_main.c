@@ -0,0 +1,104 @@
+/*============================================================================
+ * bench_main.c
+ *============================================================================
+ * Host runner for the rendering micro-benchmark (bench.h)
+ *
+ * Runs every case against the host HAL mock and prints its average time
+ * per run and its buffer CRC next to the golden value. The times use the
+ * mock's counter (wall clock at the target counter rate), so they rank
+ * changes rather than predict the ATtiny1627; build the firmware with
+ * BENCH_MODE for cycle counts. Exits with 1 if any CRC differs.
+ *
+ * --golden prints the CRCs of this build as the GOLDEN_* initializers of
+ * bench.c instead (PANIC_MODE builds print the panic frame table).
+ *
+ * USAGE:
+ *     paddlepanic_bench [--repeats N] [--golden]
+ *==========================================================================*/
+
+#include "hal_host.h"
+#include "bench.h"
+#include "sh1106_graphics.h"
+#include "game_controller.h"
+#include "timer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Microseconds per counter tick (host rate matches the target's)
+#define BENCH_US_PER_COUNT (1000000.0 / HAL_COUNTER_HZ)
+
+static const char* const COLOR_NAMES[] = {"black", "white", "invert"};
+
+/**
+ * Print one golden table, four values per line
+ */
+static void print_table(const char* name, const char* size, const uint32_t* crcs, uint16_t count) {
+    printf("static const uint32_t %s[%s] = {", name, size);
+    for (uint16_t i = 0; i < count; i++) {
+        printf("%s0x%08lXUL%s", (i % 4 == 0) ? "\n    " : " ",
+               (unsigned long)crcs[i], (i + 1 < count) ? "," : "");
+    }
+    printf("\n};\n");
+}
+
+static void usage(const char* program) {
+    fprintf(stderr, "usage: %s [--repeats N] [--golden]\n", program);
+}
+
+int main(int argc, char** argv) {
+    uint16_t repeats = 2000;
+    uint8_t golden = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--repeats") == 0 && i + 1 < argc) {
+            repeats = (uint16_t)strtoul(argv[++i], NULL, 10);
+            if (repeats == 0) repeats = 1;
+        } else if (strcmp(argv[i], "--golden") == 0) {
+            golden = 1;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    // Same start-up as main.c, without the tick timer
+    init_delay();
+    initScreen();
+
+    static GameController game;
+    init_game_controller(&game);
+
+    static uint32_t crcs[BENCH_CASE_COUNT];
+    uint16_t failures = 0;
+
+    for (uint16_t index = 0; index < BENCH_CASE_COUNT; index++) {
+        BenchCase c = bench_case((uint8_t)index);
+        BenchResult result = bench_run(&game, (uint8_t)index, golden ? 1 : repeats);
+        uint32_t expected = bench_golden((uint8_t)index);
+        crcs[index] = result.crc;
+        if (golden) continue;
+
+        if (result.crc != expected) failures++;
+        if (c.kind < BENCH_PRIMITIVE_COUNT) {
+            printf("%3u %-13s %2u %4d,%-4d %-6s", index, bench_kind_name(c.kind), c.size,
+                   c.position.x, c.position.y, COLOR_NAMES[c.color]);
+        } else if (c.kind == BENCH_FRAME_BALL) {
+            printf("%3u %-13s    %4d,%-4d       ", index, bench_kind_name(c.kind),
+                   c.position.x, c.position.y);
+        } else {
+            printf("%3u %-29s", index, bench_kind_name(c.kind));
+        }
+        printf(" %9.2f us  %08lx %s\n", result.counts * BENCH_US_PER_COUNT / repeats,
+               (unsigned long)result.crc, (result.crc == expected) ? "ok" : "MISMATCH");
+    }
+
+    if (golden) {
+        print_table("GOLDEN_PRIMITIVES", "BENCH_PRIMITIVE_CASES", crcs, BENCH_PRIMITIVE_CASES);
+        print_table("GOLDEN_FRAMES", "BENCH_FRAME_CASES", crcs + BENCH_PRIMITIVE_CASES, BENCH_FRAME_CASES);
+        return 0;
+    }
+
+    printf("%u of %u cases differ from the golden CRCs\n", failures, (unsigned)BENCH_CASE_COUNT);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,416 @@
+/*============================================================================
+ * hal_host.c
+ *============================================================================
+ * Host (desktop) mock of the hardware abstraction layer
+ *==========================================================================*/
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "hal_host.h"
+#include "sh1106_graphics.h"
+#include "timer.h"
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+
+/*============================================================================
+ * MOCK STATE
+ *==========================================================================*/
+
+#define HOST_RAM_COLUMNS  132                            // SH1106 column RAM
+#define HOST_PORT_COUNT   3
+#define HOST_ADC_CHANNELS 8
+#define HOST_ERASED       0xFF                           // Erased EEPROM value
+
+static HalHandler spi_handler = NULL;
+static HalHandler tick_handler = NULL;
+static uint8_t tick_enabled = 1;
+static HalAdcHandler adc_handler = NULL;
+static HalPinHandler pin_handler = NULL;
+static const uint8_t* scan_channels = NULL;
+static uint8_t scan_count = 0;
+static HalSpiInterrupt spi_irq = HAL_SPI_IRQ_NONE;
+static uint8_t spi_dispatching = 0;
+static uint32_t spi_byte_count = 0;
+static HalHandler serial_handler = NULL;
+static uint8_t serial_irq = 0;
+static uint32_t serial_baud = 0;
+
+static uint8_t dc_level = 0;
+static uint8_t cs_active = 0;
+static uint8_t reset_level = 1;
+
+// Modeled SH1106 controller
+static uint8_t ram[PAGES][HOST_RAM_COLUMNS];
+static uint8_t ram_page = 0;
+static uint8_t ram_column = 0;
+static uint8_t param_pending = 0;                        // Next command byte is a parameter
+static uint8_t panel_on = 0;
+static uint8_t panel_inverted = 0;
+
+static uint8_t pin_levels[HOST_PORT_COUNT] = {0xFF, 0xFF, 0xFF};  // Pulled up
+static uint8_t pin_change_enabled[HOST_PORT_COUNT] = {0, 0, 0};    // Pins raising pin-change interrupts
+static uint8_t storage[HAL_STORAGE_BYTES];
+static uint8_t storage_erased = 0;                       // storage filled with HOST_ERASED
+
+static uint16_t adc_values[HOST_ADC_CHANNELS] = {
+    2048, 2048, 2048, 2048, 2048, 2048, 2048, 2048      // Joystick centered
+};
+
+/*============================================================================
+ * SH1106 MODEL
+ *==========================================================================*/
+
+/**
+ * Reset the controller state (RES line pulled low)
+ */
+static void display_reset(void) {
+    ram_page = 0;
+    ram_column = 0;
+    param_pending = 0;
+    panel_on = 0;
+    panel_inverted = 0;
+}
+
+/**
+ * Decode one command byte
+ * Only commands that affect what is shown are modeled; two-byte commands
+ * swallow their parameter
+ */
+static void display_command(uint8_t command) {
+    if (param_pending) {
+        param_pending = 0;
+        return;
+    }
+
+    if ((command & 0xF0) == SH1106_SETLOWCOLUMN) {
+        ram_column = (ram_column & 0xF0) | (command & 0x0F);
+    } else if ((command & 0xF0) == SH1106_SETHIGHCOLUMN) {
+        ram_column = (ram_column & 0x0F) | ((command & 0x0F) << 4);
+    } else if ((command & 0xF0) == SH1106_SETPAGE) {
+        ram_page = command & 0x0F;
+    } else {
+        switch (command) {
+            case 0xAE: panel_on = 0; break;
+            case 0xAF: panel_on = 1; break;
+            case GRAYOLED_NORMALDISPLAY: panel_inverted = 0; break;
+            case GRAYOLED_INVERTDISPLAY: panel_inverted = 1; break;
+
+            // Commands followed by one parameter byte
+            case 0x81: case 0xA8: case 0xAD: case 0xD3:
+            case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+                param_pending = 1;
+                break;
+
+            default: break;                                                  // Not modeled
+        }
+    }
+}
+
+/**
+ * Store one data byte at the current address (column auto-increments)
+ */
+static void display_data(uint8_t data) {
+    if (ram_page < PAGES && ram_column < HOST_RAM_COLUMNS) {
+        ram[ram_page][ram_column] = data;
+    }
+    ram_column++;
+}
+
+/*============================================================================
+ * GENERAL
+ *==========================================================================*/
+
+void hal_clock_init(void) {
+    // HAL_COUNTER_HZ already follows F_CPU (hal_counter_read())
+}
+
+void hal_interrupts_enable(void) {
+    // Handlers are invoked directly by the mock
+}
+
+uint8_t hal_interrupts_disable(void) {
+    return 0;                                                                // Handlers never preempt game code
+}
+
+void hal_interrupts_restore(uint8_t state) {
+    (void)state;
+}
+
+void hal_sleep(HalSleepMode mode) {
+    (void)mode;                                                              // Time only advances in hal_host_tick()
+}
+
+/*============================================================================
+ * DISPLAY LINK
+ *==========================================================================*/
+
+void hal_display_init(void) {
+    cs_active = 0;
+}
+
+void hal_display_reset(uint8_t level) {
+    if (!level) display_reset();
+    reset_level = level;
+}
+
+void hal_spi_set_handler(HalHandler handler) {
+    spi_handler = handler;
+}
+
+void hal_display_dc(uint8_t data_mode) {
+    dc_level = data_mode ? 1 : 0;
+}
+
+void hal_display_select(uint8_t selected) {
+    cs_active = selected ? 1 : 0;
+}
+
+void hal_spi_write(uint8_t byte) {
+    if (!cs_active || !reset_level) return;                                  // Controller not listening
+
+    spi_byte_count++;
+    if (dc_level) {
+        display_data(byte);
+    } else {
+        display_command(byte);
+    }
+}
+
+uint8_t hal_spi_idle(void) {
+    return 1;                                                                // Transfers complete instantly
+}
+
+void hal_spi_set_interrupt(HalSpiInterrupt irq) {
+    spi_irq = irq;
+
+    // Both interrupt sources are always ready on the host: keep calling the
+    // handler until it disables them (the handler re-enters here itself)
+    if (spi_dispatching || spi_handler == NULL) return;
+    spi_dispatching = 1;
+    while (spi_irq != HAL_SPI_IRQ_NONE) {
+        spi_handler();
+    }
+    spi_dispatching = 0;
+}
+
+/*============================================================================
+ * GPIO
+ *==========================================================================*/
+
+void hal_pin_input(HalPort port, uint8_t pin_bm, uint8_t pullup) {
+    (void)port;
+    (void)pin_bm;
+    (void)pullup;
+}
+
+uint8_t hal_pin_read(HalPort port, uint8_t pin_bm) {
+    return (pin_levels[port] & pin_bm) ? 1 : 0;
+}
+
+void hal_pin_output(HalPort port, uint8_t pin_bm) {
+    pin_levels[port] &= ~pin_bm;
+}
+
+void hal_pin_toggle(HalPort port, uint8_t pin_bm) {
+    pin_levels[port] ^= pin_bm;
+}
+
+void hal_pin_set_change_handler(HalPinHandler handler) {
+    pin_handler = handler;
+}
+
+void hal_pin_change_enable(HalPort port, uint8_t pin_bm) {
+    pin_change_enabled[port] |= pin_bm;
+}
+
+void hal_host_set_pin(HalPort port, uint8_t pin_bm, uint8_t level) {
+    uint8_t previous = pin_levels[port];
+    if (level) {
+        pin_levels[port] |= pin_bm;
+    } else {
+        pin_levels[port] &= ~pin_bm;
+    }
+
+    // Pin-change interrupt, delivered immediately
+    uint8_t changed = (previous ^ pin_levels[port]) & pin_change_enabled[port];
+    if (changed != 0 && pin_handler != NULL) {
+        pin_handler(port, changed);
+    }
+}
+
+void hal_host_set_button(HalPort port, uint8_t pin_bm, uint8_t pressed) {
+    hal_host_set_pin(port, pin_bm, !pressed);                                // Active low
+}
+
+/*============================================================================
+ * ADC
+ *==========================================================================*/
+
+void hal_adc_init(void) {
+}
+
+uint8_t hal_adc_read(uint8_t channel, uint16_t* result) {
+    if (adc_handler != NULL) return 0;                                       // Scan owns the ADC
+    if (channel < 1 || channel >= HOST_ADC_CHANNELS) return 0;
+    *result = adc_values[channel];
+    return 1;
+}
+
+void hal_adc_start_scan(const uint8_t* channels, uint8_t count, HalAdcHandler handler) {
+    scan_channels = channels;
+    scan_count = count;
+    adc_handler = handler;
+}
+
+/**
+ * Deliver one result per scanned channel (the target completes several
+ * scans per tick; one is enough to publish the current values)
+ */
+static void adc_scan(void) {
+    if (adc_handler == NULL) return;
+    for (uint8_t i = 0; i < scan_count; i++) {
+        uint8_t channel = scan_channels[i];
+        adc_handler(i, (channel < HOST_ADC_CHANNELS) ? adc_values[channel] : 0);
+    }
+}
+
+void hal_host_set_adc(uint8_t channel, uint16_t value) {
+    if (channel < HOST_ADC_CHANNELS) {
+        adc_values[channel] = (value > 4095) ? 4095 : value;
+    }
+}
+
+/*============================================================================
+ * TIMERS
+ *==========================================================================*/
+
+void hal_tick_init(HalHandler handler) {
+    tick_handler = handler;
+}
+
+void hal_tick_enable(uint8_t enabled) {
+    tick_enabled = enabled;
+}
+
+/**
+ * Bytes sent on the serial line during a tick
+ * Defined with the rest of the serial code below
+ */
+static void serial_drain(void);
+
+void hal_host_tick(void) {
+    adc_scan();
+    serial_drain();
+    if (tick_handler != NULL && tick_enabled) {
+        tick_handler();
+    }
+}
+
+void hal_counter_init(void) {
+}
+
+uint16_t hal_counter_read(void) {
+    // Wall-clock time scaled to the target counter rate, so profiler
+    // numbers are in the same units as on the device
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    uint64_t counts = (uint64_t)now.tv_sec * HAL_COUNTER_HZ
+                    + ((uint64_t)now.tv_nsec * HAL_COUNTER_HZ) / 1000000000ULL;
+    return (uint16_t)counts;
+}
+
+/*============================================================================
+ * SERIAL
+ *==========================================================================*/
+
+void hal_serial_init(uint32_t baud) {
+    serial_baud = baud;
+}
+
+void hal_serial_write(uint8_t byte) {
+    fputc(byte, stderr);                                                     // Keep stdout for frame dumps
+}
+
+void hal_serial_set_handler(HalHandler handler) {
+    serial_handler = handler;
+}
+
+void hal_serial_set_interrupt(uint8_t enabled) {
+    serial_irq = enabled;
+}
+
+/**
+ * Deliver the data register empty interrupts of one tick: as many bytes as
+ * the line carries in a tick (8N1, 10 bits per byte)
+ */
+static void serial_drain(void) {
+    uint32_t budget = serial_baud / (10UL * TICK_RATE_HZ);
+    while (serial_irq && serial_handler != NULL && budget > 0) {
+        serial_handler();
+        budget--;
+    }
+}
+
+/*============================================================================
+ * STORAGE
+ *==========================================================================*/
+
+/**
+ * Start from erased storage (like a fresh EEPROM)
+ */
+static void storage_init(void) {
+    if (storage_erased) return;
+    memset(storage, HOST_ERASED, sizeof(storage));
+    storage_erased = 1;
+}
+
+void hal_storage_read(uint16_t offset, uint8_t* data, uint8_t length) {
+    storage_init();
+    memcpy(data, &storage[offset], length);
+}
+
+void hal_storage_write(uint16_t offset, const uint8_t* data, uint8_t length) {
+    storage_init();
+    memcpy(&storage[offset], data, length);
+}
+
+uint8_t hal_host_storage_load(const char* path) {
+    storage_init();
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) return 0;
+    fread(storage, 1, sizeof(storage), file);
+    fclose(file);
+    return 1;
+}
+
+uint8_t hal_host_storage_save(const char* path) {
+    storage_init();
+    FILE* file = fopen(path, "wb");
+    if (file == NULL) return 0;
+    size_t written = fwrite(storage, 1, sizeof(storage), file);
+    fclose(file);
+    return written == sizeof(storage);
+}
+
+/*============================================================================
+ * DISPLAY CAPTURE
+ *==========================================================================*/
+
+uint8_t hal_host_display_pixel(uint8_t x, uint8_t y) {
+    if (x >= WIDTH || y >= HEIGHT) return 0;
+    return (ram[y / 8][x + SH1106_COLUMN_OFFSET] >> (y & 7)) & 1;
+}
+
+uint8_t hal_host_display_on(void) {
+    return panel_on;
+}
+
+uint8_t hal_host_display_inverted(void) {
+    return panel_inverted;
+}
+
+uint32_t hal_host_spi_bytes(void) {
+    return spi_byte_count;
+}
@@ -0,0 +1,116 @@
+/*============================================================================
+ * hal_host.h
+ *============================================================================
+ * Host (desktop) mock of the hardware abstraction layer
+ *
+ * Implements hal.h on a PC so the unchanged game code can run in a
+ * simulator. The mock:
+ * - Models the SH1106 RAM from the captured SPI stream (page/column address
+ *   commands, data bytes, display on/off and invert)
+ * - Runs the SPI interrupt handler synchronously, so an async refresh has
+ *   finished by the time refreshDisplayAsync() returns
+ * - Feeds scripted button levels and ADC values (a background ADC scan
+ *   delivers every channel once per hal_host_tick(), before the tick)
+ * - Runs the pin-change handler as soon as an enabled pin changes level
+ * - Keeps the EEPROM in memory; it can be loaded from and saved to a file
+ * - Writes serial bytes to stderr; interrupt-driven transmission runs at
+ *   the baud rate, one tick's worth of bytes per hal_host_tick()
+ * - Fires tick interrupts only when hal_host_tick() is called, so time is
+ *   fully under control of the simulator (hal_sleep() returns at once)
+ *
+ * USAGE:
+ *     hal_host_set_button(HAL_PORTC, PIN4_bm, 1);        // Press button 1
+ *     hal_host_set_adc(1, 4095);                         // Joystick X full right
+ *     hal_host_tick();                                   // One 64 Hz tick
+ *     uint8_t on = hal_host_display_pixel(10, 20);       // What the panel shows
+ *==========================================================================*/
+
+#ifndef HAL_HOST_H
+#define HAL_HOST_H
+
+#include <stdint.h>
+#include "hal.h"
+
+/*============================================================================
+ * INPUT INJECTION
+ *==========================================================================*/
+
+/**
+ * Set the level of an input pin
+ * @param port Port of the pin
+ * @param pin_bm Pin bitmask
+ * @param level 1 = high, 0 = low
+ */
+void hal_host_set_pin(HalPort port, uint8_t pin_bm, uint8_t level);
+
+/**
+ * Press or release an active-low button (drives the pin low when pressed)
+ * @param port Port of the pin
+ * @param pin_bm Pin bitmask
+ * @param pressed 1 = pressed, 0 = released
+ */
+void hal_host_set_button(HalPort port, uint8_t pin_bm, uint8_t pressed);
+
+/**
+ * Set the value the next conversion on a channel returns
+ * @param channel Analog input (1-7)
+ * @param value 12-bit value (0-4095)
+ */
+void hal_host_set_adc(uint8_t channel, uint16_t value);
+
+/*============================================================================
+ * TIME
+ *==========================================================================*/
+
+/**
+ * Fire one tick interrupt (nothing happens while hal_tick_enable(0))
+ */
+void hal_host_tick(void);
+
+/*============================================================================
+ * STORAGE
+ *==========================================================================*/
+
+/**
+ * Fill the mock storage from a file (a short file leaves the rest erased)
+ * @param path File written by hal_host_storage_save()
+ * @return 1 on success, 0 if the file cannot be read
+ */
+uint8_t hal_host_storage_load(const char* path);
+
+/**
+ * Write the whole mock storage to a file
+ * @param path Destination
+ * @return 1 on success, 0 on error
+ */
+uint8_t hal_host_storage_save(const char* path);
+
+/*============================================================================
+ * DISPLAY CAPTURE
+ *==========================================================================*/
+
+/**
+ * Read a pixel as the panel would show it (RAM column offset applied,
+ * display inversion ignored)
+ * @param x Visible column (0-127)
+ * @param y Row (0-63)
+ * @return 1 if lit, 0 otherwise
+ */
+uint8_t hal_host_display_pixel(uint8_t x, uint8_t y);
+
+/**
+ * Check whether the panel is switched on (0xAF received)
+ */
+uint8_t hal_host_display_on(void);
+
+/**
+ * Check whether the panel is inverted (0xA7 received)
+ */
+uint8_t hal_host_display_inverted(void);
+
+/**
+ * Get the total number of bytes sent over SPI with CS asserted
+ */
+uint32_t hal_host_spi_bytes(void);
+
+#endif // HAL_HOST_H
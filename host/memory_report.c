@@ -0,0 +1,69 @@
+/*============================================================================
+ * memory_report.c
+ *============================================================================
+ * Static RAM report, printed after every host build
+ *
+ * Lists the size of each object type and of every block main.c reserves
+ * statically (display driver, display list in DISPLAY_STRIP builds, pools,
+ * telemetry ring in TELEMETRY_ENABLED builds, game controller), and the total against HAL_SRAM_BYTES. Sizes are those
+ * of the host compiler: pointers and alignment make them larger than on the
+ * ATtiny1627 (XC8: 2-byte pointers, no padding), where main.c asserts the
+ * same total at build time.
+ *
+ * USAGE:
+ *     paddlepanic_memory
+ *==========================================================================*/
+
+#include "game_controller.h"
+#include "sh1106_graphics.h"
+#include "shapes.h"
+#include "io_hardware.h"
+#include <stdio.h>
+
+#define MEMBER_SIZE(type, member) sizeof(((type*)0)->member)
+
+static void line(const char* name, unsigned long bytes) {
+    printf("  %-24s %5lu\n", name, bytes);
+}
+
+int main(void) {
+    printf("Object sizes (bytes, host ABI)\n");
+    line("Shape", sizeof(Shape));
+#ifdef DISPLAY_STRIP
+    line("DisplayCommand", sizeof(DisplayCommand));
+#endif
+    line("CircleSprite", sizeof(CircleSprite));
+    line("PhysicsObject", sizeof(PhysicsObject));
+    line("PhysicsWorld", sizeof(PhysicsWorld));
+    line("InputController", sizeof(InputController));
+    line("GameController", sizeof(GameController));
+
+    printf("GameController\n");
+    line("input_ctrl", MEMBER_SIZE(GameController, input_ctrl));
+    line("walls", MEMBER_SIZE(GameController, walls));
+    line("paddles", MEMBER_SIZE(GameController, paddles));
+    line("balls", MEMBER_SIZE(GameController, balls));
+#ifdef PANIC_MODE
+    line("obstacles", MEMBER_SIZE(GameController, obstacles));
+#endif
+    line("world", MEMBER_SIZE(GameController, world));
+    line("drawn_bounds", MEMBER_SIZE(GameController, drawn_bounds));
+    line("pause menu", MEMBER_SIZE(GameController, pause_bg) + MEMBER_SIZE(GameController, pause_border));
+
+    unsigned long total = GAME_STATIC_RAM_BYTES + GAME_STACK_RESERVE_BYTES;
+    printf("Static RAM\n");
+    line("display driver", DISPLAY_RAM_BYTES);
+#ifdef DISPLAY_STRIP
+    line("display list", DISPLAY_LIST_RAM_BYTES);
+#endif
+    line("shape pool", SHAPE_POOL_BYTES);
+    line("input device pool", INPUT_POOL_BYTES);
+#ifdef TELEMETRY_ENABLED
+    line("telemetry ring", TELEMETRY_RAM_BYTES);
+#endif
+    line("game controller", sizeof(GameController));
+    line("stack reserve", GAME_STACK_RESERVE_BYTES);
+    printf("  %-24s %5lu (target SRAM %d, checked by main.c with target sizes)\n",
+           "total", total, HAL_SRAM_BYTES);
+    return 0;
+}
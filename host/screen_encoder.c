@@ -0,0 +1,181 @@
+/*============================================================================
+ * screen_encoder.c
+ *============================================================================
+ * Generator for screens.c
+ *
+ * Draws every static screen layout with the game's text renderer against
+ * the host HAL mock, reads the result back from the SH1106 model and prints
+ * it run-length encoded (format in sh1106_graphics.h) as C source.
+ *
+ * USAGE:
+ *     paddlepanic_screens > screens.c
+ *==========================================================================*/
+
+#include "hal_host.h"
+#include "sh1106_graphics.h"
+#include "screens.h"
+#include "text.h"
+#include "timer.h"
+#include <stdio.h>
+
+/*============================================================================
+ * SCREEN LAYOUTS
+ *==========================================================================*/
+
+/**
+ * One line of text on a screen
+ */
+typedef struct {
+    uint8_t x;
+    uint8_t y;
+    const char* text;
+    uint8_t scale;
+} ScreenText;
+
+/**
+ * A full-screen image to generate
+ */
+typedef struct {
+    const char* name;                       // Array name in screens.c
+    const ScreenText* lines;
+    uint8_t line_count;
+    uint8_t keeps_score;                    // 1 = the game draws the score on top
+} ScreenLayout;
+
+// Scale 2: each char is 6 pixels wide + 2 spacing = 8 pixels per char
+// Scale 1: each char is 3 pixels wide + 1 spacing = 4 pixels per char
+static const ScreenText TITLE_LINES[] = {
+    {16, 15, "PADDLE PANIC", 2},            // 12 chars = 96 pixels, (128-96)/2 = 16
+    {42, 50, "PRESS START", 1},             // 11 chars = 44 pixels, (128-44)/2 = 42
+};
+
+static const ScreenText GAME_OVER_LINES[] = {
+    {28, 15, "GAME OVER", 2},               // 9 chars = 72 pixels, (128-72)/2 = 28
+    {54, 35, "SCORE", 1},                   // 5 chars = 20 pixels, (128-20)/2 = 54
+};
+
+static const ScreenLayout LAYOUTS[] = {
+    {"TITLE_SCREEN", TITLE_LINES, sizeof(TITLE_LINES) / sizeof(TITLE_LINES[0]), 0},
+    {"GAME_OVER_SCREEN", GAME_OVER_LINES, sizeof(GAME_OVER_LINES) / sizeof(GAME_OVER_LINES[0]), 1},
+};
+
+// Widest score: 5 digits
+#define SCORE_WIDTH  (5 * DIGIT_WIDTH * GAME_OVER_SCORE_SCALE + 4 * DIGIT_SPACING * GAME_OVER_SCORE_SCALE)
+#define SCORE_HEIGHT (DIGIT_HEIGHT * GAME_OVER_SCORE_SCALE)
+
+/*============================================================================
+ * ENCODING
+ *==========================================================================*/
+
+static uint8_t image[PAGES][WIDTH];
+
+/**
+ * Read the panel model back in buffer byte order
+ */
+static void capture_panel(void) {
+    for (uint8_t page = 0; page < PAGES; page++) {
+        for (uint8_t col = 0; col < WIDTH; col++) {
+            uint8_t byte = 0;
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                if (hal_host_display_pixel(col, page * 8 + bit)) byte |= 1 << bit;
+            }
+            image[page][col] = byte;
+        }
+    }
+}
+
+/**
+ * Check that the 8-column blocks under the score carry no ink
+ */
+static int score_area_blank(void) {
+    uint8_t first_col = GAME_OVER_SCORE_X & ~7;
+    uint8_t end_col = (GAME_OVER_SCORE_X + SCORE_WIDTH + 7) & ~7;
+    for (uint8_t page = GAME_OVER_SCORE_Y / 8; page <= (GAME_OVER_SCORE_Y + SCORE_HEIGHT - 1) / 8; page++) {
+        for (uint8_t col = first_col; col < end_col; col++) {
+            if (image[page][col] != 0) return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Length of the run of equal bytes starting at col (at most SCREEN_RUN_MAX)
+ */
+static int repeat_length(const uint8_t* row, int col) {
+    int length = 1;
+    while (col + length < WIDTH && length < SCREEN_RUN_MAX && row[col + length] == row[col]) length++;
+    return length;
+}
+
+static int emitted = 0;
+
+static void emit(uint8_t byte) {
+    printf("%s0x%02X,", (emitted % 16 == 0) ? "\n    " : " ", byte);
+    emitted++;
+}
+
+/**
+ * Print one page: repeats of 3 bytes or more, literals in between
+ */
+static void encode_page(const uint8_t* row) {
+    int col = 0;
+    while (col < WIDTH) {
+        int repeat = repeat_length(row, col);
+        if (repeat >= 3) {
+            emit(SCREEN_RUN_REPEAT | (repeat - 1));
+            emit(row[col]);
+            col += repeat;
+            continue;
+        }
+
+        int end = col;
+        while (end < WIDTH && end - col < SCREEN_RUN_MAX && repeat_length(row, end) < 3) end++;
+        emit((uint8_t)(end - col - 1));
+        for (int i = col; i < end; i++) emit(row[i]);
+        col = end;
+    }
+}
+
+/*============================================================================
+ * MAIN
+ *==========================================================================*/
+
+int main(void) {
+    init_delay();
+    initScreen();
+
+    printf("/*============================================================================\n"
+           " * screens.c\n"
+           " *============================================================================\n"
+           " * Static full-screen images (see screens.h)\n"
+           " * Generated by host/screen_encoder.c - do not edit\n"
+           " *==========================================================================*/\n"
+           "\n"
+           "#include \"screens.h\"\n");
+
+    for (size_t i = 0; i < sizeof(LAYOUTS) / sizeof(LAYOUTS[0]); i++) {
+        const ScreenLayout* layout = &LAYOUTS[i];
+
+        clearDisplay();
+        for (uint8_t line = 0; line < layout->line_count; line++) {
+            const ScreenText* text = &layout->lines[line];
+            drawText(text->x, text->y, text->text, COLOR_WHITE, text->scale);
+        }
+        refreshDisplay();
+        capture_panel();
+
+        if (layout->keeps_score && !score_area_blank()) {
+            fprintf(stderr, "%s: image overlaps the score\n", layout->name);
+            return 1;
+        }
+
+        emitted = 0;
+        printf("\nconst uint8_t %s[] = {", layout->name);
+        for (uint8_t page = 0; page < PAGES; page++) {
+            encode_page(image[page]);
+        }
+        printf("\n};\n");
+        fprintf(stderr, "%s: %d bytes\n", layout->name, emitted);
+    }
+    return 0;
+}
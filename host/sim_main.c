@@ -0,0 +1,337 @@
+/*============================================================================
+ * sim_main.c
+ *============================================================================
+ * Desktop simulator for PaddlePanic
+ *
+ * Runs the unchanged game code against the host HAL mock: one simulated
+ * 64 Hz tick per loop pass, inputs from a script, and the SH1106 RAM model
+ * dumped as ASCII art or PBM images.
+ *
+ * Script format (one event per line, '#' starts a comment):
+ *     <tick> <button1> <button2> <joystick_x> <joystick_y>
+ * Buttons are 0/1 (1 = pressed), joystick axes are raw 12-bit ADC values.
+ * Each line takes effect at its tick and holds until the next line.
+ *
+ * Recording and replay (replay.h): --record saves the inputs the game saw
+ * (and its random seeds) to FILE, --replay plays such a file back instead
+ * of the script. --checksums prints a CRC-32 of the panel after every
+ * tick, so two builds replaying the same file can be compared line by line.
+ *
+ * USAGE:
+ *     paddlepanic_sim [--ticks N] [--script FILE] [--dump-every N]
+ *                     [--pbm PREFIX] [--record FILE | --replay FILE]
+ *                     [--checksums]
+ *==========================================================================*/
+
+#include "hal_host.h"
+#include "sh1106_graphics.h"
+#include "game_controller.h"
+#include "timer.h"
+#include "power.h"
+#include "profiler.h"
+#include "latency.h"
+#include "telemetry.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*============================================================================
+ * INPUT SCRIPT
+ *==========================================================================*/
+
+#define SIM_MAX_EVENTS 1024
+
+typedef struct {
+    uint32_t tick;
+    uint8_t button1;
+    uint8_t button2;
+    uint16_t joystick_x;
+    uint16_t joystick_y;
+} SimEvent;
+
+// Built-in script: start, launch, then sweep the paddles up and down
+static const SimEvent DEFAULT_SCRIPT[] = {
+    {  32, 1, 0, 2048, 2048},   // Title → ball at rest
+    {  36, 0, 0, 2048, 2048},
+    {  64, 1, 0, 2048, 2048},   // Launch
+    {  68, 0, 0, 2048, 2048},
+    { 128, 0, 0, 2048,    0},   // Paddles up
+    { 256, 0, 0, 2048, 4095},   // Paddles down
+    { 384, 0, 1, 2048,    0},   // Boosted up
+    { 512, 0, 0, 2048, 2048},
+};
+
+static SimEvent events[SIM_MAX_EVENTS];
+static uint16_t event_count = 0;
+
+/**
+ * Load a script file into events
+ * @return 1 on success, 0 on error
+ */
+static uint8_t load_script(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        fprintf(stderr, "cannot open script '%s'\n", path);
+        return 0;
+    }
+
+    char line[128];
+    uint16_t line_number = 0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        line_number++;
+        char* comment = strchr(line, '#');
+        if (comment != NULL) *comment = '\0';
+
+        unsigned long tick;
+        unsigned int b1, b2, x, y;
+        int fields = sscanf(line, "%lu %u %u %u %u", &tick, &b1, &b2, &x, &y);
+        if (fields <= 0) continue;                                           // Blank line
+        if (fields != 5 || event_count == SIM_MAX_EVENTS) {
+            fprintf(stderr, "%s:%u: expected '<tick> <b1> <b2> <x> <y>'\n", path, line_number);
+            fclose(file);
+            return 0;
+        }
+        events[event_count++] = (SimEvent){(uint32_t)tick, b1 != 0, b2 != 0,
+                                           (uint16_t)x, (uint16_t)y};
+    }
+
+    fclose(file);
+    return 1;
+}
+
+/**
+ * Drive the mock inputs from an event (pins per input_controller.h)
+ */
+static void apply_event(const SimEvent* event) {
+    hal_host_set_button(HAL_PORTC, PIN4_bm, event->button1);
+    hal_host_set_button(HAL_PORTC, PIN5_bm, event->button2);
+    hal_host_set_adc(1, event->joystick_x);
+    hal_host_set_adc(2, event->joystick_y);
+}
+
+/*============================================================================
+ * FRAME OUTPUT
+ *==========================================================================*/
+
+/**
+ * Print the panel contents as ASCII art ('#' = lit)
+ */
+static void dump_ascii(uint32_t tick) {
+    printf("tick %lu%s%s\n", (unsigned long)tick,
+           hal_host_display_inverted() ? " (inverted)" : "",
+           hal_host_display_on() ? "" : " (off)");
+    for (uint8_t y = 0; y < HEIGHT; y++) {
+        char row[WIDTH + 1];
+        for (uint8_t x = 0; x < WIDTH; x++) {
+            row[x] = hal_host_display_pixel(x, y) ? '#' : '.';
+        }
+        row[WIDTH] = '\0';
+        puts(row);
+    }
+}
+
+/**
+ * Write the panel contents as a plain PBM image (<prefix><tick>.pbm)
+ */
+static void dump_pbm(const char* prefix, uint32_t tick) {
+    char path[256];
+    snprintf(path, sizeof(path), "%s%06lu.pbm", prefix, (unsigned long)tick);
+    FILE* file = fopen(path, "w");
+    if (file == NULL) {
+        fprintf(stderr, "cannot write '%s'\n", path);
+        return;
+    }
+
+    fprintf(file, "P1\n%d %d\n", WIDTH, HEIGHT);
+    for (uint8_t y = 0; y < HEIGHT; y++) {
+        for (uint8_t x = 0; x < WIDTH; x++) {
+            fputc(hal_host_display_pixel(x, y) ? '1' : '0', file);
+        }
+        fputc('\n', file);
+    }
+    fclose(file);
+}
+
+/**
+ * CRC-32 (IEEE) of the panel contents, one bit per pixel in row order
+ */
+static uint32_t panel_crc(void) {
+    uint32_t crc = 0xFFFFFFFFUL;
+    for (uint8_t y = 0; y < HEIGHT; y++) {
+        for (uint8_t x = 0; x < WIDTH; x += 8) {
+            uint8_t byte = 0;
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                byte = (uint8_t)((byte << 1) | hal_host_display_pixel(x + bit, y));
+            }
+            crc ^= byte;
+            for (uint8_t i = 0; i < 8; i++) {
+                crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1)));
+            }
+        }
+    }
+    return ~crc;
+}
+
+/*============================================================================
+ * MAIN
+ *==========================================================================*/
+
+static void usage(const char* program) {
+    fprintf(stderr, "usage: %s [--ticks N] [--script FILE] [--dump-every N] [--pbm PREFIX]\n"
+                    "       [--record FILE | --replay FILE] [--checksums]\n", program);
+}
+
+int main(int argc, char** argv) {
+    uint32_t total_ticks = 1024;
+    uint32_t dump_every = 0;
+    const char* pbm_prefix = NULL;
+    const char* record_path = NULL;
+    const char* replay_path = NULL;
+    uint8_t checksums = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            total_ticks = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+            if (!load_script(argv[++i])) return 1;
+        } else if (strcmp(argv[i], "--dump-every") == 0 && i + 1 < argc) {
+            dump_every = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--pbm") == 0 && i + 1 < argc) {
+            pbm_prefix = argv[++i];
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            record_path = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replay_path = argv[++i];
+        } else if (strcmp(argv[i], "--checksums") == 0) {
+            checksums = 1;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (event_count == 0) {
+        event_count = sizeof(DEFAULT_SCRIPT) / sizeof(DEFAULT_SCRIPT[0]);
+        memcpy(events, DEFAULT_SCRIPT, sizeof(DEFAULT_SCRIPT));
+    }
+
+    // Same start-up order as main.c
+    init_delay();
+    beginScreenInit();
+
+    static GameController game;
+    init_game_controller(&game);
+
+    // Sessions are recorded and replayed from the first update
+    if (record_path != NULL) {
+        input_controller_start_recording(&game.input_ctrl);
+    } else if (replay_path != NULL) {
+        if (!hal_host_storage_load(replay_path) || !input_controller_start_replay(&game.input_ctrl)) {
+            fprintf(stderr, "cannot replay '%s'\n", replay_path);
+            return 1;
+        }
+    }
+
+    endScreenInit();
+
+    init_timer();
+    init_power();
+#ifdef PROFILER_ENABLED
+    init_profiler();
+#endif
+#ifdef LATENCY_TEST
+    init_latency();
+#endif
+#ifdef TELEMETRY_ENABLED
+    init_telemetry();
+#endif
+    hal_interrupts_enable();
+
+    uint16_t next_tick = timer_ticks();
+    uint16_t next_event = 0;
+    uint32_t frames = 0;
+#ifdef PROFILER_ENABLED
+    uint8_t overlay_shown = 0;
+#endif
+
+    for (uint32_t tick = 0; tick < total_ticks; tick++) {
+        while (next_event < event_count && events[next_event].tick <= tick) {
+            apply_event(&events[next_event++]);
+        }
+
+        hal_host_tick();
+
+        // Loop body of main.c: every elapsed tick, then one frame
+        PROFILE_BEGIN(PROFILE_FRAME);
+        uint8_t ticks_run = 0;
+        while (timer_tick_elapsed(next_tick)) {
+            update_game_controller(&game);
+            power_tick(game_controller_idle(&game));
+            next_tick++;
+            if (ticks_run < 255) ticks_run++;
+        }
+        PROFILE_TICKS_RUN(ticks_run);
+
+        PROFILE_BEGIN(PROFILE_DRAW);
+#ifdef PROFILER_ENABLED
+        // The overlay covers the retained frame: redraw fully when it comes or goes
+        if (profiler_overlay_visible() != overlay_shown) {
+            overlay_shown = profiler_overlay_visible();
+            invalidate_game_display(&game);
+        }
+#endif
+        draw_game_controller(&game);                                         // Erases and redraws moved items only
+#ifdef PROFILER_ENABLED
+        if (overlay_shown) profiler_draw_overlay();
+#endif
+        LATENCY_DRAW_MARKER();                                               // Latency test: flip the marker
+        PROFILE_END(PROFILE_DRAW);
+
+        PROFILE_BEGIN(PROFILE_REFRESH);
+        if (displayChanged()) {
+            refreshDisplayAsync();                                           // Completes synchronously on host
+        }
+        PROFILE_END(PROFILE_REFRESH);
+
+        PROFILE_END(PROFILE_FRAME);
+        PROFILE_FRAME_DONE();
+        frames++;
+        timer_mark_boot_done();                                              // First frame is on the panel
+
+        // Returns at once on host; wakes the display after a button press
+        power_sleep();
+
+        if (checksums) {
+            printf("tick %lu crc %08lx\n", (unsigned long)(tick + 1), (unsigned long)panel_crc());
+        }
+        if (dump_every != 0 && (tick + 1) % dump_every == 0) {
+            dump_ascii(tick + 1);
+            if (pbm_prefix != NULL) dump_pbm(pbm_prefix, tick + 1);
+        }
+    }
+
+    if (dump_every == 0) {
+        dump_ascii(total_ticks);
+        if (pbm_prefix != NULL) dump_pbm(pbm_prefix, total_ticks);
+    }
+
+    printf("ticks %lu, frames %lu, spi bytes %lu, score %u\n",
+           (unsigned long)total_ticks, (unsigned long)frames,
+           (unsigned long)hal_host_spi_bytes(), game.score);
+#ifdef PROFILER_ENABLED
+    // Soak result (attract.h): worst frame and late ticks of the whole run
+    printf("worst frame %u us, deadline misses %lu\n",
+           profiler_get_worst_frame_us(), (unsigned long)profiler_get_total_misses());
+#endif
+
+    if (record_path != NULL) {
+        input_controller_stop_replay(&game.input_ctrl);
+        if (!hal_host_storage_save(record_path)) {
+            fprintf(stderr, "cannot write '%s'\n", record_path);
+            return 1;
+        }
+    }
+
+    destroy_game_controller(&game);
+    return 0;
+}
@@ -0,0 +1,235 @@
+/*============================================================================
+ * telemetry_decode.c
+ *============================================================================
+ * Decoder for the binary telemetry stream (telemetry.h)
+ *
+ * Reads a captured stream, from a file or stdin, and prints one line per
+ * record. Positions and velocities are shown in pixels (and pixels per
+ * physics step), profiler times in µs:
+ *     S seq tick state score pv=x,y paddles=x,y ... b0=x,y v=x,y ...
+ *     C seq tick ball target n=x,y t=time at=x,y v=x,y
+ *     P seq I=min/avg/max P=... C=... D=... R=... F=... M=misses
+ * The stream is resynchronised on the sync byte: bytes before a valid
+ * record are skipped and records with a bad check byte are rejected.
+ * Sequence gaps (records the device dropped, or bytes lost on the line)
+ * are counted; a summary ends the output.
+ *
+ * USAGE:
+ *     paddlepanic_telemetry capture.bin
+ *     paddlepanic_sim 2>&1 >/dev/null | paddlepanic_telemetry   # Host build
+ *==========================================================================*/
+
+#include "telemetry.h"
+#include <stdio.h>
+#include <string.h>
+
+/*============================================================================
+ * INPUT BUFFER
+ *==========================================================================*/
+
+#define DECODE_MAX_RECORD (TELEMETRY_OVERHEAD + 255)
+
+static FILE* input;
+static uint8_t buffer[4 * DECODE_MAX_RECORD];
+static size_t start = 0;                                // First unparsed byte
+static size_t end = 0;                                  // One past the last byte read
+
+/**
+ * Make at least count unparsed bytes available
+ * @return 1 if they are, 0 at the end of the input
+ */
+static int available(size_t count) {
+    if (end - start >= count) return 1;
+
+    memmove(buffer, buffer + start, end - start);
+    end -= start;
+    start = 0;
+    while (end < count) {
+        size_t got = fread(buffer + end, 1, sizeof(buffer) - end, input);
+        if (got == 0) return 0;
+        end += got;
+    }
+    return 1;
+}
+
+/*============================================================================
+ * FIELD READERS
+ *==========================================================================*/
+
+static const uint8_t* field;                            // Next payload byte
+
+static uint8_t read8(void) {
+    return *field++;
+}
+
+static uint16_t read16(void) {
+    uint16_t value = field[0] | (uint16_t)(field[1] << 8);
+    field += 2;
+    return value;
+}
+
+/**
+ * Q8.8 value in pixels
+ */
+static double fixed(uint16_t value, int is_signed) {
+    return (is_signed ? (double)(int16_t)value : (double)value) / FIXED_ONE;
+}
+
+static void print_motion(void) {
+    double x = fixed(read16(), 0);
+    double y = fixed(read16(), 0);
+    double vx = fixed(read16(), 1);
+    double vy = fixed(read16(), 1);
+    printf("%.2f,%.2f v=%.2f,%.2f", x, y, vx, vy);
+}
+
+/*============================================================================
+ * RECORD DECODERS
+ *==========================================================================*/
+
+static const char* const STATE_NAMES[] = {
+    "TITLE", "BALL_AT_REST", "BALL_MOVING", "PAUSED", "COUNTDOWN", "GAME_OVER"
+};
+
+static const char TARGET_LETTERS[] = {'W', 'P', 'O', 'B'};  // TelemetryTarget
+
+static const char PHASE_LETTERS[PROFILE_PHASE_COUNT] = {'I', 'P', 'C', 'D', 'R', 'F'};
+
+static void decode_state(uint8_t length) {
+    uint16_t tick = read16();
+    uint8_t state = read8();
+    uint16_t score = read16();
+    int8_t velocity_x = (int8_t)read8();
+    int8_t velocity_y = (int8_t)read8();
+    printf("%u %s %u pv=%d,%d paddles=", tick,
+           (state < sizeof(STATE_NAMES) / sizeof(STATE_NAMES[0])) ? STATE_NAMES[state] : "?",
+           score, velocity_x, velocity_y);
+    for (int i = 0; i < 4; i++) {
+        uint8_t x = read8();
+        uint8_t y = read8();
+        printf("%s%u,%u", (i == 0) ? "" : " ", x, y);
+    }
+
+    uint8_t balls = read8();
+    if (length != TELEMETRY_STATE_BYTES(balls)) {
+        printf(" (bad length)");
+        return;
+    }
+    for (uint8_t i = 0; i < balls; i++) {
+        printf(" b%u=", i);
+        print_motion();
+    }
+}
+
+static void decode_collision(void) {
+    uint16_t tick = read16();
+    uint8_t ball = read8();
+    uint8_t target = read8();
+    int8_t normal_x = (int8_t)read8();
+    int8_t normal_y = (int8_t)read8();
+    uint16_t time = read16();
+    printf("%u %u %c%u n=%d,%d t=%.2f at=", tick, ball,
+           ((target >> 4) < sizeof(TARGET_LETTERS)) ? TARGET_LETTERS[target >> 4] : '?',
+           target & 0x0F, normal_x, normal_y, (double)time / FIXED_ONE);
+    print_motion();
+}
+
+static void decode_profile(void) {
+    for (int i = 0; i < PROFILE_PHASE_COUNT; i++) {
+        uint16_t min = read16();
+        uint16_t avg = read16();
+        uint16_t max = read16();
+        printf("%s%c=%u/%u/%u", (i == 0) ? "" : " ", PHASE_LETTERS[i], min, avg, max);
+    }
+    printf(" M=%u", read16());
+}
+
+/**
+ * Print one record (header and check byte already verified)
+ * @return 1 if its type and length are known, 0 otherwise
+ */
+static int decode_record(const uint8_t* record) {
+    uint8_t seq = record[1];
+    uint8_t type = record[2];
+    uint8_t length = record[3];
+    field = record + TELEMETRY_HEADER;
+
+    switch (type) {
+    case TELEMETRY_RECORD_STATE:
+        if (length < TELEMETRY_STATE_BYTES(0)) return 0;
+        printf("S %u ", seq);
+        decode_state(length);
+        break;
+    case TELEMETRY_RECORD_COLLISION:
+        if (length != TELEMETRY_COLLISION_BYTES) return 0;
+        printf("C %u ", seq);
+        decode_collision();
+        break;
+    case TELEMETRY_RECORD_PROFILE:
+        if (length != TELEMETRY_PROFILE_BYTES) return 0;
+        printf("P %u ", seq);
+        decode_profile();
+        break;
+    default:
+        return 0;
+    }
+    printf("\n");
+    return 1;
+}
+
+/*============================================================================
+ * MAIN
+ *==========================================================================*/
+
+int main(int argc, char** argv) {
+    if (argc > 2) {
+        fprintf(stderr, "usage: %s [FILE]\n", argv[0]);
+        return 1;
+    }
+    input = (argc == 2) ? fopen(argv[1], "rb") : stdin;
+    if (input == NULL) {
+        fprintf(stderr, "cannot open '%s'\n", argv[1]);
+        return 1;
+    }
+
+    unsigned long records = 0;
+    unsigned long lost = 0;
+    unsigned long rejected = 0;
+    unsigned long skipped = 0;
+    int have_seq = 0;
+    uint8_t next_seq = 0;
+
+    while (available(TELEMETRY_HEADER)) {
+        const uint8_t* record = buffer + start;
+        if (record[0] != TELEMETRY_SYNC) {
+            start++;
+            skipped++;
+            continue;
+        }
+
+        size_t size = TELEMETRY_OVERHEAD + record[3];
+        if (!available(size)) break;                    // Cut off at the end of the capture
+        record = buffer + start;
+
+        uint8_t sum = 0;
+        for (size_t i = 1; i < size; i++) {
+            sum += record[i];
+        }
+        if (sum != 0 || !decode_record(record)) {
+            start++;                                    // Not a record: look for the next sync
+            rejected++;
+            continue;
+        }
+
+        if (have_seq) lost += (uint8_t)(record[1] - next_seq);
+        next_seq = (uint8_t)(record[1] + 1);
+        have_seq = 1;
+        records++;
+        start += size;
+    }
+
+    printf("records %lu, lost %lu, rejected %lu, skipped bytes %lu\n",
+           records, lost, rejected, skipped + (unsigned long)(end - start));
+    if (input != stdin) fclose(input);
+    return 0;
+}
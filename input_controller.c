@@ -5,8 +5,12 @@
  *==========================================================================*/
 
 #include "input_controller.h"
+#include "timer.h"
 #include <stddef.h>
 
+// Joystick axes sampled in the background (ADC channels 1 and 2)
+static const uint8_t JOYSTICK_CHANNELS[] = {1, 2};
+
 /*============================================================================
  * INPUT CONTROLLER INITIALIZATION
  *==========================================================================*/
@@ -15,14 +19,18 @@ void init_input_controller(InputController* ctrl) {
     if (ctrl == NULL) return;
 
     // Initialize ADC peripheral (must be called before creating analog devices)
+    // and keep both joystick axes sampled from the ADC interrupt
     init_adc();
+    start_adc_sampling(JOYSTICK_CHANNELS, 2);
 
     // Create button devices
     // Button 1 (onboard): active-low with pull-up
     // Button 2 (joystick): active-low with pull-up
     // Callbacks set to NULL - using polling approach
-    ctrl->button1 = create_button(&PORTC, PIN4_bm, 1, NULL, NULL);  // Active-low
-    ctrl->button2 = create_button(&PORTC, PIN5_bm, 1, NULL, NULL);  // Active-low
+    ctrl->button1 = create_button(HAL_PORTC, PIN4_bm, 1, NULL, NULL);  // Active-low
+    ctrl->button2 = create_button(HAL_PORTC, PIN5_bm, 1, NULL, NULL);  // Active-low
+    enable_button_interrupt(ctrl->button1);
+    enable_button_interrupt(ctrl->button2);
 
     // Create analog devices (joystick axes)
     // Threshold set to ANALOG_THRESHOLD (10 for hardware filtering)
@@ -33,8 +41,12 @@ void init_input_controller(InputController* ctrl) {
     // Initialize state to default values
     ctrl->button1_pressed = 0;
     ctrl->button2_pressed = 0;
+    ctrl->button1_clicked = 0;
+    ctrl->button1_press_tick = 0;
     ctrl->joystick_x_raw = 2048;  // Center
     ctrl->joystick_y_raw = 2048;  // Center
+
+    ctrl->replay.mode = REPLAY_OFF;
 }
 
 void destroy_input_controller(InputController* ctrl) {
@@ -60,6 +72,17 @@ void update_input_controller(InputController* ctrl) {
     poll_input(ctrl->joystick_x);
     poll_input(ctrl->joystick_y);
 
+    // Apply queued button edges in order; a tap between updates still
+    // shows up as a press even though the button is released again
+    ButtonEvent event;
+    ctrl->button1_clicked = 0;
+    while (dispatch_button_event(&event)) {
+        if (event.device == ctrl->button1 && event.state == BUTTON_PRESSED) {
+            ctrl->button1_clicked = 1;
+            ctrl->button1_press_tick = event.tick;
+        }
+    }
+
     // Update button states (direct copy - already 0 or 1)
     ctrl->button1_pressed = (uint8_t)get_input_value(ctrl->button1);
     ctrl->button2_pressed = (uint8_t)get_input_value(ctrl->button2);
@@ -67,6 +90,24 @@ void update_input_controller(InputController* ctrl) {
     // Store raw joystick values (no processing)
     ctrl->joystick_x_raw = get_input_value(ctrl->joystick_x);
     ctrl->joystick_y_raw = get_input_value(ctrl->joystick_y);
+
+    ReplayFrame frame;
+    if (ctrl->replay.mode == REPLAY_PLAYING && replay_next_frame(&ctrl->replay, &frame)) {
+        // Recorded state replaces the hardware
+        ctrl->button1_pressed = (frame.buttons & REPLAY_BUTTON1) ? 1 : 0;
+        ctrl->button2_pressed = (frame.buttons & REPLAY_BUTTON2) ? 1 : 0;
+        ctrl->button1_clicked = (frame.buttons & REPLAY_CLICK1) ? 1 : 0;
+        if (ctrl->button1_clicked) ctrl->button1_press_tick = timer_ticks();
+        ctrl->joystick_x_raw = frame.joystick_x;
+        ctrl->joystick_y_raw = frame.joystick_y;
+    } else if (ctrl->replay.mode == REPLAY_RECORDING) {
+        frame.buttons = (ctrl->button1_pressed ? REPLAY_BUTTON1 : 0) |
+                        (ctrl->button2_pressed ? REPLAY_BUTTON2 : 0) |
+                        (ctrl->button1_clicked ? REPLAY_CLICK1 : 0);
+        frame.joystick_x = ctrl->joystick_x_raw;
+        frame.joystick_y = ctrl->joystick_y_raw;
+        replay_record_frame(&ctrl->replay, &frame);
+    }
 }
 
 /*============================================================================
@@ -77,10 +118,26 @@ uint8_t input_controller_button1_pressed(InputController* ctrl) {
     return (ctrl != NULL) ? ctrl->button1_pressed : 0;
 }
 
+uint8_t input_controller_button1_clicked(InputController* ctrl) {
+    return (ctrl != NULL) ? ctrl->button1_clicked : 0;
+}
+
 uint8_t input_controller_button2_pressed(InputController* ctrl) {
     return (ctrl != NULL) ? ctrl->button2_pressed : 0;
 }
 
+uint16_t input_controller_random_seed(InputController* ctrl) {
+    if (ctrl == NULL) return 0;
+
+    uint16_t seed = ctrl->joystick_x_raw;                                    // ADC noise
+    if (ctrl->replay.mode == REPLAY_PLAYING) {
+        replay_next_seed(&ctrl->replay, &seed);
+    } else if (ctrl->replay.mode == REPLAY_RECORDING) {
+        replay_record_seed(&ctrl->replay, seed);
+    }
+    return seed;
+}
+
 uint16_t input_controller_joystick_x(InputController* ctrl) {
     return (ctrl != NULL) ? ctrl->joystick_x_raw : 2048;
 }
@@ -88,3 +145,22 @@ uint16_t input_controller_joystick_x(InputController* ctrl) {
 uint16_t input_controller_joystick_y(InputController* ctrl) {
     return (ctrl != NULL) ? ctrl->joystick_y_raw : 2048;
 }
+
+/*============================================================================
+ * RECORDING AND REPLAY
+ *==========================================================================*/
+
+void input_controller_start_recording(InputController* ctrl) {
+    if (ctrl == NULL) return;
+    replay_start_recording(&ctrl->replay);
+}
+
+uint8_t input_controller_start_replay(InputController* ctrl) {
+    if (ctrl == NULL) return 0;
+    return replay_start_playback(&ctrl->replay);
+}
+
+void input_controller_stop_replay(InputController* ctrl) {
+    if (ctrl == NULL) return;
+    replay_stop(&ctrl->replay);
+}
@@ -25,10 +25,18 @@
  *
  *     // Read raw inputs
  *     if (input_controller_button1_pressed(&ctrl)) {
- *         // Button 1 pressed
+ *         // Button 1 held
+ *     }
+ *     if (input_controller_button1_clicked(&ctrl)) {
+ *         // Button 1 pressed since the last update (never missed)
  *     }
  *
  *     uint16_t raw_x = input_controller_joystick_x(&ctrl);  // 0-4095
+ *     uint16_t seed = input_controller_random_seed(&ctrl);  // Randomness
+ *
+ *     // Deterministic sessions (before the first update)
+ *     input_controller_start_recording(&ctrl);   // Log every update
+ *     input_controller_start_replay(&ctrl);      // Or: play the log back
  *
  *     // Cleanup
  *     destroy_input_controller(&ctrl);
@@ -39,6 +47,7 @@
 
 #include <stdint.h>
 #include "io_hardware.h"
+#include "replay.h"
 
 /*============================================================================
  * INPUT CONTROLLER STRUCTURE
@@ -58,8 +67,13 @@ typedef struct {
     // Raw hardware state (no processing)
     uint8_t button1_pressed;    // 1 if pressed, 0 if released
     uint8_t button2_pressed;    // 1 if pressed, 0 if released
+    uint8_t button1_clicked;    // 1 if pressed since the previous update
+    uint16_t button1_press_tick; // Tick of the latest button 1 press
     uint16_t joystick_x_raw;    // Raw ADC: 0-4095
     uint16_t joystick_y_raw;    // Raw ADC: 0-4095
+
+    // Recording / replay of the state above (replay.h)
+    ReplayStream replay;
 } InputController;
 
 /*============================================================================
@@ -77,7 +91,8 @@ typedef struct {
  *
  * Initializes ADC peripheral and creates all InputDevices with:
  * - Threshold: 10 for analog inputs (hardware filtering only)
- * - Callbacks: NULL (polling-based, not using callbacks)
+ * - Buttons: edges recorded from pin-change interrupts
+ * - Callbacks: NULL (state read through the accessors)
  *
  * @param ctrl Pointer to input controller to initialize
  */
@@ -99,7 +114,10 @@ void destroy_input_controller(InputController* ctrl);
  *
  * This function:
  * - Polls all input devices (reads hardware)
+ * - Drains the button event queue (fires button callbacks)
  * - Stores raw values (no normalization or deadzone)
+ * - When replaying, takes the values from the recording instead (hardware
+ *   is still polled so no events pile up); when recording, logs them
  *
  * @param ctrl Pointer to input controller
  */
@@ -112,6 +130,14 @@ void update_input_controller(InputController* ctrl);
  */
 uint8_t input_controller_button1_pressed(InputController* ctrl);
 
+/**
+ * Check for a button 1 press since the previous update
+ * Taps shorter than an update are still reported
+ * @param ctrl Pointer to input controller
+ * @return 1 if pressed since the previous update, 0 otherwise
+ */
+uint8_t input_controller_button1_clicked(InputController* ctrl);
+
 /**
  * Get button 2 state
  * @param ctrl Pointer to input controller
@@ -133,4 +159,38 @@ uint16_t input_controller_joystick_x(InputController* ctrl);
  */
 uint16_t input_controller_joystick_y(InputController* ctrl);
 
+/**
+ * Get a random seed (the only source of randomness of the game)
+ * Live: the joystick X reading (ADC noise); recorded and replayed with the
+ * inputs so replays are exact
+ * @param ctrl Pointer to input controller
+ * @return Seed value
+ */
+uint16_t input_controller_random_seed(InputController* ctrl);
+
+/*============================================================================
+ * RECORDING AND REPLAY
+ *==========================================================================*/
+
+/**
+ * Record the state of every following update to storage
+ * Start before the first update to replay a session from boot
+ * @param ctrl Pointer to input controller
+ */
+void input_controller_start_recording(InputController* ctrl);
+
+/**
+ * Take the state of every following update from the recording in storage
+ * Falls back to the hardware when the recording ends
+ * @param ctrl Pointer to input controller
+ * @return 1 on success, 0 if storage holds no recording
+ */
+uint8_t input_controller_start_replay(InputController* ctrl);
+
+/**
+ * Finish recording (flush) or stop replaying
+ * @param ctrl Pointer to input controller
+ */
+void input_controller_stop_replay(InputController* ctrl);
+
 #endif // INPUT_CONTROLLER_H
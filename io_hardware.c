@@ -5,85 +5,199 @@
  *==========================================================================*/
 
 #include "io_hardware.h"
-#include <avr/io.h>
-#include <stdlib.h>
+#include "hal.h"
+#include "timer.h"
+#include "latency.h"
+#include <stddef.h>
 
 /*============================================================================
- * BUTTON IMPLEMENTATION
+ * DEVICE POOL
  *==========================================================================*/
 
+typedef union {
+    ButtonData button;
+    AnalogData analog;
+} DeviceData;
+
+static InputDevice pool_devices[INPUT_POOL_DEVICES];
+static DeviceData pool_data[INPUT_POOL_DEVICES];
+
 /**
- * Internal button polling function
- * Reads GPIO pin state and detects press/release events
+ * Find a free pool slot (a free slot has no poll_impl)
+ * @return Slot index, or INPUT_POOL_DEVICES if the pool is exhausted
  */
-static void poll_button(InputDevice* self) {
-    if (self == NULL || self->device_data == NULL) return;
+static uint8_t find_free_slot(void) {
+    uint8_t slot = 0;
+    while (slot < INPUT_POOL_DEVICES && pool_devices[slot].poll_impl != NULL) slot++;
+    return slot;
+}
 
-    ButtonData* data = (ButtonData*)self->device_data;
+/*============================================================================
+ * BUTTON EVENT QUEUE
+ *==========================================================================*/
+
+_Static_assert((BUTTON_EVENT_QUEUE_SIZE & (BUTTON_EVENT_QUEUE_SIZE - 1)) == 0,
+               "BUTTON_EVENT_QUEUE_SIZE must be a power of two");
 
-    // Read physical pin state
-    uint8_t pin_level = (data->port->IN & data->pin_bm) ? 1 : 0;
+// Single-producer ring: edges are recorded from interrupts, or from the main
+// loop with interrupts disabled; the main loop consumes without locking.
+// Indices run freely and are masked on access (head - tail = queued events).
+static volatile ButtonEvent event_queue[BUTTON_EVENT_QUEUE_SIZE];
+static volatile uint8_t event_head = 0;                      // Next slot written
+static volatile uint8_t event_tail = 0;                      // Next slot read
+
+// Buttons using pin-change interrupts
+static InputDevice* volatile interrupt_buttons[BUTTON_INTERRUPT_MAX];
+static volatile uint8_t interrupt_button_count = 0;
+
+/**
+ * Read a button's logical state from its pin
+ */
+static ButtonState read_button(const ButtonData* data) {
+    uint8_t pin_level = hal_pin_read(data->port, data->pin_bm);
 
     // Apply active-low logic if needed
     uint8_t logical_state = data->active_low ? !pin_level : pin_level;
+    return logical_state ? BUTTON_PRESSED : BUTTON_RELEASED;
+}
 
-    ButtonState current_state = logical_state ? BUTTON_PRESSED : BUTTON_RELEASED;
+/**
+ * Queue a button edge if the pin level differs from the debounced state
+ * Must not be interrupted by another producer (runs in an interrupt or
+ * with interrupts disabled). Edges within BUTTON_DEBOUNCE_TICKS of the
+ * previous one are bounce and ignored; the first edge of a bounce already
+ * counts, so there is no added latency.
+ */
+static void record_button_edge(InputDevice* device) {
+    ButtonData* data = (ButtonData*)device->device_data;
 
-    // Detect state change
-    if (current_state != data->last_state) {
-        data->last_state = current_state;
-        self->current_value = current_state;
+    ButtonState state = read_button(data);
+    if (state == data->last_state) return;
 
-        // Trigger appropriate callback
-        if (current_state == BUTTON_PRESSED && self->on_press != NULL) {
-            self->on_press(self);
-        } else if (current_state == BUTTON_RELEASED && self->on_release != NULL) {
-            self->on_release(self);
+    uint16_t now = timer_ticks();
+    if ((uint16_t)(now - data->edge_tick) < BUTTON_DEBOUNCE_TICKS) return;  // Bouncing
+
+    uint8_t head = event_head;
+    if ((uint8_t)(head - event_tail) == BUTTON_EVENT_QUEUE_SIZE) return;  // Full: retried on next poll
+
+    volatile ButtonEvent* event = &event_queue[head & (BUTTON_EVENT_QUEUE_SIZE - 1)];
+    event->device = device;
+    event->state = state;
+    event->tick = now;
+    event_head = head + 1;                                   // Publish after the slot is written
+
+    data->last_state = state;
+    data->edge_tick = now;
+
+    LATENCY_EDGE(state == BUTTON_PRESSED);
+}
+
+/**
+ * Pin-change interrupt - record edges of the buttons on the changed pins
+ */
+static void on_pin_change(HalPort port, uint8_t pins) {
+    for (uint8_t i = 0; i < interrupt_button_count; i++) {
+        InputDevice* device = interrupt_buttons[i];
+        ButtonData* data = (ButtonData*)device->device_data;
+        if (data->port == port && (data->pin_bm & pins)) {
+            record_button_edge(device);
         }
     }
 }
 
+uint8_t enable_button_interrupt(InputDevice* button) {
+    if (button == NULL || button->type != INPUT_TYPE_BUTTON) return 0;
+    if (interrupt_button_count == BUTTON_INTERRUPT_MAX) return 0;
+
+    ButtonData* data = (ButtonData*)button->device_data;
+    interrupt_buttons[interrupt_button_count] = button;
+    interrupt_button_count++;                                // Visible to the ISR once complete
+
+    hal_pin_set_change_handler(on_pin_change);
+    hal_pin_change_enable(data->port, data->pin_bm);
+    return 1;
+}
+
 /**
- * Create a button input device
+ * Stop recording a button's edges from interrupts
  */
-InputDevice* create_button(volatile PORT_t* port, uint8_t pin_bm,
-                          uint8_t active_low,
-                          InputCallback on_press,
-                          InputCallback on_release) {
-    // Allocate InputDevice
-    InputDevice* device = (InputDevice*)malloc(sizeof(InputDevice));
-    if (device == NULL) return NULL;
-
-    // Allocate ButtonData
-    ButtonData* data = (ButtonData*)malloc(sizeof(ButtonData));
-    if (data == NULL) {
-        free(device);
-        return NULL;
+static void disable_button_interrupt(InputDevice* button) {
+    uint8_t irq_state = hal_interrupts_disable();
+    for (uint8_t i = 0; i < interrupt_button_count; i++) {
+        if (interrupt_buttons[i] == button) {
+            interrupt_button_count--;
+            interrupt_buttons[i] = interrupt_buttons[interrupt_button_count];
+            break;
+        }
     }
+    hal_interrupts_restore(irq_state);
+}
+
+uint8_t dispatch_button_event(ButtonEvent* event) {
+    uint8_t tail = event_tail;
+    if (tail == event_head) return 0;
+
+    ButtonEvent next = event_queue[tail & (BUTTON_EVENT_QUEUE_SIZE - 1)];
+    event_tail = tail + 1;                                   // Slot may be reused from here
+    LATENCY_DISPATCH(next.state == BUTTON_PRESSED);
 
-    // Configure GPIO hardware
-    port->DIRCLR = pin_bm;  // Set pin as input
-
-    if (active_low) {
-        // Enable internal pull-up for active-low buttons
-        // Calculate pin index from bitmask
-        uint8_t pin_index = 0;
-        uint8_t mask = pin_bm;
-        while (mask > 1) {
-            mask >>= 1;
-            pin_index++;
+    InputDevice* device = next.device;
+    if (device->poll_impl != NULL) {                         // Skip destroyed devices
+        device->current_value = next.state;
+
+        // Trigger appropriate callback
+        if (next.state == BUTTON_PRESSED && device->on_press != NULL) {
+            device->on_press(device);
+        } else if (next.state == BUTTON_RELEASED && device->on_release != NULL) {
+            device->on_release(device);
         }
+    }
+
+    if (event != NULL) *event = next;
+    return 1;
+}
+
+uint8_t button_event_pending(void) {
+    return event_tail != event_head;
+}
+
+/*============================================================================
+ * BUTTON IMPLEMENTATION
+ *==========================================================================*/
+
+/**
+ * Internal button polling function
+ * Queues an edge when the pin level differs from the debounced state
+ * (the only source of events for buttons without a pin-change interrupt)
+ */
+static void poll_button(InputDevice* self) {
+    if (self == NULL || self->device_data == NULL) return;
+
+    ButtonData* data = (ButtonData*)self->device_data;
 
-        // Access PINnCTRL register for this pin
-        volatile uint8_t* pin_ctrl = (volatile uint8_t*)&port->PIN0CTRL;
-        pin_ctrl[pin_index] = PORT_PULLUPEN_bm;
+    // Cheap check first; the edge is recorded as the interrupt would
+    if (read_button(data) != data->last_state) {
+        uint8_t irq_state = hal_interrupts_disable();
+        record_button_edge(self);
+        hal_interrupts_restore(irq_state);
     }
+}
+
+/**
+ * Initialize a button input device in caller-provided storage
+ */
+void init_button(InputDevice* device, ButtonData* data,
+                 HalPort port, uint8_t pin_bm, uint8_t active_low,
+                 InputCallback on_press, InputCallback on_release) {
+    // Configure GPIO hardware (internal pull-up for active-low buttons)
+    hal_pin_input(port, pin_bm, active_low);
 
     // Initialize ButtonData
     data->port = port;
     data->pin_bm = pin_bm;
     data->active_low = active_low;
     data->last_state = BUTTON_RELEASED;
+    data->edge_tick = timer_ticks() - BUTTON_DEBOUNCE_TICKS;  // First edge is never bounce
 
     // Initialize InputDevice
     device->type = INPUT_TYPE_BUTTON;
@@ -93,8 +207,72 @@ InputDevice* create_button(volatile PORT_t* port, uint8_t pin_bm,
     device->on_press = on_press;
     device->on_release = on_release;
     device->on_value_change = NULL;  // Not used for buttons
+}
+
+/**
+ * Create a button input device from the pool
+ */
+InputDevice* create_button(HalPort port, uint8_t pin_bm,
+                          uint8_t active_low,
+                          InputCallback on_press,
+                          InputCallback on_release) {
+    uint8_t slot = find_free_slot();
+    if (slot == INPUT_POOL_DEVICES) return NULL;
+
+    init_button(&pool_devices[slot], &pool_data[slot].button,
+                port, pin_bm, active_low, on_press, on_release);
+    return &pool_devices[slot];
+}
+
+/*============================================================================
+ * BACKGROUND ADC SAMPLING
+ *==========================================================================*/
+
+// Two sets of results: the ISR fills one while the other is read
+static volatile uint16_t sample_sets[2][ADC_SAMPLING_MAX_CHANNELS];
+static volatile uint8_t published_set = 0;                   // Set readers use
+static const uint8_t* sampled_channels = NULL;
+static uint8_t sampled_count = 0;
+
+/**
+ * Store a background result (ADC interrupt)
+ * The filling set is published once its last channel arrives, so readers
+ * always see values from a single scan
+ */
+static void on_adc_sample(uint8_t index, uint16_t result) {
+    uint8_t filling = published_set ^ 1;
+    sample_sets[filling][index] = result;
+    if (index == sampled_count - 1) {
+        published_set = filling;
+    }
+}
+
+/**
+ * Latest published sample of a channel
+ * @return 1 if the channel is sampled in the background
+ */
+static uint8_t read_sampled_channel(uint8_t channel, uint16_t* value) {
+    for (uint8_t i = 0; i < sampled_count; i++) {
+        if (sampled_channels[i] == channel) {
+            *value = sample_sets[published_set][i];
+            return 1;
+        }
+    }
+    return 0;
+}
 
-    return device;
+uint8_t start_adc_sampling(const uint8_t* channels, uint8_t count) {
+    if (count == 0 || count > ADC_SAMPLING_MAX_CHANNELS) return 0;
+
+    // Until the first scan completes, read as centered
+    for (uint8_t i = 0; i < count; i++) {
+        sample_sets[0][i] = 2048;
+        sample_sets[1][i] = 2048;
+    }
+    sampled_channels = channels;
+    sampled_count = count;
+    hal_adc_start_scan(channels, count, on_adc_sample);
+    return 1;
 }
 
 /*============================================================================
@@ -110,28 +288,13 @@ static void poll_analog(InputDevice* self) {
 
     AnalogData* data = (AnalogData*)self->device_data;
 
-    // Select ADC channel using proper MUX constants
-    // Must use ADC_MUXPOS_AINx_gc constants, not raw channel numbers
-    switch (data->adc_channel) {
-        case 1: ADC0.MUXPOS = ADC_MUXPOS_AIN1_gc; break;
-        case 2: ADC0.MUXPOS = ADC_MUXPOS_AIN2_gc; break;
-        case 3: ADC0.MUXPOS = ADC_MUXPOS_AIN3_gc; break;
-        case 4: ADC0.MUXPOS = ADC_MUXPOS_AIN4_gc; break;
-        case 5: ADC0.MUXPOS = ADC_MUXPOS_AIN5_gc; break;
-        case 6: ADC0.MUXPOS = ADC_MUXPOS_AIN6_gc; break;
-        case 7: ADC0.MUXPOS = ADC_MUXPOS_AIN7_gc; break;
-        default: return;  // Invalid channel
+    // Latest background sample, or a blocking conversion (12-bit: 0-4095)
+    uint16_t raw_value;
+    if (!read_sampled_channel(data->adc_channel, &raw_value) &&
+        !hal_adc_read(data->adc_channel, &raw_value)) {
+        return;  // Invalid channel
     }
 
-    // Start conversion (use |= to preserve mode bits)
-    ADC0.COMMAND |= ADC_START_IMMEDIATE_gc;
-
-    // Wait for conversion to complete
-    while (!(ADC0.INTFLAGS & ADC_RESRDY_bm));
-
-    // Read result (12-bit: 0-4095)
-    uint16_t raw_value = ADC0.RESULT;
-
     // Check relative threshold (has value changed significantly?)
     int16_t delta = (int16_t)raw_value - (int16_t)data->last_accepted_value;
 
@@ -150,21 +313,11 @@ static void poll_analog(InputDevice* self) {
 }
 
 /**
- * Create an analog input device
+ * Initialize an analog input device in caller-provided storage
  */
-InputDevice* create_analog(uint8_t adc_channel, uint16_t threshold,
-                          InputCallback on_value_change) {
-    // Allocate InputDevice
-    InputDevice* device = (InputDevice*)malloc(sizeof(InputDevice));
-    if (device == NULL) return NULL;
-
-    // Allocate AnalogData
-    AnalogData* data = (AnalogData*)malloc(sizeof(AnalogData));
-    if (data == NULL) {
-        free(device);
-        return NULL;
-    }
-
+void init_analog(InputDevice* device, AnalogData* data,
+                 uint8_t adc_channel, uint16_t threshold,
+                 InputCallback on_value_change) {
     // Initialize AnalogData
     data->adc_channel = adc_channel;
     data->last_accepted_value = 2048;  // Start at center (12-bit midpoint)
@@ -178,8 +331,19 @@ InputDevice* create_analog(uint8_t adc_channel, uint16_t threshold,
     device->on_press = NULL;      // Not used for analog
     device->on_release = NULL;
     device->on_value_change = on_value_change;
+}
 
-    return device;
+/**
+ * Create an analog input device from the pool
+ */
+InputDevice* create_analog(uint8_t adc_channel, uint16_t threshold,
+                          InputCallback on_value_change) {
+    uint8_t slot = find_free_slot();
+    if (slot == INPUT_POOL_DEVICES) return NULL;
+
+    init_analog(&pool_devices[slot], &pool_data[slot].analog,
+                adc_channel, threshold, on_value_change);
+    return &pool_devices[slot];
 }
 
 /*============================================================================
@@ -197,11 +361,14 @@ uint16_t get_input_value(InputDevice* device) {
 }
 
 void destroy_input_device(InputDevice* device) {
-    if (device != NULL) {
-        if (device->device_data != NULL) {
-            free(device->device_data);
-        }
-        free(device);
+    // Only pool devices are released (caller storage is left untouched)
+    if (device != NULL && device->type == INPUT_TYPE_BUTTON) {
+        disable_button_interrupt(device);
+    }
+
+    if (device >= pool_devices && device < pool_devices + INPUT_POOL_DEVICES) {
+        device->poll_impl = NULL;
+        device->device_data = NULL;
     }
 }
 
@@ -214,23 +381,5 @@ void destroy_input_device(InputDevice* device) {
  * Configures ADC0 for 12-bit single-ended mode
  */
 void init_adc(void) {
-    // Reference: ATtiny1627 Datasheet Section 30 (ADC)
-    // Based on working ADC example code
-
-    // Configure PA1 and PA2 as analog inputs
-    // Disable digital input buffers for accurate ADC readings
-    PORTA.DIRCLR = PIN1_bm | PIN2_bm;  // Set PA1 and PA2 as inputs
-    PORTA.PIN1CTRL = PORT_ISC_INPUT_DISABLE_gc;  // Disable digital buffer on PA1
-    PORTA.PIN2CTRL = PORT_ISC_INPUT_DISABLE_gc;  // Disable digital buffer on PA2
-
-    ADC0.COMMAND |= ADC_MODE_SINGLE_12BIT_gc;
-
-    // Enable ADC (12-bit resolution)
-    ADC0.CTRLA = ADC_ENABLE_bm;
-
-    // Configure ADC prescaler (CLK_PER / 4)
-    ADC0.CTRLB = ADC_PRESC_DIV4_gc;
-
-    // Configure voltage reference
-    ADC0.CTRLC = ADC_REFSEL_VDD_gc;
+    hal_adc_init();  // PA1/PA2 analog, 12-bit single-ended, CLK_PER / 4
 }
@@ -9,29 +9,42 @@
  * Features:
  * - Callback-based event system (on_press, on_release, on_value_change)
  * - Internal relative threshold logic for analog inputs
- * - Polling-based (no interrupts)
+ * - Polling-based; analog inputs can be sampled in the background
+ *   (start_adc_sampling()), so polling them only reads memory
+ * - Button edges are debounced and queued with tick timestamps; buttons
+ *   can record them from pin-change interrupts (enable_button_interrupt())
+ *   so short taps between polls are not lost. Button values and callbacks
+ *   are updated when the events are dispatched (dispatch_button_event())
  * - Exposes single "accepted value" per device
+ * - No heap: create_*() take from a fixed pool (INPUT_POOL_DEVICES), init_*()
+ *   build a device in caller-provided storage
  *
  * Architecture:
  *     controller.c (game-level input mapping)
  *         ↓
  *     io_hardware.c (hardware abstraction)
  *         ↓
- *     ATtiny1627 GPIO/ADC peripherals
+ *     hal.h (ATtiny1627 GPIO/ADC, or host mock)
  *
  * USAGE:
- *     // Initialize ADC peripheral
+ *     // Initialize ADC peripheral (optionally sample in the background)
  *     init_adc();
+ *     static const uint8_t axes[] = {1, 2};
+ *     start_adc_sampling(axes, 2);
  *
  *     // Create button (active-low with pull-up)
- *     InputDevice* btn = create_button(&PORTC, PIN4_bm, 1, NULL, NULL);
+ *     InputDevice* btn = create_button(HAL_PORTC, PIN4_bm, 1, NULL, NULL);
  *
  *     // Create analog input (joystick axis)
  *     InputDevice* joy_x = create_analog(0, 10, NULL);  // Channel 0, threshold 10
  *
+ *     enable_button_interrupt(btn);                  // Optional
+ *
  *     // In game loop
  *     poll_input(btn);
  *     poll_input(joy_x);
+ *     ButtonEvent event;
+ *     while (dispatch_button_event(&event)) {}       // Fires on_press/on_release
  *
  *     uint16_t btn_state = get_input_value(btn);     // 0 or 1
  *     uint16_t joy_x_val = get_input_value(joy_x);   // 0-1023
@@ -45,7 +58,7 @@
 #define IO_HARDWARE_H
 
 #include <stdint.h>
-#include <xc.h>
+#include "hal.h"
 
 /*============================================================================
  * CONFIGURATION MACROS
@@ -57,6 +70,27 @@
  */
 #define ANALOG_THRESHOLD 10
 
+/**
+ * Button debounce - edges closer than this to the previous accepted edge
+ * are ignored (2 ticks = 16-31 ms)
+ */
+#define BUTTON_DEBOUNCE_TICKS 2
+
+/**
+ * Button event queue capacity (power of two)
+ */
+#define BUTTON_EVENT_QUEUE_SIZE 8
+
+/**
+ * Maximum buttons using pin-change interrupts
+ */
+#define BUTTON_INTERRUPT_MAX 2
+
+/**
+ * Maximum channels sampled in the background
+ */
+#define ADC_SAMPLING_MAX_CHANNELS 2
+
 /*============================================================================
  * INPUT DEVICE TYPES
  *==========================================================================*/
@@ -118,12 +152,22 @@ struct InputDevice {
  * Button-specific data structure
  */
 typedef struct {
-    volatile PORT_t* port;                  // Port register (e.g., &PORTC)
+    HalPort port;                           // Port (e.g., HAL_PORTC)
     uint8_t pin_bm;                         // Pin bitmask (e.g., PIN4_bm)
     uint8_t active_low;                     // 1 if button is active-low (typical with pull-up)
-    ButtonState last_state;                 // Last debounced state
+    ButtonState last_state;                 // Last debounced state (last queued edge)
+    uint16_t edge_tick;                     // Tick of the last accepted edge
 } ButtonData;
 
+/**
+ * Debounced button edge
+ */
+typedef struct {
+    InputDevice* device;                    // Button that changed
+    ButtonState state;                      // New state
+    uint16_t tick;                          // timer_ticks() when the edge happened
+} ButtonEvent;
+
 /*============================================================================
  * ANALOG DEVICE DATA
  *==========================================================================*/
@@ -138,22 +182,63 @@ typedef struct {
     uint16_t threshold;                     // Minimum change to trigger on_value_change
 } AnalogData;
 
+/*============================================================================
+ * DEVICE POOL
+ *==========================================================================*/
+
+#define INPUT_POOL_DEVICES 4                            // 2 buttons + 2 joystick axes
+
+/**
+ * Static RAM taken by the device pool
+ */
+#define INPUT_POOL_BYTES (INPUT_POOL_DEVICES * (sizeof(InputDevice) + \
+                          (sizeof(ButtonData) > sizeof(AnalogData) ? sizeof(ButtonData) : sizeof(AnalogData))))
+
 /*============================================================================
  * CONSTRUCTORS
  *==========================================================================*/
 
+/**
+ * Initialize a button input device in caller-provided storage
+ * Configures GPIO pin with optional pull-up resistor
+ *
+ * @param device Device storage
+ * @param data Button data storage (must outlive the device)
+ * @param port Port (e.g., HAL_PORTC)
+ * @param pin_bm Pin bitmask (e.g., PIN4_bm for PC4)
+ * @param active_low 1 for active-low (typical with pull-up), 0 for active-high
+ * @param on_press Callback for button press event (can be NULL)
+ * @param on_release Callback for button release event (can be NULL)
+ */
+void init_button(InputDevice* device, ButtonData* data,
+                 HalPort port, uint8_t pin_bm, uint8_t active_low,
+                 InputCallback on_press, InputCallback on_release);
+
+/**
+ * Initialize an analog input device (ADC) in caller-provided storage
+ *
+ * @param device Device storage
+ * @param data Analog data storage (must outlive the device)
+ * @param adc_channel ADC channel number (0-14)
+ * @param threshold Minimum change to trigger callback
+ * @param on_value_change Callback when value changes beyond threshold (can be NULL)
+ */
+void init_analog(InputDevice* device, AnalogData* data,
+                 uint8_t adc_channel, uint16_t threshold,
+                 InputCallback on_value_change);
+
 /**
  * Create a button input device
  * Configures GPIO pin with optional pull-up resistor
  *
- * @param port Port register pointer (e.g., &PORTC)
+ * @param port Port (e.g., HAL_PORTC)
  * @param pin_bm Pin bitmask (e.g., PIN4_bm for PC4)
  * @param active_low 1 for active-low (typical with pull-up), 0 for active-high
  * @param on_press Callback for button press event (can be NULL)
  * @param on_release Callback for button release event (can be NULL)
- * @return Pointer to new InputDevice, or NULL on allocation failure
+ * @return Pointer to new InputDevice, or NULL if the pool is exhausted
  */
-InputDevice* create_button(volatile PORT_t* port, uint8_t pin_bm,
+InputDevice* create_button(HalPort port, uint8_t pin_bm,
                           uint8_t active_low,
                           InputCallback on_press,
                           InputCallback on_release);
@@ -165,7 +250,7 @@ InputDevice* create_button(volatile PORT_t* port, uint8_t pin_bm,
  * @param adc_channel ADC channel number (0-14)
  * @param threshold Minimum change to trigger callback (e.g., 40 = 1% of 4095 range)
  * @param on_value_change Callback when value changes beyond threshold (can be NULL)
- * @return Pointer to new InputDevice, or NULL on allocation failure
+ * @return Pointer to new InputDevice, or NULL if the pool is exhausted
  */
 InputDevice* create_analog(uint8_t adc_channel, uint16_t threshold,
                           InputCallback on_value_change);
@@ -178,7 +263,7 @@ InputDevice* create_analog(uint8_t adc_channel, uint16_t threshold,
  * Poll an input device (read hardware and trigger callbacks if needed)
  * Call once per frame in game loop for each input device
  *
- * For buttons: Reads GPIO pin state and detects press/release events
+ * For buttons: Reads GPIO pin state and queues press/release events
  * For analog: Performs ADC conversion and checks threshold
  *
  * @param device Pointer to input device
@@ -200,6 +285,37 @@ uint16_t get_input_value(InputDevice* device);
  */
 void destroy_input_device(InputDevice* device);
 
+/*============================================================================
+ * BUTTON EVENTS
+ *==========================================================================*/
+
+/**
+ * Record a button's edges from its pin-change interrupt
+ * Polling the button is still needed: it catches a level change that was
+ * debounced away (e.g. a final bounce after the lockout) and retries when
+ * the queue was full
+ *
+ * @param button Button device
+ * @return 1 on success, 0 if not a button or BUTTON_INTERRUPT_MAX are in use
+ */
+uint8_t enable_button_interrupt(InputDevice* button);
+
+/**
+ * Take the oldest queued button event and apply it
+ * Sets the button's value and fires its on_press / on_release callback
+ *
+ * @param event Receives the event (can be NULL)
+ * @return 1 if an event was dispatched, 0 if the queue is empty
+ */
+uint8_t dispatch_button_event(ButtonEvent* event);
+
+/**
+ * Check for queued button events without taking one
+ * Safe with interrupts disabled (e.g. before going to sleep)
+ * @return 1 if at least one event is queued
+ */
+uint8_t button_event_pending(void);
+
 /*============================================================================
  * HARDWARE INITIALIZATION
  *==========================================================================*/
@@ -216,4 +332,18 @@ void destroy_input_device(InputDevice* device);
  */
 void init_adc(void);
 
+/**
+ * Sample analog channels in the background
+ * The ADC converts the channels in turn from its interrupt, averaging
+ * 2^HAL_ADC_ACCUMULATE_LOG2 samples per result, and publishes each
+ * complete set of results at once (double-buffered). Analog devices on
+ * these channels then read the latest set instead of converting.
+ * Call after init_adc(); blocking conversions are no longer available.
+ *
+ * @param channels ADC channels (must stay valid, e.g. static const)
+ * @param count Number of channels (1 to ADC_SAMPLING_MAX_CHANNELS)
+ * @return 1 on success, 0 if count is out of range
+ */
+uint8_t start_adc_sampling(const uint8_t* channels, uint8_t count);
+
 #endif // IO_HARDWARE_H
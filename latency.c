@@ -0,0 +1,239 @@
+/*============================================================================
+ * latency.c
+ *============================================================================
+ * Input-to-photon latency test implementation
+ * Compiles to nothing unless LATENCY_TEST is defined
+ *==========================================================================*/
+
+#include "latency.h"
+
+#ifdef LATENCY_TEST
+
+#include "hal.h"
+#include "sh1106_graphics.h"
+#include "timer.h"
+
+/*============================================================================
+ * INTERNAL STATE
+ *==========================================================================*/
+
+// Microseconds per counter tick in Q8 (computed at compile time)
+#define LATENCY_US_PER_COUNT_Q8 ((1000000UL * 256UL + HAL_COUNTER_HZ / 2) / HAL_COUNTER_HZ)
+
+/**
+ * Progress of the press being followed; every step is taken by one side
+ * only (edge: interrupt, dispatch/flip: main loop, sent: refresh, which
+ * may be the SPI interrupt), so no locking is needed
+ */
+typedef enum {
+    TRACK_IDLE,             // Waiting for a press edge
+    TRACK_EDGE,             // Press recorded, not yet dispatched
+    TRACK_DISPATCHED,       // Game has the press, frame not drawn yet
+    TRACK_FLIPPED,          // Marker inverted, its page not sent yet
+    TRACK_SENT              // Complete, waiting to be accounted
+} TrackState;
+
+/**
+ * Counter stamps of one measurement
+ */
+typedef enum {
+    STAMP_EDGE,
+    STAMP_DISPATCH,
+    STAMP_FLIP,
+    STAMP_SENT,
+    STAMP_COUNT
+} StampIndex;
+
+/**
+ * Running totals for one stage in the current window (counter ticks)
+ */
+typedef struct {
+    uint16_t min;
+    uint16_t max;
+    uint32_t sum;
+} StageAccumulator;
+
+static volatile uint8_t track_state = TRACK_IDLE;
+static volatile uint16_t stamps[STAMP_COUNT];
+static volatile uint16_t edge_tick = 0;                  // timer_ticks() at the edge
+static volatile uint16_t sent_tick = 0;                  // timer_ticks() when sent
+
+static StageAccumulator accumulators[LATENCY_STAGE_COUNT];
+static LatencyStats published[LATENCY_STAGE_COUNT];
+static uint8_t window_count = 0;
+static uint16_t dropped = 0;
+
+// Labels in the serial report: Input, Render, Send, Total
+static const char STAGE_LABELS[LATENCY_STAGE_COUNT] = {'I', 'R', 'S', 'T'};
+
+// First and last stamp of every stage
+static const uint8_t STAGE_FROM[LATENCY_STAGE_COUNT] = {STAMP_EDGE, STAMP_DISPATCH, STAMP_FLIP, STAMP_EDGE};
+static const uint8_t STAGE_TO[LATENCY_STAGE_COUNT]   = {STAMP_DISPATCH, STAMP_FLIP, STAMP_SENT, STAMP_SENT};
+
+/*============================================================================
+ * HELPER FUNCTIONS
+ *==========================================================================*/
+
+/**
+ * Take a counter stamp and mark the stage on the probe pin
+ */
+static void stamp(StampIndex index) {
+    stamps[index] = hal_counter_read();
+#ifdef LATENCY_PROBE
+    hal_pin_toggle(LATENCY_PROBE_PORT, LATENCY_PROBE_PIN);
+#endif
+}
+
+/**
+ * Convert counter ticks to microseconds (saturates at 65535)
+ */
+static uint16_t counts_to_us(uint32_t counts) {
+    uint32_t us = (counts * LATENCY_US_PER_COUNT_Q8) >> 8;
+    return (us > 0xFFFF) ? 0xFFFF : (uint16_t)us;
+}
+
+/**
+ * Clear all accumulators for a new window
+ */
+static void reset_window(void) {
+    for (uint8_t i = 0; i < LATENCY_STAGE_COUNT; i++) {
+        accumulators[i].min = 0xFFFF;
+        accumulators[i].max = 0;
+        accumulators[i].sum = 0;
+    }
+    window_count = 0;
+}
+
+/**
+ * Blocking serial writer (test builds only - a report takes a few ms)
+ */
+static void serial_write(char c) {
+    hal_serial_write((uint8_t)c);
+}
+
+static void serial_write_number(uint16_t number) {
+    char digits[5];
+    uint8_t count = 0;
+    do {
+        digits[count++] = '0' + (number % 10);
+        number /= 10;
+    } while (number > 0);
+    while (count > 0) {
+        serial_write(digits[--count]);
+    }
+}
+
+/**
+ * Print one line per stage ("LI min avg max") and the drop count ("LX n")
+ */
+static void serial_report(void) {
+    for (uint8_t i = 0; i < LATENCY_STAGE_COUNT; i++) {
+        serial_write('L');
+        serial_write(STAGE_LABELS[i]);
+        serial_write(' ');
+        serial_write_number(published[i].min_us);
+        serial_write(' ');
+        serial_write_number(published[i].avg_us);
+        serial_write(' ');
+        serial_write_number(published[i].max_us);
+        serial_write('\r');
+        serial_write('\n');
+    }
+    serial_write('L');
+    serial_write('X');
+    serial_write(' ');
+    serial_write_number(dropped);
+    serial_write('\r');
+    serial_write('\n');
+}
+
+/**
+ * Add a completed measurement to the window; publish and print full windows
+ */
+static void account_measurement(void) {
+    if ((uint16_t)(sent_tick - edge_tick) >= LATENCY_MAX_TICKS) {
+        dropped++;                                                           // Counter wrapped in between
+        return;
+    }
+
+    for (uint8_t i = 0; i < LATENCY_STAGE_COUNT; i++) {
+        StageAccumulator* acc = &accumulators[i];
+        uint16_t elapsed = stamps[STAGE_TO[i]] - stamps[STAGE_FROM[i]];     // Wrap-safe
+
+        if (elapsed < acc->min) acc->min = elapsed;
+        if (elapsed > acc->max) acc->max = elapsed;
+        acc->sum += elapsed;
+    }
+
+    if (++window_count < LATENCY_WINDOW) return;
+
+    for (uint8_t i = 0; i < LATENCY_STAGE_COUNT; i++) {
+        published[i].min_us = counts_to_us(accumulators[i].min);
+        published[i].avg_us = counts_to_us(accumulators[i].sum / LATENCY_WINDOW);
+        published[i].max_us = counts_to_us(accumulators[i].max);
+    }
+    serial_report();
+    reset_window();
+}
+
+/*============================================================================
+ * LATENCY INITIALIZATION
+ *==========================================================================*/
+
+void init_latency(void) {
+    // The counter runs since init_delay() (timer.h)
+    reset_window();
+    dropped = 0;
+    track_state = TRACK_IDLE;
+
+    hal_serial_init(LATENCY_BAUD);
+#ifdef LATENCY_PROBE
+    hal_pin_output(LATENCY_PROBE_PORT, LATENCY_PROBE_PIN);
+#endif
+}
+
+/*============================================================================
+ * LATENCY OPERATIONS
+ *==========================================================================*/
+
+void latency_edge(uint8_t pressed) {
+    if (!pressed || track_state != TRACK_IDLE) return;
+    stamp(STAMP_EDGE);
+    edge_tick = timer_ticks();
+    track_state = TRACK_EDGE;
+}
+
+void latency_dispatch(uint8_t pressed) {
+    if (!pressed || track_state != TRACK_EDGE) return;
+    stamp(STAMP_DISPATCH);
+    track_state = TRACK_DISPATCHED;
+}
+
+void latency_draw_marker(void) {
+    if (track_state == TRACK_SENT) {
+        account_measurement();
+        track_state = TRACK_IDLE;                                            // Ready for the next press
+    }
+    if (track_state != TRACK_DISPATCHED) return;
+
+    fillRect((Point){LATENCY_MARKER_X, LATENCY_MARKER_PAGE * 8},
+             LATENCY_MARKER_WIDTH, 8, COLOR_INVERT);
+    stamp(STAMP_FLIP);
+    track_state = TRACK_FLIPPED;
+}
+
+void latency_run_sent(uint8_t page, uint8_t column, uint8_t length) {
+    if (track_state != TRACK_FLIPPED || page != LATENCY_MARKER_PAGE) return;
+    if (column > LATENCY_MARKER_X ||
+        column + length < LATENCY_MARKER_X + LATENCY_MARKER_WIDTH) return;   // Run misses the marker
+
+    stamp(STAMP_SENT);
+    sent_tick = timer_ticks();
+    track_state = TRACK_SENT;
+}
+
+LatencyStats latency_get_stats(LatencyStage stage) {
+    return published[stage];
+}
+
+#endif // LATENCY_TEST
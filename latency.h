@@ -0,0 +1,149 @@
+/*============================================================================
+ * latency.h
+ *============================================================================
+ * Input-to-photon latency test mode
+ *
+ * Follows one button press through the pipeline and times every stage with
+ * the HAL free-running counter:
+ *
+ *     edge       pin change (interrupt) or poll records the press
+ *       ↓ INPUT    queued until update_input_controller() dispatches it
+ *     dispatch
+ *       ↓ RENDER   waits for the next rendered frame, which inverts
+ *     flip         the marker (LATENCY_MARKER_*) in buffer
+ *       ↓ SEND     refresh streams the runs up to the marker's page
+ *     sent         (the panel shows it from its next scan)
+ *
+ * Only one press is followed at a time; presses during a measurement are
+ * not timed. The marker is a small block in the top-right corner that
+ * changes colour with every measured press. Measurements longer than the
+ * counter range (LATENCY_MAX_TICKS) are dropped and counted.
+ *
+ * Build flags:
+ *     LATENCY_TEST  - compile the test in (otherwise every LATENCY_* macro
+ *                     expands to nothing and latency.c is empty)
+ *     LATENCY_PROBE - also toggle LATENCY_PROBE_PIN at every stage (one
+ *                     edge per stage for a scope or logic analyser)
+ *
+ * Each window of LATENCY_WINDOW presses is printed on USART0 TX (PB2):
+ *     LI min avg max    (µs, edge to dispatch)
+ *     LR min avg max    (dispatch to flip)
+ *     LS min avg max    (flip to sent)
+ *     LT min avg max    (edge to sent)
+ *     LX n              (dropped measurements)
+ *
+ * USAGE:
+ *     init_latency();
+ *
+ *     draw_game_controller(&game);
+ *     LATENCY_DRAW_MARKER();          // After drawing, before the refresh
+ *     refreshDisplayAsync();
+ *==========================================================================*/
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <stdint.h>
+#include "hal.h"
+#include "timer.h"
+
+/*============================================================================
+ * LATENCY CONFIGURATION
+ *==========================================================================*/
+
+#define LATENCY_WINDOW       8                                      // Presses per report
+#define LATENCY_BAUD         115200UL                               // USART0 rate
+#define LATENCY_MARKER_X     124                                    // Marker block (one page tall)
+#define LATENCY_MARKER_WIDTH 4
+#define LATENCY_MARKER_PAGE  0
+#define LATENCY_PROBE_PORT   HAL_PORTA                              // Spare pin for LATENCY_PROBE
+#define LATENCY_PROBE_PIN    PIN3_bm
+
+// Longest measurement the 16-bit counter can time
+#define LATENCY_MAX_TICKS    ((uint16_t)((65536UL * TICK_RATE_HZ) / HAL_COUNTER_HZ))
+
+/*============================================================================
+ * LATENCY TYPES
+ *==========================================================================*/
+
+/**
+ * Timed stages of a press
+ */
+typedef enum {
+    LATENCY_INPUT,          // Edge to dispatch_button_event()
+    LATENCY_RENDER,         // Dispatch to the marker flip in buffer
+    LATENCY_SEND,           // Flip to the marker's page sent
+    LATENCY_TOTAL,          // Edge to sent
+    LATENCY_STAGE_COUNT
+} LatencyStage;
+
+/**
+ * Statistics for one stage over the last completed window
+ * All times in microseconds
+ */
+typedef struct {
+    uint16_t min_us;
+    uint16_t avg_us;
+    uint16_t max_us;
+} LatencyStats;
+
+/*============================================================================
+ * LATENCY OPERATIONS
+ *==========================================================================*/
+
+#ifdef LATENCY_TEST
+
+/**
+ * Reset the statistics and set up the serial port (and the probe pin)
+ */
+void init_latency(void);
+
+/**
+ * Record a button edge (from record_button_edge(), interrupt context)
+ * @param pressed 1 for a press, 0 for a release (ignored)
+ */
+void latency_edge(uint8_t pressed);
+
+/**
+ * Record that a button event reached the game
+ * @param pressed 1 for a press, 0 for a release (ignored)
+ */
+void latency_dispatch(uint8_t pressed);
+
+/**
+ * Invert the marker if a dispatched press waits for its frame
+ * Call after the frame is drawn, right before it is refreshed
+ */
+void latency_draw_marker(void);
+
+/**
+ * Record that a display run was sent (from the refresh, may be the SPI
+ * interrupt); completes the measurement when it covers the marker
+ * @param page Page of the run
+ * @param column First column of the run
+ * @param length Columns in the run
+ */
+void latency_run_sent(uint8_t page, uint8_t column, uint8_t length);
+
+/**
+ * Get the stats of the last completed window
+ * @param stage Stage to query
+ * @return Min/avg/max in microseconds
+ */
+LatencyStats latency_get_stats(LatencyStage stage);
+
+#define LATENCY_EDGE(pressed)                 latency_edge(pressed)
+#define LATENCY_DISPATCH(pressed)             latency_dispatch(pressed)
+#define LATENCY_DRAW_MARKER()                 latency_draw_marker()
+#define LATENCY_RUN_SENT(page, column, length) latency_run_sent(page, column, length)
+
+#else
+
+#define LATENCY_EDGE(pressed)                 ((void)0)
+#define LATENCY_DISPATCH(pressed)             ((void)0)
+#define LATENCY_DRAW_MARKER()                 ((void)0)
+#define LATENCY_RUN_SENT(page, column, length) ((void)0)
+
+#endif // LATENCY_TEST
+
+#endif // LATENCY_H
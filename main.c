@@ -4,27 +4,148 @@
  * Created: 10/27/2024 9:03:11 PM
  * Author: Wes Orr
  */
-#include <xc.h>
+#include "hal.h"
 #include "sh1106_graphics.h"
 #include "game_controller.h"
+#include "timer.h"
+#include "power.h"
+#include "profiler.h"
+#include "latency.h"
+#include "telemetry.h"
+#include "bench.h"
+#include "shapes.h"
+#include "io_hardware.h"
+
+#ifndef HAL_HOST
+// Everything is allocated statically: fail the build if the worst case
+// no longer fits next to the stack (breakdown: host/memory_report.c)
+_Static_assert(GAME_STATIC_RAM_BYTES + GAME_STACK_RESERVE_BYTES <= HAL_SRAM_BYTES,
+               "static RAM footprint exceeds SRAM");
+#endif
+
+// Game state is static so its size is accounted at link time, not on the stack
+static GameController game;
 
 int main(void) {
-    // Initialize display (includes SPI setup)
-    initScreen();
+    // Main clock of the clock profile (clock.h): every rate below follows it
+    hal_clock_init();
+
+    // Counter for delays and the boot time
+    init_delay();
+
+    // Reset and configure the display (includes SPI setup); the game is
+    // set up while the panel powers up
+    beginScreenInit();
 
-    // Initialize game controller (creates all objects and input controller)
-    GameController game;
+    // Initialize game controller (takes all objects from the static pools)
     init_game_controller(&game);
 
+    // Deterministic sessions (replay.h): log the inputs to EEPROM, or play
+    // the log back, from the first update
+#if defined(REPLAY_RECORD)
+    input_controller_start_recording(&game.input_ctrl);
+#elif defined(REPLAY_PLAYBACK)
+    input_controller_start_replay(&game.input_ctrl);
+#endif
+
+    endScreenInit();
+
+#ifdef BENCH_MODE
+    // Benchmark build (bench.h): report over USART0 once, before any
+    // interrupt can disturb the timings, then stop
+    bench_report_serial(&game);
+    while (1) {
+    }
+#endif
+
+    // Tick timer and async display refresh both run from interrupts
+    init_timer();
+    init_power();
+#ifdef PROFILER_ENABLED
+    init_profiler();
+#endif
+#ifdef LATENCY_TEST
+    init_latency();
+#endif
+#ifdef TELEMETRY_ENABLED
+    init_telemetry();
+#endif
+    hal_interrupts_enable();
+
+    uint16_t next_tick = timer_ticks();
+    uint8_t frame_stale = 1;
+#ifdef PROFILER_ENABLED
+    uint8_t overlay_shown = 0;
+#endif
+
     // Game loop
     while (1) {
-        // Update game state (input, paddle positions, collisions)
-        update_game_controller(&game);
+        // PROFILE_FRAME times the work of one pass (ticks and render),
+        // never the sleep between passes
+        PROFILE_BEGIN(PROFILE_FRAME);
+        uint8_t ticks_run = 0;
+        uint8_t rendered = 0;
+
+        // Simulation: run every tick that has elapsed, never skip one
+        // (catches up after a slow frame)
+        if (timer_tick_elapsed(next_tick)) {
+            while (timer_tick_elapsed(next_tick)) {
+                update_game_controller(&game);
+                power_tick(game_controller_idle(&game));
+                next_tick++;
+                if (ticks_run < 255) ticks_run++;
+            }
+            PROFILE_TICKS_RUN(ticks_run);
+            frame_stale = 1;
+        }
+
+        // Render: only when the game changed and the display link is free;
+        // frames are dropped rather than delaying simulation ticks
+        if (frame_stale && !displayBusy()) {
+            PROFILE_BEGIN(PROFILE_DRAW);
+#ifdef PROFILER_ENABLED
+            // The overlay covers the retained frame: redraw fully when it comes or goes
+            if (profiler_overlay_visible() != overlay_shown) {
+                overlay_shown = profiler_overlay_visible();
+                invalidate_game_display(&game);
+            }
+#endif
+            draw_game_controller(&game);                                     // Erases and redraws moved items only
+#ifdef PROFILER_ENABLED
+            if (overlay_shown) profiler_draw_overlay();
+#endif
+            LATENCY_DRAW_MARKER();                                           // Latency test: flip the marker
+            PROFILE_END(PROFILE_DRAW);
+
+            PROFILE_BEGIN(PROFILE_REFRESH);
+            if (displayChanged()) {
+                refreshDisplayAsync();                                       // Static screens send nothing
+            }
+            PROFILE_END(PROFILE_REFRESH);
+            rendered = 1;
+            frame_stale = 0;
+        }
+
+        // Passes woken by other interrupts did no work: no sample
+        if (ticks_run > 0 || rendered) {
+            PROFILE_END(PROFILE_FRAME);
+        }
+        if (rendered) {
+            PROFILE_FRAME_DONE();
+        }
+
+        // Boot ends when the first frame has reached the panel
+        if (frame_stale == 0 && !displayBusy()) {
+            timer_mark_boot_done();
+        }
 
-        // Render
-        clearDisplay();
-        draw_game_controller(&game);
-        refreshDisplay();
+        // Nothing to do until the next interrupt (tick, SPI, ADC, button):
+        // sleep; checked with interrupts off so no wake-up is missed
+        uint8_t irq_state = hal_interrupts_disable();
+        if (!timer_tick_elapsed(next_tick) && !(frame_stale && !displayBusy())) {
+            power_sleep();
+        }
+        hal_interrupts_restore(irq_state);
     }
 
     // Cleanup (never reached)
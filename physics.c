@@ -18,43 +18,105 @@
 #define abs(x) ((x) < 0 ? -(x) : (x))
 #endif
 
+/*============================================================================
+ * FIXED POINT HELPERS
+ *==========================================================================*/
+
+static FixedPoint to_fixed_point(Point p) {
+    return (FixedPoint){(uint16_t)p.x << FIXED_SHIFT, (uint16_t)p.y << FIXED_SHIFT};
+}
+
+static FixedVector to_fixed_vector(Vector2D v) {
+    return (FixedVector){INT_TO_FIXED(v.x), INT_TO_FIXED(v.y)};
+}
+
+/**
+ * Round a Q8.8 position to whole pixels
+ */
+static Point to_point(FixedPoint p) {
+    return (Point){(uint8_t)((p.x + FIXED_HALF) >> FIXED_SHIFT),
+                   (uint8_t)((p.y + FIXED_HALF) >> FIXED_SHIFT)};
+}
+
+/**
+ * Current position in whole pixels (what collisions are checked against)
+ */
+static Point physics_point(PhysicsObject* obj) {
+    return to_point(obj->position);
+}
+
+static void update_world_bounds(PhysicsObject* obj);
+
+/**
+ * Move the visual to the current position and refresh cached bounds
+ */
+static void sync_object(PhysicsObject* obj) {
+    obj->visual.origin = physics_point(obj);
+    if (obj->world != NULL) {
+        update_world_bounds(obj);
+    }
+}
+
+/**
+ * Linear interpolation of one Q8.8 coordinate
+ */
+static uint16_t lerp_fixed(uint16_t from, uint16_t to, uint16_t alpha) {
+    int16_t delta = (int16_t)(to - from);
+    return from + (uint16_t)(int16_t)(((int32_t)delta * alpha) >> FIXED_SHIFT);
+}
+
 /*============================================================================
  * PHYSICS OBJECT INITIALIZATION
  *==========================================================================*/
 
+/**
+ * Set up everything but the shape
+ */
+static void init_body(PhysicsObject* obj, Point position, Vector2D velocity,
+                      CollisionCallback callback) {
+    obj->position = to_fixed_point(position);
+    obj->previous = obj->position;
+    obj->velocity = to_fixed_vector(velocity);
+    obj->acceleration = (FixedVector){0, 0};
+    obj->on_collision = callback;
+    obj->collision_enabled = 1;
+    obj->is_static = 0;
+    obj->world = NULL;
+    obj->world_slot = 0;
+}
+
 void init_physics(PhysicsObject* obj, Point position, Vector2D velocity,
                   ShapeType type, ShapeParams params,
                   CollisionCallback callback) {
     if (obj == NULL) return;
 
-    Shape* shape = NULL;
+    init_body(obj, position, velocity, callback);
 
-    // Create shape based on type
+    // Shape built in place (a pool sprite belongs to obj->visual)
     if (type == SHAPE_CIRCLE) {
-        shape = create_circle(position, params.circle.radius,
-                            params.circle.is_filled, params.circle.color);
+        create_circle(&obj->visual, position, params.circle.radius,
+                      params.circle.is_filled, params.circle.color);
     } else if (type == SHAPE_RECTANGLE) {
-        shape = create_rectangle(position, params.rect.width, params.rect.height,
-                               params.rect.anchor, params.rect.is_filled,
-                               params.rect.color);
+        init_rectangle(&obj->visual, position, params.rect.width, params.rect.height,
+                       params.rect.anchor, params.rect.is_filled, params.rect.color);
+    } else {
+        obj->visual.origin = position;
+        obj->visual.type = SHAPE_NONE;
     }
+}
 
-    if (shape == NULL) return;  // Handle allocation failure
+void init_physics_shape(PhysicsObject* obj, Point position, Vector2D velocity,
+                        const Shape* visual, CollisionCallback callback) {
+    if (obj == NULL || visual == NULL) return;
 
-    // Initialize physics object
-    obj->position = position;
-    obj->velocity = velocity;
-    obj->acceleration.x = 0;
-    obj->acceleration.y = 0;
-    obj->visual = shape;
-    obj->on_collision = callback;
-    obj->collision_enabled = 1;
+    init_body(obj, position, velocity, callback);
+    obj->visual = *visual;
+    obj->visual.origin = position;
 }
 
 void destroy(PhysicsObject* obj) {
-    if (obj != NULL && obj->visual != NULL) {
-        destroy_shape(obj->visual);
-        obj->visual = NULL;
+    if (obj != NULL) {
+        destroy_shape(&obj->visual);
     }
 }
 
@@ -65,198 +127,560 @@ void destroy(PhysicsObject* obj) {
 void move(PhysicsObject* obj, Vector2D delta) {
     if (obj == NULL) return;
     
-    // Update position
-    obj->position.x += delta.x;
-    obj->position.y += delta.y;
+    // Update position (whole pixels, fraction kept)
+    obj->position.x += (uint16_t)INT_TO_FIXED(delta.x);
+    obj->position.y += (uint16_t)INT_TO_FIXED(delta.y);
     
     // Sync visual shape position
-    if (obj->visual != NULL) {
-        obj->visual->origin = obj->position;  // Direct access!
-    }
+    sync_object(obj);
 }
 
 void update(PhysicsObject* obj) {
     if (obj == NULL) return;
     
-    // Apply velocity (move by velocity vector)
-    move(obj, obj->velocity);
+    // Interpolation runs from here to the new position
+    obj->previous = obj->position;
+    
+    // Semi-implicit Euler: acceleration first, then the new velocity
+    obj->velocity.x += obj->acceleration.x;
+    obj->velocity.y += obj->acceleration.y;
+    obj->position.x += (uint16_t)obj->velocity.x;
+    obj->position.y += (uint16_t)obj->velocity.y;
+    
+    sync_object(obj);
+}
+
+void interpolate_physics(PhysicsObject* obj, uint16_t alpha) {
+    if (obj == NULL) return;
     
-    // Note: Acceleration is not applied yet (reserved for future use)
-    // When needed, add before move():
-    // obj->velocity.x += obj->acceleration.x;
-    // obj->velocity.y += obj->acceleration.y;
+    FixedPoint drawn = {
+        lerp_fixed(obj->previous.x, obj->position.x, alpha),
+        lerp_fixed(obj->previous.y, obj->position.y, alpha)
+    };
+    obj->visual.origin = to_point(drawn);
+}
+
+void settle_physics(PhysicsObject* obj) {
+    if (obj != NULL) {
+        obj->previous = obj->position;
+        if (obj->world != NULL) {
+            update_world_bounds(obj);
+        }
+    }
 }
 
 /*============================================================================
  * COLLISION DETECTION HELPERS
  *==========================================================================*/
 
-/**
- * Check collision between two circles
- */
-static uint8_t check_circle_circle_collision(PhysicsObject* objA, PhysicsObject* objB) {
-    CircleData* circleA = (CircleData*)(objA->visual->shape_data);
-    CircleData* circleB = (CircleData*)(objB->visual->shape_data);
-    
-    int16_t dx = objA->position.x - objB->position.x;
-    int16_t dy = objA->position.y - objB->position.y;
-    int16_t distance_squared = dx * dx + dy * dy;
-    int16_t radius_sum = circleA->radius + circleB->radius;
-    int16_t radius_sum_squared = radius_sum * radius_sum;
-    
-    return (distance_squared <= radius_sum_squared);
-}
+// Contact handed to the callbacks of the collision being reported
+static Contact active_contact;
 
 /**
- * Check collision between circle and rectangle
+ * Calculate rectangle corners (inclusive) at an origin based on anchor
  */
-static uint8_t check_circle_rect_collision(PhysicsObject* circle_obj, PhysicsObject* rect_obj) {
-    CircleData* circle = (CircleData*)(circle_obj->visual->shape_data);
-    RectangleData* rect = (RectangleData*)(rect_obj->visual->shape_data);
-    
-    // Calculate actual rectangle corners based on anchor
-    Point top_left, bottom_right;
-    Point rect_origin = rect_obj->visual->origin;  // Direct access!
-    
+static void rect_corners(const RectangleData* rect, Point origin, Point* top_left, Point* bottom_right) {
     switch (rect->anchor) {
         case ANCHOR_TOP_LEFT:
-            top_left = rect_origin;
-            bottom_right.x = rect_origin.x + rect->width;
-            bottom_right.y = rect_origin.y + rect->height;
+            *top_left = origin;
+            bottom_right->x = origin.x + rect->width;
+            bottom_right->y = origin.y + rect->height;
             break;
         case ANCHOR_BOTTOM_LEFT:
-            top_left.x = rect_origin.x;
-            top_left.y = rect_origin.y - rect->height;
-            bottom_right.x = rect_origin.x + rect->width;
-            bottom_right.y = rect_origin.y;
+            top_left->x = origin.x;
+            top_left->y = origin.y - rect->height;
+            bottom_right->x = origin.x + rect->width;
+            bottom_right->y = origin.y;
             break;
         case ANCHOR_CENTER:
-            top_left.x = rect_origin.x - rect->width / 2;
-            top_left.y = rect_origin.y - rect->height / 2;
-            bottom_right.x = rect_origin.x + rect->width / 2;
-            bottom_right.y = rect_origin.y + rect->height / 2;
+        default:
+            top_left->x = origin.x - rect->width / 2;
+            top_left->y = origin.y - rect->height / 2;
+            bottom_right->x = origin.x + rect->width / 2;
+            bottom_right->y = origin.y + rect->height / 2;
             break;
     }
+}
+
+/**
+ * Normal of the side with the least penetration (for already overlapping boxes)
+ * @param to_low Distance inside the low edge of the axis (x then y)
+ * @param to_high Distance inside the high edge of the axis (x then y)
+ */
+static Vector2D least_penetration_normal(int32_t to_low_x, int32_t to_high_x,
+                                         int32_t to_low_y, int32_t to_high_y) {
+    int32_t depth_x = (to_low_x < to_high_x) ? to_low_x : to_high_x;
+    int32_t depth_y = (to_low_y < to_high_y) ? to_low_y : to_high_y;
+
+    if (depth_x < depth_y) {
+        return (Vector2D){(to_low_x < to_high_x) ? -1 : 1, 0};
+    }
+    return (Vector2D){0, (to_low_y < to_high_y) ? -1 : 1};
+}
+
+/**
+ * Fraction of the step at which a moving coordinate covers an offset (Q8.8)
+ * Same result as (offset * FIXED_ONE) / delta, rounded toward zero, but by
+ * shift and subtract (the core has no divider). Only fractions within the
+ * step matter to a sweep, so larger ones saturate at +-(FIXED_ONE + 1).
+ */
+static int32_t step_fraction(int32_t offset, int32_t delta) {
+    uint8_t negative = (offset < 0) != (delta < 0);
+    uint32_t remainder = (uint32_t)((offset < 0) ? -offset : offset) << FIXED_SHIFT;
+    uint32_t divisor = (uint32_t)((delta < 0) ? -delta : delta);
+
+    int32_t fraction = FIXED_ONE + 1;
+    if (remainder < (uint32_t)(FIXED_ONE + 1) * divisor) {
+        // Quotient up to FIXED_ONE: FIXED_SHIFT + 1 bits
+        fraction = 0;
+        for (int8_t bit = FIXED_SHIFT; bit >= 0; bit--) {
+            if (remainder >= divisor << bit) {
+                remainder -= divisor << bit;
+                fraction |= (int32_t)1 << bit;
+            }
+        }
+    }
+    return negative ? -fraction : fraction;
+}
+
+/**
+ * Clip a moving coordinate against one slab [low, high] (Q8.8)
+ * Narrows [*enter, *exit] (fractions of the step, Q8.8); when this slab is
+ * entered last, *normal becomes its face normal
+ * @param is_x 1 for the X slab, 0 for the Y slab
+ * @return 0 if the motion misses the slab entirely
+ */
+static uint8_t clip_slab(int32_t start, int32_t delta, int32_t low, int32_t high, uint8_t is_x,
+                         int32_t* enter, int32_t* exit, Vector2D* normal) {
+    if (delta == 0) {
+        return start >= low && start <= high;                                // Parallel: inside or never
+    }
+
+    int32_t t_near, t_far;
+    int8_t face;
+    if (delta > 0) {
+        t_near = step_fraction(low - start, delta);
+        t_far = step_fraction(high - start, delta);
+        face = -1;                                                           // Entering through the low side
+    } else {
+        t_near = step_fraction(high - start, delta);
+        t_far = step_fraction(low - start, delta);
+        face = 1;
+    }
+
+    if (t_near > *enter) {
+        *enter = t_near;
+        *normal = is_x ? (Vector2D){face, 0} : (Vector2D){0, face};
+    }
+    if (t_far < *exit) *exit = t_far;
+    return *enter <= *exit;
+}
+
+/**
+ * Test a circle centre (Q8.8) against a rectangle (inclusive pixel corners)
+ * @param normal Set to the axis separating them (toward the circle)
+ * @return 1 if the circle touches the rectangle
+ */
+static uint8_t circle_touches_rect(int32_t center_x, int32_t center_y, Point top_left,
+                                   Point bottom_right, int16_t radius, Vector2D* normal) {
+    int32_t left = (int32_t)top_left.x * FIXED_ONE;
+    int32_t right = (int32_t)bottom_right.x * FIXED_ONE;
+    int32_t top = (int32_t)top_left.y * FIXED_ONE;
+    int32_t bottom = (int32_t)bottom_right.y * FIXED_ONE;
     
-    // Find closest point on rectangle to circle center
-    Point circle_center = circle_obj->visual->origin;  // Direct access!
-    int16_t closest_x = circle_center.x;
-    int16_t closest_y = circle_center.y;
+    // Offset from the closest point on the rectangle
+    int32_t dx = 0, dy = 0;
+    if (center_x < left) dx = center_x - left;
+    else if (center_x > right) dx = center_x - right;
+    if (center_y < top) dy = center_y - top;
+    else if (center_y > bottom) dy = center_y - bottom;
     
-    if (circle_center.x < top_left.x) closest_x = top_left.x;
-    else if (circle_center.x > bottom_right.x) closest_x = bottom_right.x;
+    int32_t reach = (int32_t)radius * FIXED_ONE;
+    if (dx * dx + dy * dy > reach * reach) return 0;
     
-    if (circle_center.y < top_left.y) closest_y = top_left.y;
-    else if (circle_center.y > bottom_right.y) closest_y = bottom_right.y;
+    if (dx == 0 && dy == 0) {
+        // Centre inside the rectangle
+        *normal = least_penetration_normal(center_x - left, right - center_x,
+                                           center_y - top, bottom - center_y);
+    } else if (abs(dx) > abs(dy)) {
+        *normal = (Vector2D){(dx < 0) ? -1 : 1, 0};
+    } else {
+        *normal = (Vector2D){0, (dy < 0) ? -1 : 1};
+    }
+    return 1;
+}
+
+/**
+ * Check collision between two circles
+ */
+static uint8_t check_circle_circle_collision(PhysicsObject* objA, PhysicsObject* objB) {
+    CircleData* circleA = &objA->visual.data.circle;
+    CircleData* circleB = &objB->visual.data.circle;
     
-    // Check if closest point is within circle radius
-    int16_t dx = circle_center.x - closest_x;
-    int16_t dy = circle_center.y - closest_y;
+    Point centerA = physics_point(objA);
+    Point centerB = physics_point(objB);
+    int16_t dx = centerA.x - centerB.x;
+    int16_t dy = centerA.y - centerB.y;
     int16_t distance_squared = dx * dx + dy * dy;
+    int16_t radius_sum = circleA->radius + circleB->radius;
+    int16_t radius_sum_squared = radius_sum * radius_sum;
+    
+    // Normal along the dominant axis of the centre offset (toward A)
+    active_contact.time = FIXED_ONE;
+    if (abs(dx) > abs(dy)) {
+        active_contact.normal = (Vector2D){(dx < 0) ? -1 : 1, 0};
+    } else {
+        active_contact.normal = (Vector2D){0, (dy < 0) ? -1 : 1};
+    }
     
-    return (distance_squared <= (circle->radius * circle->radius));
+    return (distance_squared <= radius_sum_squared);
 }
 
 /**
  * Check collision between two rectangles
  */
 static uint8_t check_rect_rect_collision(PhysicsObject* objA, PhysicsObject* objB) {
-    RectangleData* rectA = (RectangleData*)(objA->visual->shape_data);
-    RectangleData* rectB = (RectangleData*)(objB->visual->shape_data);
-    
-    Point origin1 = objA->visual->origin;
-    Point origin2 = objB->visual->origin;
+    RectangleData* rectA = &objA->visual.data.rect;
+    RectangleData* rectB = &objB->visual.data.rect;
     
     // Calculate actual corners for both rectangles
     Point top_leftA, bottom_rightA, top_leftB, bottom_rightB;
+    rect_corners(rectA, physics_point(objA), &top_leftA, &bottom_rightA);
+    rect_corners(rectB, physics_point(objB), &top_leftB, &bottom_rightB);
     
-    // Rectangle A
-    switch (rectA->anchor) {
-        case ANCHOR_TOP_LEFT:
-            top_leftA = origin1;
-            bottom_rightA.x = origin1.x + rectA->width;
-            bottom_rightA.y = origin1.y + rectA->height;
-            break;
-        case ANCHOR_BOTTOM_LEFT:
-            top_leftA.x = origin1.x;
-            top_leftA.y = origin1.y - rectA->height;
-            bottom_rightA.x = origin1.x + rectA->width;
-            bottom_rightA.y = origin1.y;
-            break;
-        case ANCHOR_CENTER:
-            top_leftA.x = origin1.x - rectA->width / 2;
-            top_leftA.y = origin1.y - rectA->height / 2;
-            bottom_rightA.x = origin1.x + rectA->width / 2;
-            bottom_rightA.y = origin1.y + rectA->height / 2;
-            break;
-    }
-    
-    // Rectangle B
-    switch (rectB->anchor) {
-        case ANCHOR_TOP_LEFT:
-            top_leftB = origin2;
-            bottom_rightB.x = origin2.x + rectB->width;
-            bottom_rightB.y = origin2.y + rectB->height;
-            break;
-        case ANCHOR_BOTTOM_LEFT:
-            top_leftB.x = origin2.x;
-            top_leftB.y = origin2.y - rectB->height;
-            bottom_rightB.x = origin2.x + rectB->width;
-            bottom_rightB.y = origin2.y;
-            break;
-        case ANCHOR_CENTER:
-            top_leftB.x = origin2.x - rectB->width / 2;
-            top_leftB.y = origin2.y - rectB->height / 2;
-            bottom_rightB.x = origin2.x + rectB->width / 2;
-            bottom_rightB.y = origin2.y + rectB->height / 2;
-            break;
+    // AABB collision check
+    if (bottom_rightA.x < top_leftB.x || top_leftA.x > bottom_rightB.x ||
+        bottom_rightA.y < top_leftB.y || top_leftA.y > bottom_rightB.y) {
+        return 0;
     }
     
-    // AABB collision check
-    return !(bottom_rightA.x < top_leftB.x || top_leftA.x > bottom_rightB.x ||
-             bottom_rightA.y < top_leftB.y || top_leftA.y > bottom_rightB.y);
+    // A is pushed out of B on the axis that overlaps least
+    active_contact.time = FIXED_ONE;
+    active_contact.normal = least_penetration_normal(
+        bottom_rightA.x - top_leftB.x, bottom_rightB.x - top_leftA.x,
+        bottom_rightA.y - top_leftB.y, bottom_rightB.y - top_leftA.y);
+    return 1;
 }
 
 /*============================================================================
  * COLLISION DETECTION
  *==========================================================================*/
 
-uint8_t check_collision(PhysicsObject* objA, PhysicsObject* objB) {
-    if (objA == NULL || objB == NULL) return 0;
-    if (objA->visual == NULL || objB->visual == NULL) return 0;
+uint8_t sweep_circle_rect(PhysicsObject* circle_obj, PhysicsObject* rect_obj, Contact* contact) {
+    CircleData* circle = &circle_obj->visual.data.circle;
+    RectangleData* rect = &rect_obj->visual.data.rect;
     
-    // Check if collision detection is enabled for both objects
-    if (!objA->collision_enabled || !objB->collision_enabled) return 0;
+    // Rectangle where it started the step, grown by the radius (Q8.8)
+    Point top_left, bottom_right;
+    rect_corners(rect, to_point(rect_obj->previous), &top_left, &bottom_right);
+    int32_t low_x  = ((int32_t)top_left.x - circle->radius) * FIXED_ONE;
+    int32_t high_x = ((int32_t)bottom_right.x + circle->radius) * FIXED_ONE;
+    int32_t low_y  = ((int32_t)top_left.y - circle->radius) * FIXED_ONE;
+    int32_t high_y = ((int32_t)bottom_right.y + circle->radius) * FIXED_ONE;
     
-    uint8_t collision = 0;
-    ShapeType a_type = get_shape_type(objA->visual);
-    ShapeType b_type = get_shape_type(objB->visual);
+    // Circle centre motion relative to the rectangle
+    int32_t start_x = circle_obj->previous.x;
+    int32_t start_y = circle_obj->previous.y;
+    int32_t delta_x = ((int32_t)circle_obj->position.x - circle_obj->previous.x)
+                    - ((int32_t)rect_obj->position.x - rect_obj->previous.x);
+    int32_t delta_y = ((int32_t)circle_obj->position.y - circle_obj->previous.y)
+                    - ((int32_t)rect_obj->position.y - rect_obj->previous.y);
+    
+    int32_t enter = 0;
+    int32_t exit = FIXED_ONE;
+    Vector2D normal = {0, 0};
+    
+    if (!clip_slab(start_x, delta_x, low_x, high_x, 1, &enter, &exit, &normal)) return 0;
+    if (!clip_slab(start_y, delta_y, low_y, high_y, 0, &enter, &exit, &normal)) return 0;
+    
+    // Where the centre meets the grown box
+    int32_t hit_x = start_x + (delta_x * enter) / FIXED_ONE;
+    int32_t hit_y = start_y + (delta_y * enter) / FIXED_ONE;
+    uint8_t beside_x = hit_x < (int32_t)top_left.x * FIXED_ONE || hit_x > (int32_t)bottom_right.x * FIXED_ONE;
+    uint8_t beside_y = hit_y < (int32_t)top_left.y * FIXED_ONE || hit_y > (int32_t)bottom_right.y * FIXED_ONE;
+    
+    if (normal.x == 0 && normal.y == 0) {
+        // Overlapping from the start of the step
+        if (circle_touches_rect(start_x, start_y, top_left, bottom_right, circle->radius, &normal)) {
+            contact->time = 0;
+            contact->normal = normal;
+            return 1;
+        }
+    } else if (!(beside_x && beside_y)) {
+        // Entered through a face
+        contact->time = (uint16_t)enter;
+        contact->normal = normal;
+        return 1;
+    }
+    
+    // Only the square corner of the grown box was crossed: the round
+    // corner may still be reached by the end of the step
+    if (!circle_touches_rect(start_x + delta_x, start_y + delta_y, top_left, bottom_right,
+                             circle->radius, &normal)) {
+        return 0;
+    }
+    contact->time = FIXED_ONE;
+    contact->normal = normal;
+    return 1;
+}
+
+/**
+ * Narrow phase for one pair (leaves the contact as seen by A in active_contact)
+ */
+static uint8_t test_pair(PhysicsObject* objA, PhysicsObject* objB) {
+    ShapeType a_type = (ShapeType)objA->visual.type;
+    ShapeType b_type = (ShapeType)objB->visual.type;
     
     // Determine which collision check to use
     if (a_type == SHAPE_CIRCLE && b_type == SHAPE_CIRCLE) {
-        collision = check_circle_circle_collision(objA, objB);
+        return check_circle_circle_collision(objA, objB);
     }
-    else if (a_type == SHAPE_CIRCLE && b_type == SHAPE_RECTANGLE) {
-        collision = check_circle_rect_collision(objA, objB);
+    if (a_type == SHAPE_CIRCLE && b_type == SHAPE_RECTANGLE) {
+        return sweep_circle_rect(objA, objB, &active_contact);
     }
-    else if (a_type == SHAPE_RECTANGLE && b_type == SHAPE_CIRCLE) {
-        collision = check_circle_rect_collision(objB, objA);
+    if (a_type == SHAPE_RECTANGLE && b_type == SHAPE_CIRCLE) {
+        uint8_t collision = sweep_circle_rect(objB, objA, &active_contact);
+        active_contact.normal.x = -active_contact.normal.x;
+        active_contact.normal.y = -active_contact.normal.y;
+        return collision;
     }
-    else if (a_type == SHAPE_RECTANGLE && b_type == SHAPE_RECTANGLE) {
-        collision = check_rect_rect_collision(objA, objB);
+    if (a_type == SHAPE_RECTANGLE && b_type == SHAPE_RECTANGLE) {
+        return check_rect_rect_collision(objA, objB);
     }
+    return 0;
+}
+
+/**
+ * Call both callbacks of a detected collision (normal flipped for B)
+ */
+static void notify_pair(PhysicsObject* objA, PhysicsObject* objB) {
+    Contact contact = active_contact;
+    if (objA->on_collision != NULL) {
+        objA->on_collision(objA, objB);
+    }
+    active_contact.time = contact.time;
+    active_contact.normal.x = -contact.normal.x;
+    active_contact.normal.y = -contact.normal.y;
+    if (objB->on_collision != NULL) {
+        objB->on_collision(objB, objA);
+    }
+}
+
+uint8_t check_collision(PhysicsObject* objA, PhysicsObject* objB) {
+    if (objA == NULL || objB == NULL) return 0;
+    
+    // Check if collision detection is enabled for both objects
+    if (!objA->collision_enabled || !objB->collision_enabled) return 0;
+    
+    uint8_t collision = test_pair(objA, objB);
     
     // If collision detected, call both callbacks
     if (collision) {
-        if (objA->on_collision != NULL) {
-            objA->on_collision(objA, objB);
+        notify_pair(objA, objB);
+    }
+    
+    return collision;
+}
+
+Contact get_collision_contact(void) {
+    return active_contact;
+}
+
+/*============================================================================
+ * PHYSICS WORLD
+ *==========================================================================*/
+
+_Static_assert(PHYSICS_WORLD_MAX_OBJECTS <= 8 * sizeof(PhysicsSlotMask), "PhysicsSlotMask too narrow");
+_Static_assert((PHYSICS_GRID_COLUMNS << PHYSICS_GRID_COLUMN_SHIFT) == WIDTH &&
+               (PHYSICS_GRID_ROWS << PHYSICS_GRID_ROW_SHIFT) == HEIGHT, "grid must tile the screen");
+
+/**
+ * Clamp a coordinate to the cached range (off-screen parts are dropped)
+ */
+static uint8_t clamp_bound(int16_t value) {
+    if (value < 0) return 0;
+    if (value > 255) return 255;
+    return (uint8_t)value;
+}
+
+/**
+ * Inclusive pixel box of an object's shape at an origin
+ */
+static void shape_box(PhysicsObject* obj, Point origin, Point* top_left, Point* bottom_right) {
+    if (obj->visual.type == SHAPE_CIRCLE) {
+        int16_t radius = obj->visual.data.circle.radius;
+        top_left->x = clamp_bound(origin.x - radius);
+        top_left->y = clamp_bound(origin.y - radius);
+        bottom_right->x = clamp_bound(origin.x + radius);
+        bottom_right->y = clamp_bound(origin.y + radius);
+    } else {
+        rect_corners(&obj->visual.data.rect, origin, top_left, bottom_right);
+    }
+}
+
+/**
+ * Grid cell of a cached coordinate (off-screen parts land in the edge cells)
+ */
+static uint8_t grid_column(uint8_t x) {
+    uint8_t column = x >> PHYSICS_GRID_COLUMN_SHIFT;
+    return (column < PHYSICS_GRID_COLUMNS) ? column : PHYSICS_GRID_COLUMNS - 1;
+}
+
+static uint8_t grid_row(uint8_t y) {
+    uint8_t row = y >> PHYSICS_GRID_ROW_SHIFT;
+    return (row < PHYSICS_GRID_ROWS) ? row : PHYSICS_GRID_ROWS - 1;
+}
+
+/**
+ * Cell range touched by a slot's cached bounds (inclusive)
+ */
+typedef struct {
+    uint8_t first_column;
+    uint8_t last_column;
+    uint8_t first_row;
+    uint8_t last_row;
+} GridCells;
+
+static GridCells grid_cells(PhysicsWorld* world, uint8_t slot) {
+    return (GridCells){grid_column(world->min_x[slot]), grid_column(world->max_x[slot]),
+                       grid_row(world->min_y[slot]), grid_row(world->max_y[slot])};
+}
+
+/**
+ * Add a slot to (or remove it from) every cell in a range
+ */
+static void mark_grid(PhysicsWorld* world, uint8_t slot, GridCells cells, uint8_t present) {
+    PhysicsSlotMask bit = (PhysicsSlotMask)1 << slot;
+    for (uint8_t row = cells.first_row; row <= cells.last_row; row++) {
+        for (uint8_t column = cells.first_column; column <= cells.last_column; column++) {
+            if (present) world->grid[row][column] |= bit;
+            else world->grid[row][column] &= (PhysicsSlotMask)~bit;
+        }
+    }
+}
+
+/**
+ * Slots sharing at least one cell with a slot (including itself)
+ */
+static PhysicsSlotMask grid_nearby(PhysicsWorld* world, uint8_t slot) {
+    GridCells cells = grid_cells(world, slot);
+    PhysicsSlotMask nearby = 0;
+    for (uint8_t row = cells.first_row; row <= cells.last_row; row++) {
+        for (uint8_t column = cells.first_column; column <= cells.last_column; column++) {
+            nearby |= world->grid[row][column];
         }
-        if (objB->on_collision != NULL) {
-            objB->on_collision(objB, objA);
+    }
+    return nearby;
+}
+
+/**
+ * Recompute the cached bounds: the shape at its previous and current
+ * position, so the box covers everything a swept test can touch.
+ * The grid is only touched when the covered cells change.
+ */
+static void update_world_bounds(PhysicsObject* obj) {
+    PhysicsWorld* world = obj->world;
+    uint8_t slot = obj->world_slot;
+    Point tl, br, prev_tl, prev_br;
+    shape_box(obj, physics_point(obj), &tl, &br);
+    shape_box(obj, to_point(obj->previous), &prev_tl, &prev_br);
+    
+    GridCells old_cells = grid_cells(world, slot);
+    world->min_x[slot] = (prev_tl.x < tl.x) ? prev_tl.x : tl.x;
+    world->min_y[slot] = (prev_tl.y < tl.y) ? prev_tl.y : tl.y;
+    world->max_x[slot] = (prev_br.x > br.x) ? prev_br.x : br.x;
+    world->max_y[slot] = (prev_br.y > br.y) ? prev_br.y : br.y;
+    GridCells new_cells = grid_cells(world, slot);
+    
+    if (old_cells.first_column != new_cells.first_column || old_cells.last_column != new_cells.last_column ||
+        old_cells.first_row != new_cells.first_row || old_cells.last_row != new_cells.last_row) {
+        mark_grid(world, slot, old_cells, 0);
+        mark_grid(world, slot, new_cells, 1);
+    }
+}
+
+void init_physics_world(PhysicsWorld* world) {
+    if (world == NULL) return;
+    world->object_count = 0;
+    world->contact_count = 0;
+    world->touched = 0;
+    world->circles = 0;
+    for (uint8_t row = 0; row < PHYSICS_GRID_ROWS; row++) {
+        for (uint8_t column = 0; column < PHYSICS_GRID_COLUMNS; column++) {
+            world->grid[row][column] = 0;
         }
     }
+}
+
+uint8_t physics_world_add(PhysicsWorld* world, PhysicsObject* obj) {
+    if (world == NULL || obj == NULL) return 0;
+    if (world->object_count == PHYSICS_WORLD_MAX_OBJECTS) return 0;
     
-    return collision;
+    uint8_t slot = world->object_count++;
+    obj->world = world;
+    obj->world_slot = slot;
+    world->objects[slot] = obj;
+    if (obj->visual.type == SHAPE_CIRCLE) {
+        world->circles |= (PhysicsSlotMask)1 << slot;
+    }
+    
+    // Enter the grid at cell (0, 0), then move to the real bounds
+    world->min_x[slot] = world->max_x[slot] = 0;
+    world->min_y[slot] = world->max_y[slot] = 0;
+    mark_grid(world, slot, grid_cells(world, slot), 1);
+    update_world_bounds(obj);
+    return 1;
+}
+
+uint8_t physics_world_step(PhysicsWorld* world) {
+    if (world == NULL) return 0;
+    world->contact_count = 0;
+    world->touched = 0;
+    
+    for (uint8_t i = 0; i < world->object_count; i++) {
+        PhysicsObject* objA = world->objects[i];
+        if (objA->is_static || !objA->collision_enabled || objA->visual.type == SHAPE_NONE) continue;
+        
+        // Only slots sharing a cell can touch (bit <= nearby: none left above);
+        // a rectangle only meets circles (paddles at their limits touch
+        // each other and the walls, which the game has no use for)
+        PhysicsSlotMask partners = (objA->visual.type == SHAPE_CIRCLE) ? (PhysicsSlotMask)~(PhysicsSlotMask)0
+                                                                       : world->circles;
+        PhysicsSlotMask nearby = grid_nearby(world, i) & partners;
+        PhysicsSlotMask bit = 1;
+        for (uint8_t j = 0; j < world->object_count && bit <= nearby; j++, bit <<= 1) {
+            if (!(nearby & bit)) continue;
+            
+            PhysicsObject* objB = world->objects[j];
+            if (j == i || !objB->collision_enabled || objB->visual.type == SHAPE_NONE) continue;
+            if (!objB->is_static && j < i) continue;                         // Moving pair already tested
+            
+            // Broadphase: cached step bounds must overlap
+            if (world->max_x[i] < world->min_x[j] || world->min_x[i] > world->max_x[j] ||
+                world->max_y[i] < world->min_y[j] || world->min_y[i] > world->max_y[j]) {
+                continue;
+            }
+            
+            if (!test_pair(objA, objB)) continue;
+            
+            world->touched |= ((PhysicsSlotMask)1 << i) | bit;
+            if (world->contact_count < PHYSICS_WORLD_MAX_CONTACTS) {
+                PhysicsContact* entry = &world->contacts[world->contact_count++];
+                entry->a = objA;
+                entry->b = objB;
+                entry->contact = active_contact;
+            }
+            notify_pair(objA, objB);                                         // May move objA
+            nearby = grid_nearby(world, i) & partners;                       // ... into other cells
+        }
+    }
+    
+    return world->contact_count;
+}
+
+uint8_t physics_world_touched(const PhysicsWorld* world, const PhysicsObject* obj) {
+    if (world == NULL || obj == NULL || obj->world != world) return 0;
+    return (world->touched >> obj->world_slot) & 1;
 }
 
 /*============================================================================
@@ -265,33 +689,69 @@ uint8_t check_collision(PhysicsObject* objA, PhysicsObject* objB) {
 
 void set_physics_position(PhysicsObject* obj, Point new_position) {
     if (obj != NULL) {
-        obj->position = new_position;
-        if (obj->visual != NULL) {
-            obj->visual->origin = new_position;  // Direct access!
-        }
+        obj->position = to_fixed_point(new_position);
+        obj->previous = obj->position;
+        sync_object(obj);
     }
 }
 
+void clamp_physics_position(PhysicsObject* obj, Point min, Point max) {
+    if (obj == NULL) return;
+    
+    FixedPoint lo = to_fixed_point(min);
+    FixedPoint hi = to_fixed_point(max);
+    if (obj->position.x < lo.x) obj->position.x = lo.x;
+    if (obj->position.x > hi.x) obj->position.x = hi.x;
+    if (obj->position.y < lo.y) obj->position.y = lo.y;
+    if (obj->position.y > hi.y) obj->position.y = hi.y;
+    sync_object(obj);
+}
+
 void set_physics_velocity(PhysicsObject* obj, Vector2D new_velocity) {
+    if (obj != NULL) {
+        obj->velocity = to_fixed_vector(new_velocity);
+    }
+}
+
+void set_physics_velocity_fx(PhysicsObject* obj, FixedVector new_velocity) {
     if (obj != NULL) {
         obj->velocity = new_velocity;
     }
 }
 
+void set_physics_acceleration_fx(PhysicsObject* obj, FixedVector new_acceleration) {
+    if (obj != NULL) {
+        obj->acceleration = new_acceleration;
+    }
+}
+
+void set_physics_static(PhysicsObject* obj, uint8_t is_static) {
+    if (obj != NULL) {
+        obj->is_static = is_static;
+    }
+}
+
 Point get_physics_position(PhysicsObject* obj) {
     if (obj != NULL) {
-        return obj->position;
+        return physics_point(obj);
     }
     return (Point){0, 0};
 }
 
 Vector2D get_physics_velocity(PhysicsObject* obj) {
     if (obj != NULL) {
-        return obj->velocity;
+        return (Vector2D){(int8_t)FIXED_TO_INT(obj->velocity.x), (int8_t)FIXED_TO_INT(obj->velocity.y)};
     }
     return (Vector2D){0, 0};
 }
 
+FixedVector get_physics_velocity_fx(PhysicsObject* obj) {
+    if (obj != NULL) {
+        return obj->velocity;
+    }
+    return (FixedVector){0, 0};
+}
+
 void set_physics_collision_enabled(PhysicsObject* obj, uint8_t enabled) {
     if (obj != NULL) {
         obj->collision_enabled = enabled;
@@ -309,29 +769,31 @@ uint8_t get_physics_collision_enabled(PhysicsObject* obj) {
  * COMMON COLLISION BEHAVIORS
  *==========================================================================*/
 
-void collision_bounce(PhysicsObject* self, PhysicsObject* other) {
-    // If other is a rectangle, use its dimensions
-    if (get_shape_type(other->visual) == SHAPE_RECTANGLE) {
-        RectangleData* rect = (RectangleData*)(other->visual->shape_data);
-        if (rect->height > rect->width) {
-            // Tall rectangle = vertical wall = bounce X
-            self->velocity.x = -self->velocity.x;
-        } else {
-            // Wide rectangle = horizontal wall = bounce Y
-            self->velocity.y = -self->velocity.y;
-        }
-    } else {
-        // Circle or unknown - use distance method
-        int16_t dx = self->position.x - other->position.x;
-        int16_t dy = self->position.y - other->position.y;
-        if (abs(dx) > abs(dy)) {
-            self->velocity.x = -self->velocity.x;
-        } else {
-            self->velocity.y = -self->velocity.y;
-        }
+/**
+ * Reflect one axis of a bounce
+ * Reverses velocity if it points into the surface and, for a swept hit,
+ * mirrors the end position about the point of impact
+ */
+static void bounce_axis(int16_t* velocity, uint16_t* position, uint16_t previous,
+                        int8_t normal, uint16_t time) {
+    if (normal == 0 || (int32_t)*velocity * normal >= 0) return;             // Already moving away
+
+    *velocity = -*velocity;
+    if (time > 0 && time < FIXED_ONE) {
+        uint16_t impact = lerp_fixed(previous, *position, time);
+        *position = (uint16_t)(2 * impact - *position);
     }
 }
 
+void collision_bounce(PhysicsObject* self, PhysicsObject* other) {
+    (void)other;                                                             // Normal comes from the contact
+    
+    Contact contact = get_collision_contact();
+    bounce_axis(&self->velocity.x, &self->position.x, self->previous.x, contact.normal.x, contact.time);
+    bounce_axis(&self->velocity.y, &self->position.y, self->previous.y, contact.normal.y, contact.time);
+    sync_object(self);
+}
+
 void collision_none(PhysicsObject* self, PhysicsObject* other) {
     // Do nothing - static object
     (void)self;   // Suppress unused parameter warning
@@ -6,6 +6,11 @@
  * Provides object-oriented physics interface with collision detection and
  * customizable collision response via callbacks.
  *
+ * Positions, velocities and accelerations are Q8.8 fixed point (integer
+ * math only), so objects can move at fractional speeds. Each update()
+ * keeps the previous position; interpolate_physics() places the visual
+ * between the two, so rendering can run faster than the physics step.
+ *
  * Architecture:
  *     main.c (game logic)
  *         ↓
@@ -27,14 +32,26 @@
  *                  SHAPE_CIRCLE, (ShapeParams){.circle = {5, 1, COLOR_WHITE}},
  *                  bounce);
  *
- *     // In game loop
- *     update(&ball);  // Applies velocity
+ *     // Fractional speed: 1.5 px/step right, 0.25 px/step² downward pull
+ *     set_physics_velocity_fx(&ball, (FixedVector){FIXED_ONE + FIXED_ONE/2, 0});
+ *     set_physics_acceleration_fx(&ball, (FixedVector){0, FIXED_ONE/4});
+ *
+ *     // Each physics step
+ *     update(&ball);  // Applies acceleration, then velocity
  *     check_collision(&ball, &paddle);
  *
- *     // Draw (call shape draw directly)
+ *     // Or let a world find the contacts (broadphase on cached boxes)
+ *     PhysicsWorld world;
+ *     init_physics_world(&world);
+ *     physics_world_add(&world, &ball);
+ *     physics_world_add(&world, &paddle);
+ *     uint8_t count = physics_world_step(&world);   // Callbacks run, contacts listed
+ *
+ *     // Draw (call shape draw directly), 'alpha' = fraction of the next step elapsed
  *     clearDisplay();
- *     draw(ball.visual);
- *     draw(paddle.visual);
+ *     interpolate_physics(&ball, alpha);
+ *     draw(&ball.visual);
+ *     draw(&paddle.visual);
  *     refreshDisplay();
  *==========================================================================*/
 
@@ -44,13 +61,40 @@
 #include <stdint.h>
 #include "shapes.h"
 
+/*============================================================================
+ * FIXED POINT
+ *==========================================================================*/
+
+#define FIXED_SHIFT 8                                   // Q8.8: 8 fractional bits
+#define FIXED_ONE   (1 << FIXED_SHIFT)                  // 1.0 (one pixel)
+#define FIXED_HALF  (FIXED_ONE / 2)
+
+#define INT_TO_FIXED(v)  ((int16_t)((v) * FIXED_ONE))
+#define FIXED_TO_INT(f)  ((int16_t)(((f) + FIXED_HALF) >> FIXED_SHIFT))   // Rounded to nearest
+
 /*============================================================================
  * TYPE DEFINITIONS
  *==========================================================================*/
 
 /**
- * 2D Vector for velocity and acceleration
- * Using int8_t for integer-based physics (signed for negative values)
+ * Q8.8 position (unsigned, 0.0 to 255.996 pixels)
+ */
+typedef struct {
+    uint16_t x;
+    uint16_t y;
+} FixedPoint;
+
+/**
+ * Q8.8 velocity or acceleration (signed, ±127.996 pixels per step)
+ */
+typedef struct {
+    int16_t x;
+    int16_t y;
+} FixedVector;
+
+/**
+ * 2D Vector in whole pixels
+ * Using int8_t for integer-based movement (signed for negative values)
  */
 typedef struct {
     int8_t x;
@@ -90,6 +134,7 @@ typedef union {
 
 // Forward declaration for callback type
 typedef struct PhysicsObject PhysicsObject;
+typedef struct PhysicsWorld PhysicsWorld;
 
 /**
  * Collision callback function type
@@ -99,17 +144,89 @@ typedef struct PhysicsObject PhysicsObject;
  */
 typedef void (*CollisionCallback)(PhysicsObject* self, PhysicsObject* other);
 
+/**
+ * Contact reported by a collision test
+ */
+typedef struct {
+    uint16_t time;                  // Time of impact within the last step (0 to FIXED_ONE)
+    Vector2D normal;                // Surface normal pointing toward the object (-1, 0 or 1 per axis)
+} Contact;
+
 /**
  * Physics Object structure
  * Combines position, velocity, acceleration with visual representation
  */
 struct PhysicsObject {
-    Point position;                 // Current position (screen coordinates)
-    Vector2D velocity;              // Velocity in pixels per frame
-    Vector2D acceleration;          // Acceleration (reserved for future use)
-    Shape* visual;                  // Visual representation (shape to draw)
+    FixedPoint position;            // Current position (Q8.8 screen coordinates)
+    FixedPoint previous;            // Position before the last update() (interpolation start)
+    FixedVector velocity;           // Velocity (Q8.8 pixels per physics step)
+    FixedVector acceleration;       // Acceleration (Q8.8 pixels per physics step²)
+    Shape visual;                   // Visual representation (drawn position, size)
     CollisionCallback on_collision; // Callback function when collision occurs
     uint8_t collision_enabled;      // 1 = check collisions, 0 = ignore
+    uint8_t is_static;              // 1 = never moves (drawn once into the static layer)
+    PhysicsWorld* world;            // World caching this object's bounds (NULL if none)
+    uint8_t world_slot;             // Index in the world's arrays
+};
+
+/*============================================================================
+ * PHYSICS WORLD
+ *==========================================================================*/
+
+#ifdef PANIC_MODE
+#define PHYSICS_WORLD_MAX_OBJECTS  20                   // 4 walls + 4 obstacles + 4 paddles + 8 balls
+#define PHYSICS_WORLD_MAX_CONTACTS 8                    // Contacts listed per step (all are in touched)
+#else
+#define PHYSICS_WORLD_MAX_OBJECTS  10                   // 4 walls + 4 paddles + ball (+1 spare)
+#define PHYSICS_WORLD_MAX_CONTACTS 4                    // Contacts listed per step (all are in touched)
+#endif
+
+// Broadphase grid over the screen: 4x4 cells of 32x16 pixels
+#define PHYSICS_GRID_COLUMN_SHIFT 5                     // Cell width 32 pixels
+#define PHYSICS_GRID_ROW_SHIFT    4                     // Cell height 16 pixels
+#define PHYSICS_GRID_COLUMNS      (WIDTH >> PHYSICS_GRID_COLUMN_SHIFT)
+#define PHYSICS_GRID_ROWS         (HEIGHT >> PHYSICS_GRID_ROW_SHIFT)
+
+/**
+ * One bit per world slot
+ */
+#if PHYSICS_WORLD_MAX_OBJECTS > 16
+typedef uint32_t PhysicsSlotMask;
+#else
+typedef uint16_t PhysicsSlotMask;
+#endif
+
+/**
+ * Contact between two objects found by physics_world_step()
+ */
+typedef struct {
+    PhysicsObject* a;               // Moving object
+    PhysicsObject* b;               // Object it touched
+    Contact contact;                // Time of impact and normal (toward a)
+} PhysicsContact;
+
+/**
+ * Set of objects tested against each other
+ * Bounds are cached per object (structure of arrays, inclusive pixels) and
+ * cover the whole last step. They are refreshed whenever an object moves,
+ * and so is the grid: each cell holds the slots whose bounds touch it.
+ * An object is only compared with the slots in its own cells (four
+ * compares per candidate pair), so the cost grows with the objects near
+ * it, not with the size of the world.
+ */
+struct PhysicsWorld {
+    PhysicsObject* objects[PHYSICS_WORLD_MAX_OBJECTS];
+    uint8_t min_x[PHYSICS_WORLD_MAX_OBJECTS];
+    uint8_t min_y[PHYSICS_WORLD_MAX_OBJECTS];
+    uint8_t max_x[PHYSICS_WORLD_MAX_OBJECTS];
+    uint8_t max_y[PHYSICS_WORLD_MAX_OBJECTS];
+    uint8_t object_count;
+    PhysicsSlotMask grid[PHYSICS_GRID_ROWS][PHYSICS_GRID_COLUMNS];
+    PhysicsSlotMask circles;        // Slots holding circles (the only partners of a rectangle)
+
+    PhysicsContact contacts[PHYSICS_WORLD_MAX_CONTACTS];
+    uint8_t contact_count;          // Contacts listed by the last step (at most PHYSICS_WORLD_MAX_CONTACTS)
+    PhysicsSlotMask touched;        // Slots in any contact of the last step, listed or not
 };
 
 /*============================================================================
@@ -117,8 +234,8 @@ struct PhysicsObject {
  *==========================================================================*/
 
 /**
- * Initialize a physics object with internal shape creation
- * Physics object now owns and creates its visual shape
+ * Initialize a physics object and build its visual shape in place
+ * Circles take a sprite from the shape pool (see create_circle())
  * @param obj Pointer to physics object to initialize
  * @param position Initial position (screen coordinates)
  * @param velocity Initial velocity
@@ -135,6 +252,19 @@ void init_physics(PhysicsObject* obj, Point position, Vector2D velocity,
                   ShapeType type, ShapeParams params,
                   CollisionCallback callback);
 
+/**
+ * Initialize a physics object with a copy of an existing shape
+ * A circle copy shares the original's sprite, so several objects can draw
+ * one raster; copies must not be drawn once the original is destroyed
+ * @param obj Pointer to physics object to initialize
+ * @param position Initial position (screen coordinates)
+ * @param velocity Initial velocity
+ * @param visual Initialized shape to copy
+ * @param callback Function to call on collision (can be NULL for no response)
+ */
+void init_physics_shape(PhysicsObject* obj, Point position, Vector2D velocity,
+                        const Shape* visual, CollisionCallback callback);
+
 /**
  * Destroy a physics object (frees internal shape)
  * The PhysicsObject itself is not freed (assumed static allocation)
@@ -142,75 +272,192 @@ void init_physics(PhysicsObject* obj, Point position, Vector2D velocity,
  */
 void destroy(PhysicsObject* obj);
 
+/*============================================================================
+ * PHYSICS WORLD OPERATIONS
+ *==========================================================================*/
+
+/**
+ * Initialize an empty world
+ * @param world Pointer to world
+ */
+void init_physics_world(PhysicsWorld* world);
+
+/**
+ * Add an object to a world (object must be initialized, at most one world)
+ * @param world Pointer to world
+ * @param obj Pointer to physics object
+ * @return 1 on success, 0 if the world is full
+ */
+uint8_t physics_world_add(PhysicsWorld* world, PhysicsObject* obj);
+
+/**
+ * Find and report all contacts of the last step
+ * Every pair with at least one non-static, collision-enabled object and at
+ * least one circle that shares a grid cell and whose cached bounds overlap
+ * is passed to the narrow phase (as check_collision()), in slot order;
+ * rectangles are never tested against each other;
+ * each hit runs both callbacks, marks both slots in world->touched and is
+ * appended to world->contacts while there is room (hits past
+ * PHYSICS_WORLD_MAX_CONTACTS still bounce and mark, but are not listed)
+ * @param world Pointer to world
+ * @return Number of contacts in world->contacts
+ */
+uint8_t physics_world_step(PhysicsWorld* world);
+
+/**
+ * Check whether an object was in any contact of the last step
+ * Complete even when the contact list was full
+ * @param world Pointer to world
+ * @param obj Pointer to physics object (added to this world)
+ * @return 1 if it touched something, 0 otherwise
+ */
+uint8_t physics_world_touched(const PhysicsWorld* world, const PhysicsObject* obj);
+
 /*============================================================================
  * PHYSICS SIMULATION
  *==========================================================================*/
 
 /**
  * Move physics object by a given delta
- * This is a general movement function that can be used for:
- * - Automatic physics updates (delta = velocity)
- * - Manual player control (delta = input)
+ * Manual movement (e.g. player control); does not affect velocity
  * @param obj Pointer to physics object to move
- * @param delta Movement vector to apply
+ * @param delta Movement vector to apply (whole pixels)
  */
 void move(PhysicsObject* obj, Vector2D delta);
 
 /**
- * Update physics object (applies velocity to position)
- * Convenience function that calls move() with the object's velocity
+ * Update physics object by one physics step
+ * Saves the current position for interpolation, adds acceleration to
+ * velocity, then velocity to position
  * @param obj Pointer to physics object to update
  */
 void update(PhysicsObject* obj);
 
+/**
+ * Place the visual between the previous and current position
+ * Collisions always use the current position; only drawing is affected.
+ * Objects that did not update() since their last teleport stay put.
+ * @param obj Pointer to physics object
+ * @param alpha Fraction of the way from previous to current (0 to FIXED_ONE)
+ */
+void interpolate_physics(PhysicsObject* obj, uint16_t alpha);
+
+/**
+ * Drop the interpolation start (previous = current)
+ * Call each physics step for objects that may not update() in it, so they
+ * are not drawn sliding back toward an old position
+ * @param obj Pointer to physics object
+ */
+void settle_physics(PhysicsObject* obj);
+
 /*============================================================================
  * COLLISION DETECTION
  *==========================================================================*/
 
 /**
  * Check collision between two physics objects
- * Uses bounding box collision based on shape type
+ * Circle vs rectangle is swept over the last step (previous → current
+ * position of both objects), so fast objects cannot pass through thin
+ * rectangles; other pairs are tested at the current position.
  * If collision detected AND both objects have collision_enabled:
- *   - Calls both objects' collision callbacks
+ *   - Calls both objects' collision callbacks (see get_collision_contact())
  * @param obj1 First physics object
  * @param obj2 Second physics object
  * @return 1 if collision detected, 0 otherwise
  */
 uint8_t check_collision(PhysicsObject* objA, PhysicsObject* objB);
 
+/**
+ * Swept circle vs rectangle test over the last physics step
+ * The circle moves from its previous to its current position relative to
+ * the rectangle (which may move too); the rectangle is grown by the radius.
+ * Starting inside reports time 0 and the axis of least penetration.
+ * @param circle_obj Object with a circle shape
+ * @param rect_obj Object with a rectangle shape
+ * @param contact Filled with time of impact and normal (toward the circle)
+ * @return 1 if they touch during the step, 0 otherwise
+ */
+uint8_t sweep_circle_rect(PhysicsObject* circle_obj, PhysicsObject* rect_obj, Contact* contact);
+
+/**
+ * Get the contact being reported
+ * Only valid inside a CollisionCallback; the normal points toward self
+ * @return Contact of the current collision
+ */
+Contact get_collision_contact(void);
+
 /*============================================================================
  * PROPERTY ACCESSORS
  *==========================================================================*/
 
 /**
- * Set the position of a physics object
+ * Set the position of a physics object (teleport: no interpolation)
  * Also updates the visual shape's position
  * @param obj Pointer to physics object
  * @param new_pos New position
  */
 void set_physics_position(PhysicsObject* obj, Point new_position);
 
+/**
+ * Clamp the current position to a box (bounds inclusive)
+ * Unlike set_physics_position(), interpolation from the previous position
+ * is kept, so an object sliding into a limit still moves smoothly
+ * @param obj Pointer to physics object
+ * @param min Minimum coordinates
+ * @param max Maximum coordinates
+ */
+void clamp_physics_position(PhysicsObject* obj, Point min, Point max);
+
 /**
  * Set the velocity of a physics object
  * @param obj Pointer to physics object
- * @param new_vel New velocity
+ * @param new_vel New velocity (whole pixels per physics step)
  */
 void set_physics_velocity(PhysicsObject* obj, Vector2D new_velocity);
 
+/**
+ * Set the velocity of a physics object with sub-pixel precision
+ * @param obj Pointer to physics object
+ * @param new_velocity New velocity (Q8.8 pixels per physics step)
+ */
+void set_physics_velocity_fx(PhysicsObject* obj, FixedVector new_velocity);
+
+/**
+ * Set the acceleration of a physics object
+ * @param obj Pointer to physics object
+ * @param new_acceleration New acceleration (Q8.8 pixels per physics step²)
+ */
+void set_physics_acceleration_fx(PhysicsObject* obj, FixedVector new_acceleration);
+
+/**
+ * Mark a physics object as static (immovable)
+ * Static objects are drawn once per state change instead of every frame
+ * @param obj Pointer to physics object
+ * @param is_static 1 if the object never moves
+ */
+void set_physics_static(PhysicsObject* obj, uint8_t is_static);
+
 /**
  * Get the current position of a physics object
  * @param obj Pointer to physics object
- * @return Current position
+ * @return Current position (rounded to whole pixels)
  */
 Point get_physics_position(PhysicsObject* obj);
 
 /**
  * Get the current velocity of a physics object
  * @param obj Pointer to physics object
- * @return Current velocity
+ * @return Current velocity (rounded to whole pixels per physics step)
  */
 Vector2D get_physics_velocity(PhysicsObject* obj);
 
+/**
+ * Get the current velocity of a physics object with sub-pixel precision
+ * @param obj Pointer to physics object
+ * @return Current velocity (Q8.8 pixels per physics step)
+ */
+FixedVector get_physics_velocity_fx(PhysicsObject* obj);
+
 /**
  * Enable or disable collision detection for an object
  * @param obj Pointer to physics object
@@ -230,7 +477,9 @@ uint8_t get_physics_collision_enabled(PhysicsObject* obj);
  *==========================================================================*/
 
 /**
- * Bounce behavior - reverses velocity component based on collision direction
+ * Bounce behavior - reflects velocity off the contact normal
+ * Only a component moving into the surface is reversed; for a swept hit the
+ * rest of the step is mirrored back out of the surface
  * This is a common callback you can use for bouncing objects
  * @param self The object that is bouncing
  * @param other The object it collided with
@@ -0,0 +1,112 @@
+/*============================================================================
+ * power.c
+ *============================================================================
+ * Power manager implementation
+ *==========================================================================*/
+
+#include "power.h"
+#include "hal.h"
+#include "io_hardware.h"
+#include "sh1106_graphics.h"
+#include "telemetry.h"
+#include <stddef.h>
+
+/*============================================================================
+ * POWER STATE
+ *==========================================================================*/
+
+static uint16_t idle_ticks = 0;                          // Consecutive idle ticks (saturates)
+static uint8_t display_asleep = 0;                       // Display off, ticks stopped
+
+// Sleep statistics: awake time is summed from counter reads taken between
+// sleeps, the rest of each second of ticks was spent asleep
+static uint32_t awake_counts = 0;                        // Awake counter cycles this second
+static uint16_t awake_since = 0;                         // Counter value at the last wake-up
+static uint8_t second_ticks = 0;                         // Ticks into the current second
+static uint16_t sleep_ms = 0;                            // Last complete second
+
+/**
+ * Switch the display back on and restart the tick
+ * The events of the waking press are dropped so it does not also act on
+ * the screen the player could not see
+ */
+static void wake_display(void) {
+    while (dispatch_button_event(NULL)) {}
+
+    sleepDisplay(0);
+    hal_tick_enable(1);
+    display_asleep = 0;
+    idle_ticks = 0;
+}
+
+/*============================================================================
+ * POWER OPERATIONS
+ *==========================================================================*/
+
+void init_power(void) {
+    idle_ticks = 0;
+    display_asleep = 0;
+    awake_counts = 0;
+    awake_since = hal_counter_read();
+    second_ticks = 0;
+    sleep_ms = 0;
+}
+
+void power_tick(uint8_t idle) {
+    if (!idle) {
+        idle_ticks = 0;
+    } else if (idle_ticks < 0xFFFF) {
+        idle_ticks++;
+    }
+
+    // Close the statistics second
+    if (++second_ticks == TICK_RATE_HZ) {
+        uint16_t now = hal_counter_read();
+        awake_counts += (uint16_t)(now - awake_since);
+        awake_since = now;
+
+        uint32_t awake_ms = (awake_counts * 1000UL) / HAL_COUNTER_HZ;
+        sleep_ms = (awake_ms >= 1000) ? 0 : (uint16_t)(1000 - awake_ms);
+        awake_counts = 0;
+        second_ticks = 0;
+    }
+
+    // Static screen left alone: display off, no more ticks until a button
+    if (idle_ticks >= POWER_DISPLAY_OFF_TICKS && !display_asleep) {
+        sleepDisplay(1);
+        hal_tick_enable(0);
+        display_asleep = 1;
+    }
+}
+
+void power_sleep(void) {
+    awake_counts += (uint16_t)(hal_counter_read() - awake_since);
+
+    // SPI and USART need the peripheral clock: only sleep deeper with the
+    // display link free and the telemetry ring empty
+    HalSleepMode mode = HAL_SLEEP_IDLE;
+    if (display_asleep && !TELEMETRY_BUSY()) {
+        mode = HAL_SLEEP_POWER_DOWN;
+    } else if (idle_ticks > 0 && !displayBusy() && !TELEMETRY_BUSY()) {
+        mode = HAL_SLEEP_STANDBY;
+    }
+
+    if (display_asleep && button_event_pending()) {
+        hal_interrupts_enable();                             // Woken before getting here
+    } else {
+        hal_sleep(mode);
+    }
+    awake_since = hal_counter_read();
+
+    if (display_asleep && button_event_pending()) {
+        wake_display();
+    }
+}
+
+uint8_t power_display_asleep(void) {
+    return display_asleep;
+}
+
+uint16_t power_sleep_ms(void) {
+    return sleep_ms;
+}
@@ -0,0 +1,96 @@
+/*============================================================================
+ * power.h
+ *============================================================================
+ * Power manager for the game loop
+ *
+ * Puts the core to sleep whenever the loop has nothing to do:
+ * - IDLE between ticks while the game is interactive (SPI, ADC and timers
+ *   keep running, so display streaming and joystick sampling continue)
+ * - STANDBY in static screens (title, pause, game over) once the display
+ *   link is free and the telemetry ring (telemetry.h) has been sent; the
+ *   tick and the buttons wake it
+ * - After POWER_DISPLAY_OFF_TICKS of a static screen the display is put to
+ *   sleep, the tick is stopped and the core sleeps in POWER_DOWN until a
+ *   button changes. The waking press only switches the display back on.
+ *
+ * Time spent asleep is measured with the HAL counter (awake time is
+ * counted, the rest of each second is sleep; interrupt handlers that run
+ * during sleep count as sleep).
+ *
+ * Architecture:
+ *     main.c (decides there is nothing to do, calls power_sleep())
+ *         ↓
+ *     power.c (sleep mode, display timeout, sleep statistics)
+ *         ↓
+ *     hal.h (SLPCTRL / RTC on the ATtiny1627, or host mock)
+ *
+ * USAGE:
+ *     init_power();
+ *
+ *     while (1) {
+ *         while (timer_tick_elapsed(next_tick)) {
+ *             update_game_controller(&game);
+ *             power_tick(game_controller_idle(&game));
+ *             next_tick++;
+ *         }
+ *         // ... render ...
+ *
+ *         uint8_t irq = hal_interrupts_disable();
+ *         if (!timer_tick_elapsed(next_tick)) power_sleep();
+ *         hal_interrupts_restore(irq);
+ *     }
+ *
+ *     uint16_t asleep = power_sleep_ms();  // Sleep in the last second
+ *==========================================================================*/
+
+#ifndef POWER_H
+#define POWER_H
+
+#include <stdint.h>
+#include "timer.h"
+
+/*============================================================================
+ * POWER CONFIGURATION
+ *==========================================================================*/
+
+#define POWER_DISPLAY_OFF_TICKS (30 * TICK_RATE_HZ)     // Static screen time before the display sleeps
+
+/*============================================================================
+ * POWER OPERATIONS
+ *==========================================================================*/
+
+/**
+ * Initialize the power manager (display on, statistics cleared)
+ */
+void init_power(void);
+
+/**
+ * Account one tick
+ * Call once per tick, after update_game_controller()
+ * @param idle 1 if the game is on a static screen and nothing happened
+ *             this tick, 0 otherwise (restarts the display timeout)
+ */
+void power_tick(uint8_t idle);
+
+/**
+ * Sleep until the next interrupt
+ * Call with interrupts disabled (hal_interrupts_disable()) after checking
+ * that no tick is due and nothing waits to be drawn; returns with
+ * interrupts enabled. Picks the deepest mode the current state allows and
+ * wakes the display when a button woke the core from POWER_DOWN.
+ */
+void power_sleep(void);
+
+/**
+ * Check whether the display is asleep (ticks stopped)
+ * @return 1 while asleep, 0 otherwise
+ */
+uint8_t power_display_asleep(void);
+
+/**
+ * Get the time spent asleep during the last complete second of ticks
+ * @return Milliseconds asleep (0-1000)
+ */
+uint16_t power_sleep_ms(void);
+
+#endif // POWER_H
@@ -0,0 +1,262 @@
+/*============================================================================
+ * profiler.c
+ *============================================================================
+ * Per-phase frame profiler implementation
+ * Compiles to nothing unless PROFILER_ENABLED is defined
+ *==========================================================================*/
+
+#include "profiler.h"
+
+#ifdef PROFILER_ENABLED
+
+#include <stddef.h>
+#include "hal.h"
+#include "sh1106_graphics.h"
+#include "shapes.h"
+#include "telemetry.h"
+#include "text.h"
+#include "timer.h"
+
+/*============================================================================
+ * INTERNAL STATE
+ *==========================================================================*/
+
+// Microseconds per counter tick in Q8 (computed at compile time)
+#define PROFILER_US_PER_COUNT_Q8 ((1000000UL * 256UL + PROFILER_TIMER_HZ / 2) / PROFILER_TIMER_HZ)
+
+/**
+ * Running totals for one phase in the current window (counter ticks)
+ */
+typedef struct {
+    uint16_t start;         // Counter value at profiler_begin()
+    uint16_t min;
+    uint16_t max;
+    uint32_t sum;
+    uint16_t count;
+} PhaseAccumulator;
+
+static PhaseAccumulator accumulators[PROFILE_PHASE_COUNT];
+static ProfileStats published[PROFILE_PHASE_COUNT];
+static uint16_t window_misses = 0;
+static uint16_t published_misses = 0;
+static uint16_t worst_frame_us = 0;                                          // Since init
+static uint32_t total_misses = 0;
+static uint8_t window_frames = 0;
+static uint8_t overlay_visible = 0;
+
+// One-letter labels: Input, Physics, Collision, Draw, Refresh, Frame
+static const char PHASE_LABELS[PROFILE_PHASE_COUNT] = {'I', 'P', 'C', 'D', 'R', 'F'};
+
+/*============================================================================
+ * HELPER FUNCTIONS
+ *==========================================================================*/
+
+/**
+ * Convert counter ticks to microseconds (saturates at 65535)
+ */
+static uint16_t counts_to_us(uint32_t counts) {
+    uint32_t us = (counts * PROFILER_US_PER_COUNT_Q8) >> 8;
+    return (us > 0xFFFF) ? 0xFFFF : (uint16_t)us;
+}
+
+/**
+ * Clear all accumulators for a new window
+ */
+static void reset_window(void) {
+    for (uint8_t i = 0; i < PROFILE_PHASE_COUNT; i++) {
+        accumulators[i].min = 0xFFFF;
+        accumulators[i].max = 0;
+        accumulators[i].sum = 0;
+        accumulators[i].count = 0;
+    }
+    window_misses = 0;
+    window_frames = 0;
+}
+
+#ifdef PROFILER_SERIAL
+/**
+ * Blocking serial writer (debug builds only - a report takes a few ms)
+ */
+static void serial_write(char c) {
+    hal_serial_write((uint8_t)c);
+}
+
+static void serial_write_number(uint32_t number) {
+    char digits[10];
+    uint8_t count = 0;
+    do {
+        digits[count++] = '0' + (number % 10);
+        number /= 10;
+    } while (number > 0);
+    while (count > 0) {
+        serial_write(digits[--count]);
+    }
+}
+
+/**
+ * Print one line per phase ("I min avg max"), the miss count ("M n"), the
+ * boot time in ms ("B n"), the clock profile in kHz ("C cpu spi") and the
+ * worst frame in µs and misses since init ("W us n")
+ */
+static void serial_report(void) {
+    for (uint8_t i = 0; i < PROFILE_PHASE_COUNT; i++) {
+        serial_write(PHASE_LABELS[i]);
+        serial_write(' ');
+        serial_write_number(published[i].min_us);
+        serial_write(' ');
+        serial_write_number(published[i].avg_us);
+        serial_write(' ');
+        serial_write_number(published[i].max_us);
+        serial_write('\r');
+        serial_write('\n');
+    }
+    serial_write('M');
+    serial_write(' ');
+    serial_write_number(published_misses);
+    serial_write('\r');
+    serial_write('\n');
+    serial_write('B');
+    serial_write(' ');
+    serial_write_number(timer_boot_ms());
+    serial_write('\r');
+    serial_write('\n');
+    serial_write('C');
+    serial_write(' ');
+    serial_write_number((uint16_t)(F_CPU / 1000UL));
+    serial_write(' ');
+    serial_write_number((uint16_t)(CLOCK_SPI_HZ / 1000UL));
+    serial_write('\r');
+    serial_write('\n');
+    serial_write('W');
+    serial_write(' ');
+    serial_write_number(worst_frame_us);
+    serial_write(' ');
+    serial_write_number(total_misses);
+    serial_write('\r');
+    serial_write('\n');
+}
+#endif // PROFILER_SERIAL
+
+/*============================================================================
+ * PROFILER INITIALIZATION
+ *==========================================================================*/
+
+void init_profiler(void) {
+    // The counter runs since init_delay() (timer.h)
+    reset_window();
+    worst_frame_us = 0;
+    total_misses = 0;
+
+#ifdef PROFILER_SERIAL
+    hal_serial_init(PROFILER_BAUD);
+#endif
+}
+
+/*============================================================================
+ * PROFILER OPERATIONS
+ *==========================================================================*/
+
+uint16_t profiler_now(void) {
+    return hal_counter_read();
+}
+
+void profiler_begin(ProfilePhase phase) {
+    accumulators[phase].start = hal_counter_read();
+}
+
+void profiler_end(ProfilePhase phase) {
+    PhaseAccumulator* acc = &accumulators[phase];
+    uint16_t elapsed = hal_counter_read() - acc->start;                      // Wrap-safe
+
+    if (elapsed < acc->min) acc->min = elapsed;
+    if (elapsed > acc->max) acc->max = elapsed;
+    acc->sum += elapsed;
+    acc->count++;
+}
+
+void profiler_ticks_run(uint8_t ticks_run) {
+    if (ticks_run > 1) {
+        window_misses += ticks_run - 1;
+    }
+}
+
+void profiler_frame_done(void) {
+    if (++window_frames < PROFILER_WINDOW) return;
+
+    // Publish the window (divisions happen here, once per window)
+    for (uint8_t i = 0; i < PROFILE_PHASE_COUNT; i++) {
+        PhaseAccumulator* acc = &accumulators[i];
+        if (acc->count == 0) {
+            published[i] = (ProfileStats){0, 0, 0};
+            continue;
+        }
+        published[i].min_us = counts_to_us(acc->min);
+        published[i].avg_us = counts_to_us(acc->sum / acc->count);
+        published[i].max_us = counts_to_us(acc->max);
+    }
+    published_misses = window_misses;
+
+    // Soak statistics (never reset)
+    if (published[PROFILE_FRAME].max_us > worst_frame_us) {
+        worst_frame_us = published[PROFILE_FRAME].max_us;
+    }
+    total_misses += window_misses;
+
+#ifdef PROFILER_SERIAL
+    serial_report();
+#endif
+    TELEMETRY_PROFILE(published, published_misses);
+
+    reset_window();
+}
+
+ProfileStats profiler_get_stats(ProfilePhase phase) {
+    return published[phase];
+}
+
+uint16_t profiler_get_deadline_misses(void) {
+    return published_misses;
+}
+
+uint16_t profiler_get_worst_frame_us(void) {
+    return worst_frame_us;
+}
+
+uint32_t profiler_get_total_misses(void) {
+    return total_misses;
+}
+
+/*============================================================================
+ * OVERLAY
+ *==========================================================================*/
+
+void profiler_toggle_overlay(void) {
+    overlay_visible = !overlay_visible;
+}
+
+uint8_t profiler_overlay_visible(void) {
+    return overlay_visible;
+}
+
+void profiler_draw_overlay(void) {
+    // Black backdrop in the top-left corner
+    Shape backdrop;
+    init_rectangle(&backdrop, (Point){0, 0}, 56, 50, ANCHOR_TOP_LEFT, 1, COLOR_BLACK);
+    draw(&backdrop);
+
+    // One row per phase: label, avg, max (µs)
+    char label[2] = {0, '\0'};
+    for (uint8_t i = 0; i < PROFILE_PHASE_COUNT; i++) {
+        uint8_t y = 1 + i * 7;
+        label[0] = PHASE_LABELS[i];
+        drawText(1, y, label, COLOR_WHITE, 1);
+        drawNumber(8, y, published[i].avg_us, COLOR_WHITE, 1);
+        drawNumber(32, y, published[i].max_us, COLOR_WHITE, 1);
+    }
+
+    // Deadline misses in the last window
+    drawText(1, 1 + PROFILE_PHASE_COUNT * 7, "M", COLOR_WHITE, 1);
+    drawNumber(8, 1 + PROFILE_PHASE_COUNT * 7, published_misses, COLOR_WHITE, 1);
+}
+
+#endif // PROFILER_ENABLED
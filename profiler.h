@@ -0,0 +1,168 @@
+/*============================================================================
+ * profiler.h
+ *============================================================================
+ * Per-phase frame profiler
+ *
+ * Timestamps game loop phases with the HAL free-running counter (TCA0) and
+ * keeps min/avg/max per phase over a window of frames, plus a count of ticks
+ * that ran late (missed their deadline). The worst frame and the misses since
+ * boot are kept as well, for soak runs (attract.h). Results can be shown as
+ * an on-screen overlay and optionally printed over USART0.
+ *
+ * Build flags:
+ *     PROFILER_ENABLED - compile the profiler in (otherwise every PROFILE_*
+ *                        macro expands to nothing and profiler.c is empty)
+ *     PROFILER_SERIAL  - also print each window's stats on USART0 TX (PB2)
+ *
+ * USAGE:
+ *     init_profiler();
+ *
+ *     PROFILE_BEGIN(PROFILE_DRAW);
+ *     draw_game_controller(&game);
+ *     PROFILE_END(PROFILE_DRAW);
+ *
+ *     PROFILE_FRAME_DONE();           // Once per rendered frame
+ *
+ *     // Overlay toggled with button 1 while holding button 2
+ *     if (profiler_overlay_visible()) profiler_draw_overlay();
+ *==========================================================================*/
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+#include "hal.h"
+
+/*============================================================================
+ * PROFILER CONFIGURATION
+ *==========================================================================*/
+
+#define PROFILER_TIMER_HZ     HAL_COUNTER_HZ             // Counter rate (156 kHz = 6.4 µs at 10 MHz)
+#define PROFILER_WINDOW       64                         // Frames per statistics window
+#define PROFILER_BAUD         115200UL                   // USART0 rate for PROFILER_SERIAL
+
+/*============================================================================
+ * PROFILER TYPES
+ *==========================================================================*/
+
+/**
+ * Profiled phases of the game loop
+ */
+typedef enum {
+    PROFILE_INPUT,          // update_input_controller()
+    PROFILE_PHYSICS,        // Paddle and ball movement (one sample per physics step)
+    PROFILE_COLLISION,      // check_collision() loops
+    PROFILE_DRAW,           // clearDisplay() + draw_game_controller()
+    PROFILE_REFRESH,        // refreshDisplay() / refreshDisplayAsync() call
+    PROFILE_FRAME,          // Work of one loop pass: ticks + render, not the sleep
+    PROFILE_PHASE_COUNT
+} ProfilePhase;
+
+/**
+ * Statistics for one phase over the last completed window
+ * All times in microseconds
+ */
+typedef struct {
+    uint16_t min_us;
+    uint16_t avg_us;
+    uint16_t max_us;
+} ProfileStats;
+
+/*============================================================================
+ * PROFILER OPERATIONS
+ *==========================================================================*/
+
+#ifdef PROFILER_ENABLED
+
+/**
+ * Reset the statistics (the counter is started by init_delay())
+ */
+void init_profiler(void);
+
+/**
+ * Read the free-running counter
+ * @return Counter value (PROFILER_TIMER_HZ, wraps at 65536)
+ */
+uint16_t profiler_now(void);
+
+/**
+ * Mark the start of a phase
+ * @param phase Phase to time
+ */
+void profiler_begin(ProfilePhase phase);
+
+/**
+ * Mark the end of a phase and accumulate its duration
+ * @param phase Phase started with profiler_begin()
+ */
+void profiler_end(ProfilePhase phase);
+
+/**
+ * Record how many simulation ticks one loop pass had to run
+ * Every tick beyond the first ran late and counts as a deadline miss
+ * @param ticks_run Ticks processed in this pass
+ */
+void profiler_ticks_run(uint8_t ticks_run);
+
+/**
+ * Finish a rendered frame; publishes stats at the end of each window
+ */
+void profiler_frame_done(void);
+
+/**
+ * Get the stats of the last completed window
+ * @param phase Phase to query
+ * @return Min/avg/max in microseconds
+ */
+ProfileStats profiler_get_stats(ProfilePhase phase);
+
+/**
+ * Get the number of late ticks in the last completed window
+ * @return Deadline misses
+ */
+uint16_t profiler_get_deadline_misses(void);
+
+/**
+ * Get the longest frame since init (completed windows only)
+ * @return Worst PROFILE_FRAME time in microseconds
+ */
+uint16_t profiler_get_worst_frame_us(void);
+
+/**
+ * Get the number of late ticks since init (completed windows only)
+ * @return Deadline misses
+ */
+uint32_t profiler_get_total_misses(void);
+
+/**
+ * Toggle the on-screen stats overlay
+ */
+void profiler_toggle_overlay(void);
+
+/**
+ * Check whether the overlay is shown
+ * @return 1 if visible, 0 otherwise
+ */
+uint8_t profiler_overlay_visible(void);
+
+/**
+ * Draw the stats overlay into the display buffer
+ * One row per phase: label, avg and max in µs; last row: deadline misses
+ */
+void profiler_draw_overlay(void);
+
+#define PROFILE_BEGIN(phase)    profiler_begin(phase)
+#define PROFILE_END(phase)      profiler_end(phase)
+#define PROFILE_TICKS_RUN(n)    profiler_ticks_run(n)
+#define PROFILE_FRAME_DONE()    profiler_frame_done()
+
+#else
+
+#define PROFILE_BEGIN(phase)    ((void)0)
+#define PROFILE_END(phase)      ((void)0)
+#define PROFILE_TICKS_RUN(n)    ((void)0)
+#define PROFILE_FRAME_DONE()    ((void)0)
+
+#endif // PROFILER_ENABLED
+
+#endif // PROFILER_H
@@ -0,0 +1,255 @@
+/*============================================================================
+ * replay.c
+ *============================================================================
+ * Compact input recording implementation
+ *==========================================================================*/
+
+#include "replay.h"
+#include "hal.h"
+#include <stddef.h>
+
+/*============================================================================
+ * STREAM FORMAT
+ *==========================================================================*/
+
+#define REPLAY_HEADER_SIZE  3
+#define REPLAY_TAG_RUN      0x80                                   // Low 7 bits: repeats - 1
+#define REPLAY_TAG_SEED     0x40
+#define REPLAY_TAG_END      0x7F
+#define REPLAY_FRAME_X      0x08                                   // X delta follows
+#define REPLAY_FRAME_Y      0x10                                   // Y delta follows
+#define REPLAY_FRAME_MASK   0x1F
+#define REPLAY_DELTA_ESCAPE 0x80                                   // 16-bit value follows
+#define REPLAY_RUN_MAX      128
+
+static const uint8_t REPLAY_HEADER[REPLAY_HEADER_SIZE] = {'P', 'R', REPLAY_VERSION};
+
+/*============================================================================
+ * HELPER FUNCTIONS
+ *==========================================================================*/
+
+/**
+ * Check whether a frame repeats the previous one (a click never repeats)
+ */
+static uint8_t is_repeat(const ReplayFrame* last, const ReplayFrame* frame) {
+    return frame->buttons == (last->buttons & ~REPLAY_CLICK1) &&
+           frame->joystick_x == last->joystick_x &&
+           frame->joystick_y == last->joystick_y;
+}
+
+/**
+ * Write the buffered bytes followed by the end marker
+ */
+static void flush(ReplayStream* stream) {
+    stream->buffer[stream->fill] = REPLAY_TAG_END;                           // Overwritten by the next flush
+    hal_storage_write(stream->position, stream->buffer, stream->fill + 1);
+    stream->position += stream->fill;
+    stream->fill = 0;
+}
+
+/**
+ * Append one record; stops recording when storage is full
+ */
+static void emit(ReplayStream* stream, const uint8_t* bytes, uint8_t length) {
+    if (stream->mode != REPLAY_RECORDING) return;
+
+    // Every record must leave room for the end marker
+    if ((uint32_t)stream->position + stream->fill + length + 1 > HAL_STORAGE_BYTES) {
+        flush(stream);
+        stream->mode = REPLAY_OFF;
+        return;
+    }
+
+    if (stream->fill + length > REPLAY_BUFFER_SIZE) {
+        flush(stream);
+    }
+    for (uint8_t i = 0; i < length; i++) {
+        stream->buffer[stream->fill++] = bytes[i];
+    }
+}
+
+/**
+ * Write out the pending repeats of the previous frame
+ */
+static void emit_run(ReplayStream* stream) {
+    if (stream->run == 0) return;
+    uint8_t tag = REPLAY_TAG_RUN | (stream->run - 1);
+    stream->run = 0;
+    emit(stream, &tag, 1);
+}
+
+/**
+ * Encode the change of one axis
+ * @return Bytes written to out (1 or 3)
+ */
+static uint8_t encode_delta(uint8_t* out, uint16_t previous, uint16_t value) {
+    int16_t delta = (int16_t)(value - previous);
+    if (delta >= -127 && delta <= 127) {
+        out[0] = (uint8_t)(int8_t)delta;
+        return 1;
+    }
+    out[0] = REPLAY_DELTA_ESCAPE;
+    out[1] = (uint8_t)value;
+    out[2] = (uint8_t)(value >> 8);
+    return 3;
+}
+
+/**
+ * Read the next stream byte
+ * @return 1 on success, 0 past the end of storage
+ */
+static uint8_t read_byte(ReplayStream* stream, uint8_t* byte) {
+    if (stream->position >= HAL_STORAGE_BYTES) return 0;
+    hal_storage_read(stream->position++, byte, 1);
+    return 1;
+}
+
+/**
+ * Read a little-endian 16-bit value
+ */
+static uint8_t read_word(ReplayStream* stream, uint16_t* word) {
+    uint8_t low, high;
+    if (!read_byte(stream, &low) || !read_byte(stream, &high)) return 0;
+    *word = (uint16_t)low | ((uint16_t)high << 8);
+    return 1;
+}
+
+/**
+ * Apply one encoded axis change
+ */
+static uint8_t decode_delta(ReplayStream* stream, uint16_t* value) {
+    uint8_t byte;
+    if (!read_byte(stream, &byte)) return 0;
+    if (byte == REPLAY_DELTA_ESCAPE) return read_word(stream, value);
+    *value += (int8_t)byte;
+    return 1;
+}
+
+/*============================================================================
+ * RECORDING
+ *==========================================================================*/
+
+void replay_start_recording(ReplayStream* stream) {
+    stream->mode = REPLAY_RECORDING;
+    stream->position = 0;
+    stream->last = (ReplayFrame){0, 2048, 2048};                             // Centered, as at reset
+    stream->run = 0;
+    stream->fill = 0;
+
+    emit(stream, REPLAY_HEADER, REPLAY_HEADER_SIZE);
+    flush(stream);                                                           // Valid (empty) stream from here
+}
+
+void replay_record_frame(ReplayStream* stream, const ReplayFrame* frame) {
+    if (stream->mode != REPLAY_RECORDING) return;
+
+    if (is_repeat(&stream->last, frame)) {
+        stream->last.buttons = frame->buttons;
+        if (++stream->run == REPLAY_RUN_MAX) emit_run(stream);
+        return;
+    }
+    emit_run(stream);
+
+    uint8_t record[7];
+    uint8_t length = 1;
+    record[0] = frame->buttons & (REPLAY_BUTTON1 | REPLAY_BUTTON2 | REPLAY_CLICK1);
+    if (frame->joystick_x != stream->last.joystick_x) {
+        record[0] |= REPLAY_FRAME_X;
+        length += encode_delta(&record[length], stream->last.joystick_x, frame->joystick_x);
+    }
+    if (frame->joystick_y != stream->last.joystick_y) {
+        record[0] |= REPLAY_FRAME_Y;
+        length += encode_delta(&record[length], stream->last.joystick_y, frame->joystick_y);
+    }
+    emit(stream, record, length);
+    stream->last = *frame;
+}
+
+void replay_record_seed(ReplayStream* stream, uint16_t seed) {
+    if (stream->mode != REPLAY_RECORDING) return;
+    emit_run(stream);
+
+    uint8_t record[3] = {REPLAY_TAG_SEED, (uint8_t)seed, (uint8_t)(seed >> 8)};
+    emit(stream, record, sizeof(record));
+}
+
+void replay_stop(ReplayStream* stream) {
+    if (stream->mode == REPLAY_RECORDING) {
+        emit_run(stream);
+        if (stream->mode == REPLAY_RECORDING) flush(stream);                 // emit() may have stopped it
+    }
+    stream->mode = REPLAY_OFF;
+}
+
+/*============================================================================
+ * PLAYBACK
+ *==========================================================================*/
+
+uint8_t replay_start_playback(ReplayStream* stream) {
+    uint8_t header[REPLAY_HEADER_SIZE];
+    hal_storage_read(0, header, REPLAY_HEADER_SIZE);
+    for (uint8_t i = 0; i < REPLAY_HEADER_SIZE; i++) {
+        if (header[i] != REPLAY_HEADER[i]) {
+            stream->mode = REPLAY_OFF;
+            return 0;
+        }
+    }
+
+    stream->mode = REPLAY_PLAYING;
+    stream->position = REPLAY_HEADER_SIZE;
+    stream->last = (ReplayFrame){0, 2048, 2048};
+    stream->run = 0;
+    return 1;
+}
+
+uint8_t replay_next_frame(ReplayStream* stream, ReplayFrame* frame) {
+    if (stream->mode != REPLAY_PLAYING) return 0;
+
+    if (stream->run == 0) {
+        uint8_t tag;
+        do {
+            if (!read_byte(stream, &tag) || tag == REPLAY_TAG_END) {
+                stream->mode = REPLAY_OFF;
+                return 0;
+            }
+            if (tag == REPLAY_TAG_SEED) {                                    // Seed nobody asked for
+                uint16_t unused;
+                if (!read_word(stream, &unused)) tag = REPLAY_TAG_END;
+            }
+        } while (tag == REPLAY_TAG_SEED);
+
+        if (tag & REPLAY_TAG_RUN) {
+            stream->run = (tag & ~REPLAY_TAG_RUN) + 1;
+        } else {
+            ReplayFrame next = stream->last;
+            next.buttons = tag & (REPLAY_BUTTON1 | REPLAY_BUTTON2 | REPLAY_CLICK1);
+            if (((tag & REPLAY_FRAME_X) && !decode_delta(stream, &next.joystick_x)) ||
+                ((tag & REPLAY_FRAME_Y) && !decode_delta(stream, &next.joystick_y)) ||
+                (tag & ~REPLAY_FRAME_MASK)) {
+                stream->mode = REPLAY_OFF;                                   // Truncated or corrupt
+                return 0;
+            }
+            stream->last = next;
+            *frame = next;
+            return 1;
+        }
+    }
+
+    // Repeat of the previous frame
+    stream->run--;
+    stream->last.buttons &= ~REPLAY_CLICK1;
+    *frame = stream->last;
+    return 1;
+}
+
+uint8_t replay_next_seed(ReplayStream* stream, uint16_t* seed) {
+    if (stream->mode != REPLAY_PLAYING || stream->run != 0) return 0;       // Seed comes after the tick's frame
+
+    uint8_t tag;
+    uint16_t position = stream->position;
+    if (!read_byte(stream, &tag) || tag != REPLAY_TAG_SEED) {
+        stream->position = position;                                         // Not a seed: leave it
+        return 0;
+    }
+    return read_word(stream, seed);
+}
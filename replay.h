@@ -0,0 +1,149 @@
+/*============================================================================
+ * replay.h
+ *============================================================================
+ * Compact input recording for deterministic replays
+ *
+ * Stores one ReplayFrame per tick (the input controller state after its
+ * update) plus every random seed the game took, delta-encoded into
+ * non-volatile storage (EEPROM on the ATtiny1627, a file on the host).
+ * Replaying the stream from boot reproduces a session bit for bit, so frame
+ * checksums can be compared between builds.
+ *
+ * Stream format (after the 3-byte header 'P' 'R' REPLAY_VERSION):
+ *     1nnnnnnn            previous frame repeated n+1 times (click cleared)
+ *     000YXCBA [dx] [dy]  one frame: A = button 1, B = button 2,
+ *                         C = button 1 click; X/Y = axis delta follows
+ *                         (int8 -127..127, or -128 then the 16-bit value)
+ *     0x40 lo hi          random seed taken during the previous frame
+ *     0x7F                end of stream
+ * A game sitting still costs one byte per 128 ticks (2 s).
+ *
+ * The stream is terminated again at every flush, so it stays readable when
+ * the power goes; up to REPLAY_BUFFER_SIZE bytes of the tail are lost then.
+ * Recording stops by itself when the storage is full.
+ *
+ * Architecture:
+ *     input_controller.c (records or replays its state each update)
+ *         ↓
+ *     replay.c (encoding, buffering)
+ *         ↓
+ *     hal.h (EEPROM on the ATtiny1627, or host mock storage)
+ *
+ * USAGE:
+ *     ReplayStream stream;
+ *     replay_start_recording(&stream);
+ *     replay_record_frame(&stream, &frame);     // Once per tick
+ *     replay_record_seed(&stream, seed);        // Whenever a seed is used
+ *     replay_stop(&stream);                     // Flush
+ *
+ *     if (replay_start_playback(&stream)) {
+ *         while (replay_next_frame(&stream, &frame)) { ... }
+ *     }
+ *==========================================================================*/
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdint.h>
+
+/*============================================================================
+ * REPLAY CONFIGURATION
+ *==========================================================================*/
+
+#define REPLAY_VERSION     1
+#define REPLAY_BUFFER_SIZE 8                                       // Bytes buffered between storage writes
+
+// Frame button bits
+#define REPLAY_BUTTON1     0x01                                    // Button 1 held
+#define REPLAY_BUTTON2     0x02                                    // Button 2 held
+#define REPLAY_CLICK1      0x04                                    // Button 1 pressed since the last frame
+
+/*============================================================================
+ * REPLAY TYPES
+ *==========================================================================*/
+
+/**
+ * Input state of one tick
+ */
+typedef struct {
+    uint8_t buttons;                        // REPLAY_BUTTON1 | REPLAY_BUTTON2 | REPLAY_CLICK1
+    uint16_t joystick_x;                    // Raw ADC: 0-4095
+    uint16_t joystick_y;
+} ReplayFrame;
+
+typedef enum {
+    REPLAY_OFF,
+    REPLAY_RECORDING,
+    REPLAY_PLAYING
+} ReplayMode;
+
+/**
+ * Recording or playback position in storage
+ */
+typedef struct {
+    ReplayMode mode;
+    uint16_t position;                      // Next storage byte to write or read
+    ReplayFrame last;                       // Delta base (previous frame)
+    uint8_t run;                            // Repeats pending (record) or left (playback)
+    uint8_t fill;                           // Bytes in buffer (record)
+    uint8_t buffer[REPLAY_BUFFER_SIZE + 1]; // Room for the end marker
+} ReplayStream;
+
+/*============================================================================
+ * RECORDING
+ *==========================================================================*/
+
+/**
+ * Start a new stream at the beginning of storage (overwrites the old one)
+ * @param stream Stream state
+ */
+void replay_start_recording(ReplayStream* stream);
+
+/**
+ * Append the input state of one tick
+ * @param stream Stream state
+ * @param frame State after the tick's input update
+ */
+void replay_record_frame(ReplayStream* stream, const ReplayFrame* frame);
+
+/**
+ * Append a random seed the game used in the current tick
+ * @param stream Stream state
+ * @param seed Seed value
+ */
+void replay_record_seed(ReplayStream* stream, uint16_t seed);
+
+/**
+ * Flush and finish recording or stop playback
+ * @param stream Stream state
+ */
+void replay_stop(ReplayStream* stream);
+
+/*============================================================================
+ * PLAYBACK
+ *==========================================================================*/
+
+/**
+ * Start replaying the stream in storage
+ * @param stream Stream state
+ * @return 1 on success, 0 if storage holds no stream of this version
+ */
+uint8_t replay_start_playback(ReplayStream* stream);
+
+/**
+ * Get the input state of the next tick
+ * @param stream Stream state
+ * @param frame Receives the state
+ * @return 1 on success, 0 at the end of the stream (playback stops)
+ */
+uint8_t replay_next_frame(ReplayStream* stream, ReplayFrame* frame);
+
+/**
+ * Get the random seed recorded in the current tick
+ * @param stream Stream state
+ * @param seed Receives the seed (unchanged if none was recorded)
+ * @return 1 if a seed was recorded here, 0 otherwise
+ */
+uint8_t replay_next_seed(ReplayStream* stream, uint16_t* seed);
+
+#endif // REPLAY_H
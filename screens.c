@@ -0,0 +1,43 @@
+/*============================================================================
+ * screens.c
+ *============================================================================
+ * Static full-screen images (see screens.h)
+ * Generated by host/screen_encoder.c - do not edit
+ *==========================================================================*/
+
+#include "screens.h"
+
+const uint8_t TITLE_SCREEN[] = {
+    0xFF, 0x00, 0x8F, 0x00, 0x85, 0x80, 0x01, 0x00, 0x00, 0x85, 0x80, 0x01, 0x00, 0x00, 0x83, 0x80,
+    0x83, 0x00, 0x83, 0x80, 0x83, 0x00, 0x01, 0x80, 0x80, 0x85, 0x00, 0x85, 0x80, 0x89, 0x00, 0x85,
+    0x80, 0x01, 0x00, 0x00, 0x85, 0x80, 0x09, 0x00, 0x00, 0x80, 0x80, 0x00, 0x00, 0x80, 0x80, 0x00,
+    0x00, 0x85, 0x80, 0x01, 0x00, 0x00, 0x85, 0x80, 0x91, 0x00, 0x8F, 0x00, 0x21, 0xFF, 0xFF, 0x19,
+    0x19, 0x1F, 0x1F, 0x00, 0x00, 0xFF, 0xFF, 0x19, 0x19, 0xFF, 0xFF, 0x00, 0x00, 0xFF, 0xFF, 0x81,
+    0x81, 0x7E, 0x7E, 0x00, 0x00, 0xFF, 0xFF, 0x81, 0x81, 0x7E, 0x7E, 0x00, 0x00, 0xFF, 0xFF, 0x83,
+    0x80, 0x03, 0x00, 0x00, 0xFF, 0xFF, 0x83, 0x99, 0x89, 0x00, 0x21, 0xFF, 0xFF, 0x19, 0x19, 0x1F,
+    0x1F, 0x00, 0x00, 0xFF, 0xFF, 0x19, 0x19, 0xFF, 0xFF, 0x00, 0x00, 0xFF, 0xFF, 0x7E, 0x7E, 0xFF,
+    0xFF, 0x00, 0x00, 0x81, 0x81, 0xFF, 0xFF, 0x81, 0x81, 0x00, 0x00, 0xFF, 0xFF, 0x83, 0x81, 0x91,
+    0x00, 0x8F, 0x00, 0x01, 0x01, 0x01, 0x85, 0x00, 0x07, 0x01, 0x01, 0x00, 0x00, 0x01, 0x01, 0x00,
+    0x00, 0x83, 0x01, 0x83, 0x00, 0x83, 0x01, 0x83, 0x00, 0x85, 0x01, 0x01, 0x00, 0x00, 0x85, 0x01,
+    0x89, 0x00, 0x01, 0x01, 0x01, 0x85, 0x00, 0x0F, 0x01, 0x01, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00,
+    0x01, 0x01, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x85, 0x01, 0x01, 0x00, 0x00, 0x85, 0x01, 0x91,
+    0x00, 0xFF, 0x00, 0xFF, 0x00, 0xA9, 0x00, 0x12, 0x7C, 0x14, 0x1C, 0x00, 0x7C, 0x14, 0x6C, 0x00,
+    0x7C, 0x54, 0x54, 0x00, 0x5C, 0x54, 0x74, 0x00, 0x5C, 0x54, 0x74, 0x84, 0x00, 0x12, 0x5C, 0x54,
+    0x74, 0x00, 0x04, 0x7C, 0x04, 0x00, 0x7C, 0x14, 0x7C, 0x00, 0x7C, 0x14, 0x6C, 0x00, 0x04, 0x7C,
+    0x04, 0xAA, 0x00, 0xFF, 0x00,
+};
+
+const uint8_t GAME_OVER_SCREEN[] = {
+    0xFF, 0x00, 0x9B, 0x00, 0x85, 0x80, 0x01, 0x00, 0x00, 0x85, 0x80, 0x09, 0x00, 0x00, 0x80, 0x80,
+    0x00, 0x00, 0x80, 0x80, 0x00, 0x00, 0x85, 0x80, 0x89, 0x00, 0x85, 0x80, 0x09, 0x00, 0x00, 0x80,
+    0x80, 0x00, 0x00, 0x80, 0x80, 0x00, 0x00, 0x85, 0x80, 0x01, 0x00, 0x00, 0x85, 0x80, 0x9D, 0x00,
+    0x9B, 0x00, 0x19, 0xFF, 0xFF, 0x81, 0x81, 0xF9, 0xF9, 0x00, 0x00, 0xFF, 0xFF, 0x19, 0x19, 0xFF,
+    0xFF, 0x00, 0x00, 0xFF, 0xFF, 0x1E, 0x1E, 0xFF, 0xFF, 0x00, 0x00, 0xFF, 0xFF, 0x83, 0x99, 0x89,
+    0x00, 0x11, 0xFF, 0xFF, 0x81, 0x81, 0xFF, 0xFF, 0x00, 0x00, 0x7F, 0x7F, 0x80, 0x80, 0x7F, 0x7F,
+    0x00, 0x00, 0xFF, 0xFF, 0x83, 0x99, 0x07, 0x00, 0x00, 0xFF, 0xFF, 0x19, 0x19, 0xE7, 0xE7, 0x9D,
+    0x00, 0x9B, 0x00, 0x85, 0x01, 0x11, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00,
+    0x01, 0x01, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x85, 0x01, 0x89, 0x00, 0x85, 0x01, 0x83, 0x00,
+    0x01, 0x01, 0x01, 0x83, 0x00, 0x85, 0x01, 0x07, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x01, 0x01,
+    0x9D, 0x00, 0xB5, 0x00, 0x12, 0xB8, 0xA8, 0xE8, 0x00, 0xF8, 0x88, 0x88, 0x00, 0xF8, 0x88, 0xF8,
+    0x00, 0xF8, 0x28, 0xD8, 0x00, 0xF8, 0xA8, 0xA8, 0xB6, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00,
+};
@@ -0,0 +1,37 @@
+/*============================================================================
+ * screens.h
+ *============================================================================
+ * Static full-screen images for streamScreen() (title, game over)
+ *
+ * The images live in flash, run-length encoded (format in
+ * sh1106_graphics.h). screens.c is generated by host/screen_encoder.c,
+ * which draws the layouts with the text renderer on the host; rerun it
+ * after changing a layout:
+ *     ./build/paddlepanic_screens > screens.c
+ *
+ * The final score is not part of the game over image. The game draws it
+ * into buffer at GAME_OVER_SCORE_X/Y; the generator checks that the image
+ * leaves the blocks under the widest score (5 digits) blank.
+ *==========================================================================*/
+
+#ifndef SCREENS_H
+#define SCREENS_H
+
+#include <stdint.h>
+
+/*============================================================================
+ * SCREEN LAYOUT
+ *==========================================================================*/
+
+#define GAME_OVER_SCORE_X     54        // Final score (top-left of first digit)
+#define GAME_OVER_SCORE_Y     45
+#define GAME_OVER_SCORE_SCALE 2
+
+/*============================================================================
+ * SCREEN IMAGES
+ *==========================================================================*/
+
+extern const uint8_t TITLE_SCREEN[];        // "PADDLE PANIC", "PRESS START"
+extern const uint8_t GAME_OVER_SCREEN[];    // "GAME OVER", "SCORE"
+
+#endif // SCREENS_H
@@ -2,7 +2,7 @@
  * sh1106_graphics.c - Modified by Wes Orr (11/29/25)
  *============================================================================
  * Low-level graphics primitives for SH1106-driven 128x64 B&W OLED displays
- * via ATtiny1627
+ * via ATtiny1627 (all register access goes through hal.h)
  * 
  * Based on Adafruit_GFX and Adafruit_GrayOLED libraries
  * Original Copyright (c) 2013 Adafruit Industries - BSD License
@@ -12,11 +12,13 @@
  * All shape-specific code (circles, rectangles) is in shapes.c
  *==========================================================================*/
 
-#include <xc.h>
 #include "sh1106_graphics.h"
+#include "hal.h"
+#include "timer.h"
+#include "latency.h"
+#include "display_list.h"
 #include <stdlib.h>
 #include <string.h>
-#include <avr/pgmspace.h>
 
 /*============================================================================
  * MACROS
@@ -36,90 +38,207 @@
 /*============================================================================
  * DISPLAY BUFFER
  *==========================================================================*/
+#ifdef DISPLAY_STRIP
+// Page-strip mode (display_list.h): no frame buffer. The display list is
+// rasterized one page at a time into a strip while the previous strip is
+// sent; drawing outside strip_page is discarded
+static uint8_t strips[DISPLAY_STRIP_COUNT][WIDTH];
+static uint8_t* strip = strips[0];                                           // Strip being rasterized
+static uint8_t strip_page = PAGES;                                           // Its page (PAGES = none)
+#else
 // Frame buffer organized as 8 pages of 128 bytes each
 // Each byte represents 8 vertical pixels (bit 0 = top, bit 7 = bottom)
 // Total: 128 columns × 64 rows = 1024 bytes
 uint8_t buffer[WIDTH * ((HEIGHT + 7) / 8)] = {0};
+#endif
+
+/*============================================================================
+ * DIRTY REGION TRACKING
+ *==========================================================================*/
+// Each page is split into 16 blocks of 8 columns, one bit per block
+// (bit n covers columns 8n to 8n+7)
+//
+// dirty_blocks: blocks whose contents differ from what the display shows
+// drawn_blocks: blocks written since the last clearDisplay() - everything
+//               outside them is known to be zero, which stands in for a full
+//               snapshot of the last frame (no room for a second 1KB buffer)
+// streamed_blocks: blocks inked on the display by streamScreen() that
+//               buffer does not hold
+#define DIRTY_BLOCK_SHIFT 3                                                  // 8 columns per block
+#define DIRTY_BLOCK_COUNT (WIDTH >> DIRTY_BLOCK_SHIFT)                       // 16 blocks per page
+#define DIRTY_ALL_BLOCKS  0xFFFF
+
+static uint16_t refresh_byte_count = 0;
+static volatile uint8_t stream_busy = 0;                                     // Async refresh in progress
+
+static void streamNextByte(void);                                            // SPI interrupt handler (DISPLAY TRANSFER)
+
+#ifdef DISPLAY_STRIP
+// Strip mode sends whole pages instead: a page is sent when the signature
+// of its display list commands differs from the one it was last sent with
+static uint16_t sent_signatures[PAGES];
+
+#define markDirty(page, col) ((void)0)
+#else
+static uint16_t dirty_blocks[PAGES];
+static uint16_t drawn_blocks[PAGES];
+static uint16_t streamed_blocks[PAGES];
+
+// Block bit lookup (avoids a variable-length shift on AVR)
+static const uint16_t BLOCK_BIT[DIRTY_BLOCK_COUNT] = {
+    0x0001, 0x0002, 0x0004, 0x0008, 0x0010, 0x0020, 0x0040, 0x0080,
+    0x0100, 0x0200, 0x0400, 0x0800, 0x1000, 0x2000, 0x4000, 0x8000
+};
+
+/**
+ * Record that a buffer byte was changed
+ * @param page Page index (0-7)
+ * @param col Column index (0-127)
+ */
+static inline void markDirty(uint8_t page, uint8_t col) {
+    uint16_t bit = BLOCK_BIT[col >> DIRTY_BLOCK_SHIFT];
+    dirty_blocks[page] |= bit;
+    drawn_blocks[page] |= bit;
+}
+#endif
 
 /*============================================================================
  * SPI INITIALIZATION
  *==========================================================================*/
 void initSPI() {
-    PORTMUX.SPIROUTEA |= PORTMUX_SPI0_ALT1_gc;                               // Route SPI0 to alternate pin locations
-    
-    PORTC.DIR |= PIN0_bm | PIN2_bm | PIN3_bm;                                // Set as outputs: PC0=SCLK, PC2=MOSI, PC3=SS
-    
-    SPI0.CTRLA |= SPI_MASTER_bm | SPI_CLK2X_bm | SPI_PRESC_DIV16_gc;         // Host mode, double speed enabled, prescaler /16 → f_clk/8
-    SPI0.CTRLB |= SPI_MODE_3_gc;                                             // CPOL=1, CPHA=1 (idle high, sample on rising edge)
-    SPI0.CTRLA |= SPI_ENABLE_bm;                                             // Enable SPI peripheral
-    
-    PORTC.OUTSET = PIN3_bm;                                                  // Deassert CS (active low, so idle high)
+    hal_display_init();                                                      // SPI0 Mode 3, CLOCK_SPI_HZ, buffer mode; CS idle
 }
 
 /*============================================================================
  * SPI COMMUNICATION
  *==========================================================================*/
+
+/**
+ * Wait until every queued byte has been shifted out
+ */
+static inline void waitTransmitCompleteSPI(void) {
+    while (!hal_spi_idle()) {}
+}
+
 void sendByteSPI(uint8_t byteToSend) {
-    SPI0.DATA = byteToSend;                                                  // Load byte into transmit buffer
-    PORTC.OUT &= ~PIN3_bm;                                                   // Assert CS (active low)
-    while ((SPI0.INTFLAGS & SPI_IF_bm) == 0) {}                              // Wait for transfer complete
-    PORTC.OUT |= PIN3_bm;                                                    // Deassert CS
+    while (stream_busy) {}                                                   // Never interleave with async refresh
+    hal_display_select(1);                                                   // Assert CS (active low)
+    hal_spi_write(byteToSend);
+    waitTransmitCompleteSPI();
+    hal_display_select(0);                                                   // Deassert CS
+}
+
+/**
+ * Send a block of bytes with CS held low throughout
+ * Keeps the transmit buffer full so bytes go out back-to-back
+ */
+static void sendBlockSPI(const uint8_t* bytes, uint16_t length) {
+    hal_display_select(1);                                                   // Assert CS for the whole block
+    for (uint16_t i = 0; i < length; i++) {
+        hal_spi_write(bytes[i]);
+    }
+    waitTransmitCompleteSPI();                                               // D/C and CS may change after this
+    hal_display_select(0);                                                   // Deassert CS
 }
 
 void sendCommand(uint8_t commandByte) {
-    PORTB.OUT &= ~0x02;                                                      // Set D/C low (command mode)
+    while (stream_busy) {}                                                   // D/C must not change under a streaming frame
+    hal_display_dc(0);                                                       // Set D/C low (command mode)
     sendByteSPI(commandByte);
 }
 
 void sendData(uint8_t dataByte) {
-    PORTB.OUT |= 0x02;                                                       // Set D/C high (data mode)
+    while (stream_busy) {}                                                   // D/C must not change under a streaming frame
+    hal_display_dc(1);                                                       // Set D/C high (data mode)
     sendByteSPI(dataByte);
 }
 
+void sendCommandBlock(const uint8_t* commands, uint16_t length) {
+    while (stream_busy) {}                                                   // Never interleave with async refresh
+    hal_display_dc(0);                                                       // Set D/C low once (command mode)
+    sendBlockSPI(commands, length);
+}
+
+void sendDataBlock(const uint8_t* data, uint16_t length) {
+    while (stream_busy) {}                                                   // Never interleave with async refresh
+    hal_display_dc(1);                                                       // Set D/C high once (data mode)
+    sendBlockSPI(data, length);
+}
+
 /*============================================================================
  * DISPLAY INITIALIZATION
  *==========================================================================*/
-void initScreen() {
-    // Initialize SPI first (screen requires SPI)
-    initSPI();
 
-    PORTB.DIR |= PIN0_bm | PIN1_bm;                                          // Set as outputs: PB0=RESET, PB1=D/C
+// SH1106 configuration, sent once the controller is out of reset
+static const uint8_t INIT_COMMANDS[] = {
+    0xAE,       // Display OFF (sleep mode)
+    0xD5, 0x80, // Set display clock divide ratio (default)
+    0xA8, 0x3F, // Set multiplex ratio to 64 (for 64-row display)
+    0xD3, 0x00, // Set display offset to 0
+    0x40,       // Set display start line to 0
+    0xAD, 0x8B, // Enable internal DC-DC converter (for OLED power)
+    0xA1,       // Set segment remap (flip horizontal)
+    0xC8,       // Set COM output scan direction (flip vertical)
+    0xDA, 0x12, // Set COM pins hardware configuration
+    0x81, 0xFF, // Set contrast to maximum
+    0xD9, 0x1F, // Set pre-charge period
+    0xDB, 0x40, // Set VCOMH deselect level
+    0x33,       // Set VPP to 9V
+    0xA6,       // Set normal display mode (0=off, 1=on)
+    0x20, 0x00, // Set memory addressing mode to horizontal
+    0x10,       // Set higher column start address to 0
+    0xA4        // Resume displaying from RAM content (not all-on)
+};
 
-    // Hardware reset sequence per SH1106 datasheet
-    PORTB.OUT |= PIN0_bm;                                                    // RESET high (inactive)
-    for (uint8_t i = 0; i < 250; i++) {}                                     // Short delay
-    PORTB.OUT &= ~PIN0_bm;                                                   // RESET low (active) for >10µs
-    for (uint16_t i = 0; i < 1000; i++) {}                                   // Hold in reset
-    PORTB.OUT |= PIN0_bm;                                                    // RESET high (release)
-    
-    // SH1106 initialization commands
-    uint8_t initSequence[] = {
-        0xAE,       // Display OFF (sleep mode)
-        0xD5, 0x80, // Set display clock divide ratio (default)
-        0xA8, 0x3F, // Set multiplex ratio to 64 (for 64-row display)
-        0xD3, 0x00, // Set display offset to 0
-        0x40,       // Set display start line to 0
-        0xAD, 0x8B, // Enable internal DC-DC converter (for OLED power)
-        0xA1,       // Set segment remap (flip horizontal)
-        0xC8,       // Set COM output scan direction (flip vertical)
-        0xDA, 0x12, // Set COM pins hardware configuration
-        0x81, 0xFF, // Set contrast to maximum
-        0xD9, 0x1F, // Set pre-charge period
-        0xDB, 0x40, // Set VCOMH deselect level
-        0x33,       // Set VPP to 9V
-        0xA6,       // Set normal display mode (0=off, 1=on)
-        0x20, 0x00, // Set memory addressing mode to horizontal
-        0x10,       // Set higher column start address to 0
-        0xA4        // Resume displaying from RAM content (not all-on)
-    };
-    
-    for (uint8_t i = 0; i < sizeof(initSequence); i++) {
-        sendCommand(initSequence[i]);
+/**
+ * One power-up step: drive RES, send commands (if any), then hold for at
+ * least hold_us before the next step
+ */
+typedef struct {
+    uint8_t reset_level;                                 // RES level (1 = released)
+    const uint8_t* commands;                             // NULL for none
+    uint8_t command_count;
+    uint16_t hold_us;
+} DisplayInitStep;
+
+static const DisplayInitStep INIT_STEPS[] = {
+    {0, NULL,          0,                     SH1106_RESET_PULSE_US},       // Reset pulse
+    {1, NULL,          0,                     SH1106_RESET_RECOVERY_US},    // Internal reset completes
+    {1, INIT_COMMANDS, sizeof(INIT_COMMANDS), 0},                            // Configure, DC-DC on
+};
+
+static uint32_t settle_start = 0;                                            // timer_uptime() at DC-DC on
+
+void beginScreenInit(void) {
+    // Initialize SPI first (screen requires SPI); also sets up RESET and D/C
+    initSPI();
+    hal_spi_set_handler(streamNextByte);                                     // Async refresh runs from the SPI interrupt
+
+    for (uint8_t i = 0; i < sizeof(INIT_STEPS) / sizeof(INIT_STEPS[0]); i++) {
+        const DisplayInitStep* step = &INIT_STEPS[i];
+        hal_display_reset(step->reset_level);
+        if (step->commands != NULL) {
+            sendCommandBlock(step->commands, step->command_count);
+        }
+        if (step->hold_us != 0) {
+            delay_us(step->hold_us);
+        }
     }
-    
-    for (uint16_t i = 0; i < 40000; i++) {}                                  // Allow display to stabilize
-    
-    sendCommand(0xAF);                                                       // Display ON
+    settle_start = timer_uptime();
+}
+
+void endScreenInit(void) {
+    uint32_t settle_counts = (uint32_t)SH1106_POWER_SETTLE_MS * TIMER_COUNTS_PER_MS;
+    while (timer_uptime() - settle_start < settle_counts) {}                 // Rest of the power-up time
+
+    sendCommand(SH1106_DISPLAYON);                                           // Display ON
+
+    invalidateDisplay();                                                     // Display RAM is undefined after reset
+}
+
+void initScreen() {
+    beginScreenInit();
+    endScreenInit();
 }
 
 /*============================================================================
@@ -131,20 +250,35 @@ void initScreen() {
  * @param color COLOR_WHITE, COLOR_BLACK, or COLOR_INVERT
  */
 void drawPixel(Point pos, OLED_color color) {
+    if (DISPLAY_LIST_LINE(DISPLAY_CMD_PIXEL, pos, pos, color)) return;
+
     if ((pos.x < WIDTH) && (pos.y < HEIGHT)) {
         // Calculate buffer position: column + (page * width)
         // Each page is 8 pixels tall, bit position determined by (y & 7)
+        uint8_t page = pos.y >> 3;
+#ifdef DISPLAY_STRIP
+        if (page != strip_page) return;                                      // Drawn with its own strip
+        uint8_t* byte = &strip[pos.x];
+#else
+        uint8_t* byte = &buffer[pos.x + page * WIDTH];
+#endif
+        uint8_t old_value = *byte;
+
         switch (color) {
             case COLOR_WHITE:
-                buffer[pos.x + (pos.y / 8) * WIDTH] |= (1 << (pos.y & 7));   // Set bit
+                *byte |= (1 << (pos.y & 7));                                 // Set bit
                 break;
             case COLOR_BLACK:
-                buffer[pos.x + (pos.y / 8) * WIDTH] &= ~(1 << (pos.y & 7));  // Clear bit
+                *byte &= ~(1 << (pos.y & 7));                                // Clear bit
                 break;
             case COLOR_INVERT:
-                buffer[pos.x + (pos.y / 8) * WIDTH] ^= (1 << (pos.y & 7));   // Toggle bit
+                *byte ^= (1 << (pos.y & 7));                                 // Toggle bit
                 break;
         }
+
+        if (*byte != old_value) {
+            markDirty(page, pos.x);                                          // Only real changes are sent
+        }
     }
 }
 
@@ -155,7 +289,12 @@ void drawPixel(Point pos, OLED_color color) {
  */
 uint8_t getPixel(Point pos) {
     if ((pos.x >= 0) && (pos.x < WIDTH) && (pos.y >= 0) && (pos.y < HEIGHT)) {
-        return (buffer[pos.x + (pos.y / 8) * WIDTH] & (1 << (pos.y & 7)));
+#ifdef DISPLAY_STRIP
+        if ((pos.y >> 3) != strip_page) return 0;                            // Only the strip is held
+        return (strip[pos.x] & (1 << (pos.y & 7)));
+#else
+        return (buffer[pos.x + (pos.y >> 3) * WIDTH] & (1 << (pos.y & 7)));
+#endif
     }
     return 0;                                                                // Out of bounds returns "off"
 }
@@ -164,90 +303,22 @@ uint8_t getPixel(Point pos) {
  * LINE DRAWING WITH CLIPPING
  *==========================================================================*/
 
-/**
- * Cohen-Sutherland line clipping outcodes
- */
-#define OUTCODE_INSIDE 0  // 0000
-#define OUTCODE_LEFT   1  // 0001
-#define OUTCODE_RIGHT  2  // 0010
-#define OUTCODE_BOTTOM 4  // 0100
-#define OUTCODE_TOP    8  // 1000
-
-/**
- * Compute outcode for point relative to screen bounds
- */
-static uint8_t compute_outcode(int16_t x, int16_t y) {
-    uint8_t code = OUTCODE_INSIDE;
-    
-    if (x < 0) code |= OUTCODE_LEFT;
-    else if (x >= WIDTH) code |= OUTCODE_RIGHT;
-    
-    if (y < 0) code |= OUTCODE_TOP;
-    else if (y >= HEIGHT) code |= OUTCODE_BOTTOM;
-    
-    return code;
-}
-
-/**
- * Clip line to screen bounds using Cohen-Sutherland algorithm
- * Returns 1 if line is visible (even partially), 0 if completely outside
- */
-static uint8_t clip_line(int16_t* x0, int16_t* y0, int16_t* x1, int16_t* y1) {
-    uint8_t outcode0 = compute_outcode(*x0, *y0);
-    uint8_t outcode1 = compute_outcode(*x1, *y1);
-    
-    while (1) {
-        if (!(outcode0 | outcode1)) {
-            // Both points inside - accept
-            return 1;
-        } else if (outcode0 & outcode1) {
-            // Both points share an outside region - reject
-            return 0;
-        } else {
-            // Line crosses boundary - clip it
-            int16_t x, y;
-            uint8_t outcode_out = outcode0 ? outcode0 : outcode1;
-            
-            // Find intersection point
-            if (outcode_out & OUTCODE_BOTTOM) {
-                x = *x0 + (*x1 - *x0) * (HEIGHT - 1 - *y0) / (*y1 - *y0);
-                y = HEIGHT - 1;
-            } else if (outcode_out & OUTCODE_TOP) {
-                x = *x0 + (*x1 - *x0) * (0 - *y0) / (*y1 - *y0);
-                y = 0;
-            } else if (outcode_out & OUTCODE_RIGHT) {
-                y = *y0 + (*y1 - *y0) * (WIDTH - 1 - *x0) / (*x1 - *x0);
-                x = WIDTH - 1;
-            } else { // OUTCODE_LEFT
-                y = *y0 + (*y1 - *y0) * (0 - *x0) / (*x1 - *x0);
-                x = 0;
-            }
-            
-            // Replace outside point with intersection point
-            if (outcode_out == outcode0) {
-                *x0 = x;
-                *y0 = y;
-                outcode0 = compute_outcode(*x0, *y0);
-            } else {
-                *x1 = x;
-                *y1 = y;
-                outcode1 = compute_outcode(*x1, *y1);
-            }
-        }
-    }
-}
-
 /**
  * Draw a line using Bresenham's algorithm with clipping
- * Lines that extend off-screen are clipped to screen boundaries
+ * Lines that extend off-screen are clipped to screen boundaries. Point
+ * coordinates are 0-255, so a line is at most 256 steps long: it is walked
+ * whole instead of being cut at the edges (no divisions), and the walk
+ * stops once it has left the screen for good (the screen is convex)
  */
 void drawLine(Point start, Point end, OLED_color color) {
+    if (DISPLAY_LIST_LINE(DISPLAY_CMD_LINE, start, end, color)) return;
+
     int16_t x0 = start.x, y0 = start.y;
     int16_t x1 = end.x, y1 = end.y;
     
-    // Clip line to screen bounds
-    if (!clip_line(&x0, &y0, &x1, &y1)) {
-        return;  // Line is completely outside screen
+    // Completely off-screen (both ends right of or below the screen)
+    if ((x0 >= WIDTH && x1 >= WIDTH) || (y0 >= HEIGHT && y1 >= HEIGHT)) {
+        return;
     }
     
     // Check if line is steep (more vertical than horizontal)
@@ -267,15 +338,19 @@ void drawLine(Point start, Point end, OLED_color color) {
     
     int16_t deltaX = x1 - x0;                                                // Horizontal distance
     int16_t deltaY = abs(y1 - y0);                                           // Vertical distance (absolute)
-    int16_t error = deltaX / 2;                                              // Accumulated error for decision
+    int16_t error = deltaX >> 1;                                             // Accumulated error for decision
     int16_t yStep = (y0 < y1) ? 1 : -1;                                      // Direction to step in y
+    uint8_t entered = 0;                                                     // A pixel was on screen
     
     // Draw line pixel by pixel
     for (; x0 <= x1; x0++) {
-        if (isSteep) {
-            drawPixel((Point){y0, x0}, color);                              // Swap back for steep lines
-        } else {
-            drawPixel((Point){x0, y0}, color);
+        int16_t px = isSteep ? y0 : x0;                                      // Swap back for steep lines
+        int16_t py = isSteep ? x0 : y0;
+        if (px < WIDTH && py < HEIGHT) {
+            drawPixel((Point){px, py}, color);
+            entered = 1;
+        } else if (entered) {
+            break;                                                           // Left the screen: nothing more to draw
         }
         error -= deltaY;
         if (error < 0) {                                                     // Time to step in y direction
@@ -285,12 +360,251 @@ void drawLine(Point start, Point end, OLED_color color) {
     }
 }
 
+/*============================================================================
+ * SPAN FILLS
+ *==========================================================================*/
+// Spans work on the page layout directly: a vertical span touches at most one
+// masked byte per page, a filled rectangle one masked byte per column per page
+
+// Bits from row (y & 7) down to the bottom of the page / from the top of the
+// page down to row (y & 7), inclusive (avoids variable-length shifts on AVR)
+static const uint8_t PAGE_MASK_FROM[8] = {0xFF, 0xFE, 0xFC, 0xF8, 0xF0, 0xE0, 0xC0, 0x80};
+static const uint8_t PAGE_MASK_TO[8]   = {0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF};
+
+/**
+ * Apply a bit mask to one buffer byte
+ * @param page Page index (0-7)
+ * @param col Column index (0-127)
+ * @param mask Bits to change
+ * @param color COLOR_WHITE sets, COLOR_BLACK clears, COLOR_INVERT toggles
+ */
+static inline void writeMasked(uint8_t page, uint8_t col, uint8_t mask, OLED_color color) {
+#ifdef DISPLAY_STRIP
+    if (page != strip_page) return;                                          // Drawn with its own strip
+    uint8_t* byte = &strip[col];
+#else
+    uint8_t* byte = &buffer[page * WIDTH + col];
+#endif
+    uint8_t old_value = *byte;
+
+    switch (color) {
+        case COLOR_WHITE:  *byte |= mask;  break;
+        case COLOR_BLACK:  *byte &= ~mask; break;
+        case COLOR_INVERT: *byte ^= mask;  break;
+    }
+
+    if (*byte != old_value) {
+        markDirty(page, col);                                                // Only real changes are sent
+    }
+}
+
+/**
+ * Clip a span to [0, limit)
+ * @return 1 if anything is left, 0 if the span is empty or off-screen
+ */
+static uint8_t clipSpan(int16_t* start, int16_t* length, int16_t limit) {
+    if (*start < 0) {
+        *length += *start;
+        *start = 0;
+    }
+    if (*start + *length > limit) {
+        *length = limit - *start;
+    }
+    return *length > 0;
+}
+
+/**
+ * Draw a vertical span of pixels
+ * @param start Top pixel
+ * @param height Number of pixels (clipped to the screen)
+ * @param color Span color
+ */
+void drawVLine(Point start, int16_t height, OLED_color color) {
+    if (DISPLAY_LIST_RECT(DISPLAY_CMD_VLINE, start.x, start.y, 1, height, color)) return;
+
+    int16_t y = start.y;
+    if (start.x >= WIDTH || !clipSpan(&y, &height, HEIGHT)) return;
+
+    uint8_t y_last = y + height - 1;
+    uint8_t page = y >> 3;
+    uint8_t page_last = y_last >> 3;
+    uint8_t mask = PAGE_MASK_FROM[y & 7];
+
+    for (; page < page_last; page++) {
+        writeMasked(page, start.x, mask, color);
+        mask = 0xFF;                                                         // Middle pages are covered fully
+    }
+    writeMasked(page, start.x, mask & PAGE_MASK_TO[y_last & 7], color);
+}
+
+/**
+ * Draw a horizontal span of pixels
+ * @param start Leftmost pixel
+ * @param width Number of pixels (clipped to the screen)
+ * @param color Span color
+ */
+void drawHLine(Point start, int16_t width, OLED_color color) {
+    fillRect(start, width, 1, color);
+}
+
+/**
+ * Fill a rectangle
+ * @param tl Top-left pixel
+ * @param width Width in pixels (clipped to the screen)
+ * @param height Height in pixels (clipped to the screen)
+ * @param color Fill color
+ */
+void fillRect(Point tl, int16_t width, int16_t height, OLED_color color) {
+    if (DISPLAY_LIST_RECT(DISPLAY_CMD_FILL_RECT, tl.x, tl.y, width, height, color)) return;
+
+    int16_t x = tl.x;
+    int16_t y = tl.y;
+    if (!clipSpan(&x, &width, WIDTH) || !clipSpan(&y, &height, HEIGHT)) return;
+
+    uint8_t x_end = x + width;
+    uint8_t y_last = y + height - 1;
+    uint8_t page = y >> 3;
+    uint8_t page_last = y_last >> 3;
+    uint8_t mask = PAGE_MASK_FROM[y & 7];
+
+    for (; page <= page_last; page++) {
+        if (page == page_last) {
+            mask &= PAGE_MASK_TO[y_last & 7];
+        }
+        for (uint8_t col = x; col < x_end; col++) {
+            writeMasked(page, col, mask, color);
+        }
+        mask = 0xFF;                                                         // Middle pages are covered fully
+    }
+}
+
+/*============================================================================
+ * SPRITE BLIT
+ *==========================================================================*/
+
+/**
+ * Draw a column sprite (one 16-bit mask per column, bit 0 = top row)
+ * Each column is shifted to the page boundary and written as at most three
+ * masked bytes
+ * @param x Left column (may be off-screen)
+ * @param y Top row (may be off-screen)
+ * @param columns Column masks
+ * @param width Number of columns
+ * @param color Color for set bits
+ */
+void drawSprite(int16_t x, int16_t y, const uint16_t* columns, uint8_t width,
+                OLED_color color) {
+    if (DISPLAY_LIST_BLIT(DISPLAY_CMD_SPRITE, x, y, width, 16, columns, color)) return;
+    if (y >= HEIGHT || y <= -16) return;                                     // Entirely above or below
+
+    // Page-align: rows above the screen are shifted out of the mask
+    uint8_t shift = 0;
+    uint8_t discard = 0;
+    uint8_t page = 0;
+    if (y < 0) {
+        discard = -y;
+    } else {
+        page = y >> 3;
+        shift = y & 7;
+    }
+
+    for (uint8_t c = 0; c < width; c++, x++) {
+        if (x < 0) continue;
+        if (x >= WIDTH) break;
+
+        uint32_t mask = ((uint32_t)(columns[c] >> discard)) << shift;
+        for (uint8_t p = page; mask != 0 && p < PAGES; p++, mask >>= 8) {
+            if (mask & 0xFF) {
+                writeMasked(p, x, (uint8_t)mask, color);
+            }
+        }
+    }
+}
+
 /*============================================================================
  * BITMAP DRAWING
  *==========================================================================*/
+
+// Value of each row bit within a page byte, and of each pixel bit within a
+// row-major MSB-first byte (the spread below multiplies instead of shifting
+// by a variable count, which is a loop on AVR)
+static const uint8_t ROW_BIT[8] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+static const uint8_t MSB_BIT[8] = {0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01};
+
+#define BITMAP_CHUNK_COLUMNS 16                                              // drawBitmap() conversion chunk
+
+/**
+ * Write one row of page-format bytes (bit 0 = top) at any vertical offset
+ * Every byte lands in at most two buffer bytes: the row multiply spreads it
+ * over a 16-bit value whose low byte goes to the upper page
+ * @param x First column (on-screen, the caller clipped count to the screen)
+ * @param top Screen row of bit 0 (-7 to HEIGHT-1)
+ * @param bytes Page bytes, one per column
+ * @param count Number of columns
+ * @param keep Source bits to draw (rows past the bitmap height are dropped)
+ * @param color COLOR_WHITE ORs, COLOR_BLACK clears, COLOR_INVERT XORs
+ */
+static void blitPageRow(uint8_t x, int16_t top, const uint8_t* bytes, uint8_t count,
+                        uint8_t keep, OLED_color color) {
+    uint8_t row_bit = ROW_BIT[top & 7];                                      // Two's complement: also for top < 0
+    int8_t upper = (top >= 0) ? (int8_t)(top >> 3) : -1;                     // -1: bits above the screen
+    int8_t lower = (row_bit != 1 && upper + 1 < PAGES) ? upper + 1 : -1;
+
+    for (uint8_t c = 0; c < count; c++, x++) {
+        uint8_t bits = bytes[c] & keep;
+        if (bits == 0) continue;
+
+        uint16_t spread = (uint16_t)bits * row_bit;
+        if (upper >= 0 && (uint8_t)spread != 0) {
+            writeMasked(upper, x, (uint8_t)spread, color);
+        }
+        if (lower >= 0 && (spread >> 8) != 0) {
+            writeMasked(lower, x, (uint8_t)(spread >> 8), color);
+        }
+    }
+}
+
+void drawPageBitmap(int16_t x, int16_t y, const PageBitmap* bitmap, OLED_color color) {
+    if (bitmap == NULL) return;
+    if (DISPLAY_LIST_BLIT(DISPLAY_CMD_PAGE_BITMAP, x, y, bitmap->width, bitmap->height, bitmap, color)) return;
+    int16_t width = bitmap->width;
+    int16_t height = bitmap->height;
+    if (x >= WIDTH || x + width <= 0 || y >= HEIGHT || y + height <= 0) return;
+
+    // Clip the columns once for every page row of the blit
+    uint8_t skip = (x < 0) ? (uint8_t)(-x) : 0;
+    uint8_t count = (uint8_t)(((x + width > WIDTH) ? WIDTH - x : width) - skip);
+    uint8_t left = (uint8_t)(x + skip);
+
+    uint8_t source_pages = (uint8_t)((height + 7) >> 3);
+    const uint8_t* row = bitmap->data + skip;
+    int16_t top = y;
+    for (uint8_t page = 0; page < source_pages; page++, row += width, top += 8) {
+        if (top <= -8) continue;                                             // Above the screen
+        if (top >= HEIGHT) break;
+        uint8_t keep = (page == source_pages - 1) ? PAGE_MASK_TO[(height - 1) & 7] : 0xFF;
+        blitPageRow(left, top, row, count, keep, color);
+    }
+}
+
+void convertBitmap(const uint8_t* rows, uint8_t width, uint8_t height, uint8_t* pages) {
+    uint8_t byte_width = (uint8_t)((width + 7) >> 3);
+    memset(pages, 0, (size_t)((height + 7) >> 3) * width);
+
+    for (uint8_t r = 0; r < height; r++, rows += byte_width) {
+        uint8_t* out = &pages[(r >> 3) * width];
+        uint8_t bit = ROW_BIT[r & 7];
+        for (uint8_t c = 0; c < width; c++) {
+            if (rows[c >> 3] & MSB_BIT[c & 7]) out[c] |= bit;
+        }
+    }
+}
+
 /**
  * Draw a monochrome bitmap
  * Bitmap format: 1 bit per pixel, packed into bytes, MSB first
+ * Converted to page format 8 rows x BITMAP_CHUNK_COLUMNS columns at a time
+ * and blitted like a PageBitmap
  * @param pos Top-left position
  * @param bitmap Pointer to bitmap data in memory
  * @param width Bitmap width in pixels
@@ -298,19 +612,32 @@ void drawLine(Point start, Point end, OLED_color color) {
  */
 void drawBitmap(Point pos, uint8_t *bitmap, int16_t width, int16_t height, 
                  OLED_color color) {
-    int16_t byteWidth = (width + 7) / 8;                                     // Bytes per row (rounded up)
-    uint8_t currentByte = 0;
-    
-    for (int16_t row = 0; row < height; row++, pos.y++) {
-        for (int16_t col = 0; col < width; col++) {
-            if (col & 7) {                                                   // Not on byte boundary
-                currentByte <<= 1;                                           // Shift to next bit
-            } else {                                                         // Start of new byte
-                currentByte = bitmap[row * byteWidth + col / 8];
-            }
-            if (currentByte & 0x80) {                                        // Check MSB (current pixel)
-                drawPixel((Point){pos.x + col, pos.y}, color);
+    if (bitmap == NULL || width <= 0 || height <= 0) return;
+    if (DISPLAY_LIST_BLIT(DISPLAY_CMD_BITMAP, pos.x, pos.y, width, height, bitmap, color)) return;
+    if (pos.x >= WIDTH || pos.y >= HEIGHT) return;
+
+    int16_t byte_width = (width + 7) >> 3;                                   // Bytes per row (rounded up)
+    int16_t visible = (pos.x + width > WIDTH) ? WIDTH - pos.x : width;       // Columns clipped once
+
+    for (int16_t band = 0; band < height && pos.y + band < HEIGHT; band += 8) {
+        uint8_t rows = (height - band < 8) ? (uint8_t)(height - band) : 8;
+        const uint8_t* band_rows = &bitmap[band * byte_width];
+
+        for (int16_t first = 0; first < visible; first += BITMAP_CHUNK_COLUMNS) {
+            uint8_t columns = (visible - first < BITMAP_CHUNK_COLUMNS) ? (uint8_t)(visible - first)
+                                                                        : BITMAP_CHUNK_COLUMNS;
+            uint8_t bytes[BITMAP_CHUNK_COLUMNS] = {0};
+
+            // Gather the band's bits into page bytes (bit 0 = top row)
+            for (uint8_t r = 0; r < rows; r++) {
+                const uint8_t* row = &band_rows[r * byte_width];
+                for (uint8_t c = 0; c < columns; c++) {
+                    int16_t col = first + c;
+                    if (row[col >> 3] & MSB_BIT[col & 7]) bytes[c] |= ROW_BIT[r];
+                }
             }
+
+            blitPageRow((uint8_t)(pos.x + first), pos.y + band, bytes, columns, 0xFF, color);
         }
     }
 }
@@ -318,13 +645,49 @@ void drawBitmap(Point pos, uint8_t *bitmap, int16_t width, int16_t height,
 /*============================================================================
  * DISPLAY CONTROL
  *==========================================================================*/
+#ifdef DISPLAY_STRIP
+/**
+ * Clear the display (empty the display list)
+ * Pages that showed anything differ from the empty list, so the next
+ * refresh sends them blank
+ */
+void clearDisplay(void) {
+    display_list_reset();
+}
+#else
+/**
+ * Zero some 8-column blocks of one page of buffer
+ */
+static void blankBlocks(uint8_t page, uint16_t blocks) {
+    if (blocks == DIRTY_ALL_BLOCKS) {
+        memset(&buffer[page * WIDTH], 0, WIDTH);
+        return;
+    }
+    for (uint8_t block = 0; block < DIRTY_BLOCK_COUNT; block++) {
+        if (blocks & BLOCK_BIT[block]) {
+            memset(&buffer[page * WIDTH + (block << DIRTY_BLOCK_SHIFT)], 0, 1 << DIRTY_BLOCK_SHIFT);
+        }
+    }
+}
+
 /**
  * Clear the display buffer (set all pixels to off)
  * Does not update display - call showScreen() to make visible
+ * Only blocks drawn since the last clear are touched; they become dirty so
+ * the next refresh erases them on the display
  */
 void clearDisplay(void) {
-    memset(buffer, 0, WIDTH * ((HEIGHT + 7) / 8));
+    for (uint8_t page = 0; page < PAGES; page++) {
+        uint16_t drawn = drawn_blocks[page];
+        dirty_blocks[page] |= drawn | streamed_blocks[page];                 // Streamed ink: display only
+        streamed_blocks[page] = 0;
+        if (drawn == 0) continue;                                            // Page already blank
+
+        blankBlocks(page, drawn);
+        drawn_blocks[page] = 0;
+    }
 }
+#endif
 
 /**
  * Invert display colors at hardware level
@@ -339,27 +702,490 @@ void invertDisplay(uint8_t invert) {
     }
 }
 
+void sleepDisplay(uint8_t sleep) {
+    sendCommand(sleep ? SH1106_DISPLAYOFF : SH1106_DISPLAYON);
+}
+
+/*============================================================================
+ * DISPLAY TRANSFER
+ *==========================================================================*/
+// buffer is the back buffer that all drawing goes into. The front is a list
+// of column windows (runs) to send; swapBuffers() latches the dirty blocks
+// into it and copies as many runs as fit into front_buffer, so drawing can
+// continue while the SPI interrupt streams them out. Runs that did not fit
+// keep pointing into buffer and are streamed first.
+//
+// In strip mode the display list is the back buffer; the front is the one
+// strip being sent, as a single run covering its page.
+
+/**
+ * One column window to send: address commands followed by length bytes
+ */
+typedef struct {
+    const uint8_t* data;                                                     // Source bytes (buffer or front_buffer)
+    uint8_t page;                                                            // Page address (0-7)
+    uint8_t column;                                                          // First visible column
+    uint8_t length;                                                          // Number of columns
+} DisplayRun;
+
+/**
+ * SPI interrupt state machine states
+ */
+typedef enum {
+    STREAM_PAGE,                                                             // Send page address command
+    STREAM_COLUMN_LOW,                                                       // Send lower column nibble
+    STREAM_COLUMN_HIGH,                                                      // Send upper column nibble
+    STREAM_DATA,                                                             // Send run data bytes
+    STREAM_FINISH                                                            // Last byte done, release bus
+} StreamState;
+
+static DisplayRun front_runs[DISPLAY_MAX_RUNS];
+static uint8_t front_run_count = 0;
+#ifndef DISPLAY_STRIP
+static uint8_t front_first_staged = 0;                                       // Runs before this read from buffer
+static uint8_t front_pending = 0;                                            // Swapped but not yet started
+static uint8_t front_buffer[DISPLAY_FRONT_BUFFER_SIZE];
+#endif
+
+static volatile uint8_t stream_run = 0;                                      // Index of run being sent
+static StreamState stream_state = STREAM_FINISH;
+static uint8_t stream_pos = 0;                                               // Byte index within current run
+static uint8_t stream_dc_level = 0;                                          // Current D/C line level
+
+/**
+ * Block until the background transfer (if any) has finished
+ */
+static void waitForTransfer(void) {
+    while (stream_busy) {}
+}
+
+/**
+ * Hand front_runs to the SPI interrupt (the bus must be idle)
+ */
+static void startTransfer(void) {
+    stream_run = 0;
+    stream_state = STREAM_PAGE;
+    stream_busy = 1;
+
+    hal_display_dc(0);                                                       // Bus is idle: start in command mode
+    stream_dc_level = 0;
+    hal_display_select(1);                                                   // Hold CS low for whole transfer
+    hal_spi_set_interrupt(HAL_SPI_IRQ_DATA_EMPTY);                           // ISR fills the buffer from here
+}
+
+#ifndef DISPLAY_STRIP
+/**
+ * Set the SH1106 RAM write position
+ * The 132-column controller drives a 128-column display, so visible
+ * column 0 sits at RAM column 2
+ * @param page Page address (0-7)
+ * @param col Visible column (0-127)
+ */
+static void setAddress(uint8_t page, uint8_t col) {
+    uint8_t ram_col = col + SH1106_COLUMN_OFFSET;
+    uint8_t commands[3] = {
+        SH1106_SETPAGE | page,
+        SH1106_SETLOWCOLUMN | (ram_col & 0x0F),
+        SH1106_SETHIGHCOLUMN | (ram_col >> 4)
+    };
+    sendCommandBlock(commands, sizeof(commands));
+}
+
+/**
+ * Count the runs of consecutive set bits in a page's dirty mask
+ */
+static uint8_t countRuns(uint16_t dirty) {
+    uint16_t starts = dirty & ~(dirty << 1);                                 // First block of every run
+    uint8_t count = 0;
+    while (starts) {
+        starts &= starts - 1;                                                // Clear lowest set bit
+        count++;
+    }
+    return count;
+}
+
+/**
+ * Append a run pointing into buffer to the front list
+ */
+static void addRun(uint8_t page, uint8_t first_block, uint8_t end_block) {
+    uint8_t start_col = first_block << DIRTY_BLOCK_SHIFT;
+    uint8_t length = (end_block - first_block) << DIRTY_BLOCK_SHIFT;
+
+    DisplayRun* run = &front_runs[front_run_count++];
+    run->data = &buffer[page * WIDTH + start_col];
+    run->page = page;
+    run->column = start_col;
+    run->length = length;
+
+    refresh_byte_count += length;
+}
+
+/**
+ * Convert the dirty blocks into front runs and reset the dirty state
+ * If a page has more runs than the list can hold, it is sent as a single
+ * window from its first to its last dirty block instead (superset)
+ */
+static void collectRuns(void) {
+    uint8_t dirty_pages_left = 0;
+    for (uint8_t page = 0; page < PAGES; page++) {
+        if (dirty_blocks[page]) dirty_pages_left++;
+    }
+
+    front_run_count = 0;
+    refresh_byte_count = 0;
+
+    for (uint8_t page = 0; page < PAGES; page++) {
+        uint16_t dirty = dirty_blocks[page];
+        if (dirty == 0) continue;                                            // Nothing changed on this page
+        dirty_pages_left--;
+
+        uint8_t block = 0;
+        while (!(dirty & BLOCK_BIT[block])) block++;                         // First dirty block
+
+        // Always keep one slot free for every dirty page still to come
+        if (front_run_count + countRuns(dirty) + dirty_pages_left > DISPLAY_MAX_RUNS) {
+            uint8_t last_block = DIRTY_BLOCK_COUNT - 1;
+            while (!(dirty & BLOCK_BIT[last_block])) last_block--;
+            addRun(page, block, last_block + 1);
+        } else {
+            while (block < DIRTY_BLOCK_COUNT) {
+                if (!(dirty & BLOCK_BIT[block])) {
+                    block++;
+                    continue;
+                }
+
+                // Extend the run over consecutive dirty blocks
+                uint8_t first_block = block;
+                while (block < DIRTY_BLOCK_COUNT && (dirty & BLOCK_BIT[block])) {
+                    block++;
+                }
+                addRun(page, first_block, block);
+            }
+        }
+
+        dirty_blocks[page] = 0;
+    }
+}
+#endif
+
+/**
+ * Feed the next byte of the front to SPI
+ * Runs from the SPI data register empty interrupt (via the HAL), keeping the transmit buffer
+ * full. D/C may only change once the shift register is empty, so between
+ * command and data bytes the ISR switches to the transmit complete
+ * interrupt, flips D/C there and then continues on data register empty.
+ */
+static void streamNextByte(void) {
+    uint8_t dc_level = (stream_state == STREAM_DATA) ? 1 : 0;
+
+    if (stream_state == STREAM_FINISH || dc_level != stream_dc_level) {
+        if (!hal_spi_idle()) {
+            hal_spi_set_interrupt(HAL_SPI_IRQ_TX_COMPLETE);                  // Resume when the bus drains
+            return;
+        }
+
+        if (stream_state == STREAM_FINISH) {
+            hal_spi_set_interrupt(HAL_SPI_IRQ_NONE);                         // Stop transfer interrupts
+            hal_display_select(0);                                           // Deassert CS
+            stream_busy = 0;
+            return;
+        }
+
+        hal_display_dc(dc_level);                                            // Data or command mode
+        stream_dc_level = dc_level;
+        hal_spi_set_interrupt(HAL_SPI_IRQ_DATA_EMPTY);
+    }
+
+    const DisplayRun* run = &front_runs[stream_run];
+    uint8_t ram_col = run->column + SH1106_COLUMN_OFFSET;
+    uint8_t next_byte;
+
+    switch (stream_state) {
+        case STREAM_PAGE:
+            stream_state = STREAM_COLUMN_LOW;
+            next_byte = SH1106_SETPAGE | run->page;
+            break;
+
+        case STREAM_COLUMN_LOW:
+            stream_state = STREAM_COLUMN_HIGH;
+            next_byte = SH1106_SETLOWCOLUMN | (ram_col & 0x0F);
+            break;
+
+        case STREAM_COLUMN_HIGH:
+            stream_state = STREAM_DATA;
+            stream_pos = 0;
+            next_byte = SH1106_SETHIGHCOLUMN | (ram_col >> 4);
+            break;
+
+        default:  // STREAM_DATA
+            next_byte = run->data[stream_pos++];
+            if (stream_pos == run->length) {
+                LATENCY_RUN_SENT(run->page, run->column, run->length);
+                stream_run++;
+                stream_state = (stream_run == front_run_count) ? STREAM_FINISH : STREAM_PAGE;
+            }
+            break;
+    }
+
+    hal_spi_write(next_byte);                                                // Buffer has room: returns at once
+}
+
+#ifdef DISPLAY_STRIP
+/**
+ * Rasterize every page whose display list commands changed and send it
+ * Each page is rasterized into one strip while the page before is sent
+ * from the other; returns once the last strip has been started
+ */
+void refreshDisplayAsync(void) {
+    uint8_t next_strip = 0;
+
+    waitForTransfer();
+    refresh_byte_count = 0;
+
+    for (uint8_t page = 0; page < PAGES; page++) {
+        uint16_t signature = display_list_signature(page);
+        if (signature == sent_signatures[page]) continue;                   // Page unchanged
+
+        strip = strips[next_strip];                                          // Not the strip being sent
+        if (++next_strip == DISPLAY_STRIP_COUNT) next_strip = 0;
+        memset(strip, 0, WIDTH);
+        strip_page = page;
+        display_list_render(page);
+        strip_page = PAGES;
+
+        waitForTransfer();                                                   // Previous strip is out
+        front_runs[0] = (DisplayRun){strip, page, 0, WIDTH};
+        front_run_count = 1;
+        refresh_byte_count += WIDTH;
+        sent_signatures[page] = signature;
+        startTransfer();
+    }
+}
+
+/**
+ * Rasterize and send every changed page, then wait for the transfer
+ */
+void refreshDisplay(void) {
+    refreshDisplayAsync();
+    waitForTransfer();
+}
+
+/**
+ * Nothing to latch: the display list is only read by refreshes
+ */
+void swapBuffers(void) {
+    waitForTransfer();
+}
+
+/**
+ * Check for pages whose commands changed since they were last sent
+ */
+uint8_t displayChanged(void) {
+    for (uint8_t page = 0; page < PAGES; page++) {
+        if (display_list_signature(page) != sent_signatures[page]) return 1;
+    }
+    return 0;
+}
+
+/**
+ * Forget what the display shows so the next refresh resends every page
+ */
+void invalidateDisplay(void) {
+    for (uint8_t page = 0; page < PAGES; page++) {
+        sent_signatures[page] = DISPLAY_SIGNATURE_NONE;                      // Matches no page
+    }
+}
+#else
+
 /**
  * Update the physical display with contents of buffer
- * SH1106 requires Read-Modify-Write mode due to 132-column controller
- * driving 128-column display (2-pixel offset)
+ * Each page is scanned for runs of dirty blocks; every run is sent as one
+ * column window (3 address commands + data), clean pages are skipped
  */
 void refreshDisplay() {
-    for (uint8_t page = 0; page < 8; page++) {
-        sendCommand(0xB0 | page);                                            // Set page address (0-7)
-        
-        sendCommand(0xE0);                                                   // Enter Read-Modify-Write mode
-        
-        // Send 2 dummy bytes to account for 2-column offset of SH1106
-        for (uint8_t i = 0; i < 2; i++) {
-            sendData(0x00);
-        }
-        
-        // Send all 128 columns of data for this page
-        for (uint8_t col = 0; col < 128; col++) {
-            sendData(buffer[(page * 128) + col]);
+    waitForTransfer();
+    if (!front_pending) {
+        collectRuns();
+    }
+    front_pending = 0;
+
+    for (uint8_t i = 0; i < front_run_count; i++) {
+        const DisplayRun* run = &front_runs[i];
+        setAddress(run->page, run->column);
+        sendDataBlock(run->data, run->length);
+        LATENCY_RUN_SENT(run->page, run->column, run->length);
+    }
+}
+
+/**
+ * Latch the dirty regions of buffer into the front
+ * Copies runs into front_buffer starting from the last one, so any runs
+ * that do not fit come first in the transfer and free buffer soonest
+ */
+void swapBuffers(void) {
+    waitForTransfer();
+    collectRuns();
+    front_pending = 1;
+
+    uint8_t space = DISPLAY_FRONT_BUFFER_SIZE;
+    uint8_t run = front_run_count;
+    while (run > 0 && front_runs[run - 1].length <= space) {
+        run--;
+        space -= front_runs[run].length;
+        memcpy(&front_buffer[space], front_runs[run].data, front_runs[run].length);
+        front_runs[run].data = &front_buffer[space];
+    }
+    front_first_staged = run;
+}
+
+/**
+ * Start streaming the front to the display in the background
+ * Returns as soon as buffer may be drawn into again
+ */
+void refreshDisplayAsync(void) {
+    if (!front_pending) {
+        swapBuffers();
+    }
+    front_pending = 0;
+
+    if (front_run_count == 0) return;                                        // Frame unchanged
+
+    startTransfer();
+
+    // Runs that did not fit the front buffer still read from buffer
+    while (stream_run < front_first_staged) {}
+}
+
+/**
+ * Check for blocks drawn since the last refresh
+ */
+uint8_t displayChanged(void) {
+    if (front_pending && front_run_count != 0) return 1;                     // Swapped, not yet sent
+    for (uint8_t page = 0; page < PAGES; page++) {
+        if (dirty_blocks[page]) return 1;
+    }
+    return 0;
+}
+
+/**
+ * Mark the whole buffer as changed so the next refresh resends everything
+ */
+void invalidateDisplay(void) {
+    for (uint8_t page = 0; page < PAGES; page++) {
+        dirty_blocks[page] = DIRTY_ALL_BLOCKS;
+        streamed_blocks[page] = 0;                                           // Resent from buffer
+    }
+}
+
+/**
+ * Get the display buffer (read only)
+ */
+const uint8_t* getDisplayBuffer(void) {
+    return buffer;
+}
+#endif
+
+/**
+ * Check whether a background transfer is still running
+ */
+uint8_t displayBusy(void) {
+    return stream_busy;
+}
+
+/**
+ * Get the number of data bytes sent by the last refresh (sync or async)
+ */
+uint16_t getRefreshByteCount(void) {
+    return refresh_byte_count;
+}
+
+/*============================================================================
+ * FULL-SCREEN IMAGES
+ *==========================================================================*/
+
+/**
+ * Position in an encoded image
+ */
+typedef struct {
+    const uint8_t* next;                                                     // Next encoded byte
+    uint8_t left;                                                            // Bytes left in the current run
+    uint8_t literal;                                                         // 1 = literal run, 0 = repeat
+    uint8_t value;                                                           // Repeated byte
+} ScreenReader;
+
+/**
+ * Decode the next image byte
+ */
+static uint8_t readScreenByte(ScreenReader* reader) {
+    if (reader->left == 0) {
+        uint8_t tag = *reader->next++;
+        reader->left = (tag & ~SCREEN_RUN_REPEAT) + 1;
+        reader->literal = !(tag & SCREEN_RUN_REPEAT);
+        if (!reader->literal) reader->value = *reader->next++;
+    }
+    reader->left--;
+    return reader->literal ? *reader->next++ : reader->value;
+}
+
+#ifdef DISPLAY_STRIP
+// Replays of a screen command decode it page by page; pages are rasterized
+// in order, so the reader carries on from the last page decoded
+static ScreenReader strip_reader;
+static const uint8_t* strip_reader_image = NULL;
+static uint8_t strip_reader_page = 0;                                        // Page strip_reader is at
+
+void streamScreen(const uint8_t* image) {
+    if (DISPLAY_LIST_SCREEN(image)) return;                                  // Recorded: replaces the list
+
+    if (image != strip_reader_image || strip_page < strip_reader_page) {
+        strip_reader = (ScreenReader){image, 0, 0, 0};                       // Decode from the start
+        strip_reader_image = image;
+        strip_reader_page = 0;
+    }
+    for (; strip_reader_page < strip_page; strip_reader_page++) {            // Skip unchanged pages
+        for (uint8_t col = 0; col < WIDTH; col++) readScreenByte(&strip_reader);
+    }
+    for (uint8_t col = 0; col < WIDTH; col++) {
+        strip[col] = readScreenByte(&strip_reader);                          // First command: strip is blank
+    }
+    strip_reader_page++;
+}
+#else
+void streamScreen(const uint8_t* image) {
+    ScreenReader reader = {image, 0, 0, 0};
+    uint8_t chunk[1 << DIRTY_BLOCK_SHIFT];
+
+    waitForTransfer();
+
+    for (uint8_t page = 0; page < PAGES; page++) {
+        // Blocks that may show ink on the display now (a latched front may
+        // not have been sent yet: then any block may)
+        uint16_t stale = front_pending ? DIRTY_ALL_BLOCKS
+                                       : (dirty_blocks[page] | drawn_blocks[page] | streamed_blocks[page]);
+        uint16_t inked = 0;
+        uint8_t next_col = WIDTH;                                            // Display write position (unknown)
+
+        for (uint8_t block = 0; block < DIRTY_BLOCK_COUNT; block++) {
+            uint8_t ink = 0;
+            for (uint8_t i = 0; i < sizeof(chunk); i++) {
+                chunk[i] = readScreenByte(&reader);
+                ink |= chunk[i];
+            }
+            if (ink) inked |= BLOCK_BIT[block];
+            if (!ink && !(stale & BLOCK_BIT[block])) continue;               // Blank before and after
+
+            uint8_t col = block << DIRTY_BLOCK_SHIFT;
+            if (col != next_col) setAddress(page, col);
+            sendDataBlock(chunk, sizeof(chunk));
+            next_col = col + sizeof(chunk);
         }
-        
-        sendCommand(0xEE);                                                   // Exit Read-Modify-Write mode
+
+        // The display now shows the image: buffer only has to be blank
+        blankBlocks(page, drawn_blocks[page]);
+        drawn_blocks[page] = 0;
+        dirty_blocks[page] = 0;
+        streamed_blocks[page] = inked;
     }
-}
\ No newline at end of file
+    front_pending = 0;                                                       // Overwritten by the image
+}
+#endif
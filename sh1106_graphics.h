@@ -26,9 +26,19 @@
  *     CS             <->    PC3 (Chip Select)
  *
  * INITIALIZATION
- *     In main(), call in order:
- *     1. initSPI()
- *     2. initScreen()
+ *     In main(), after init_delay() (timer.h):
+ *         initScreen();                // Blocks for the panel power-up
+ *     or, to do other set-up while the panel powers up:
+ *         beginScreenInit();
+ *         ...                          // No display access here
+ *         endScreenInit();
+ *
+ * BUILD FLAGS
+ *     DISPLAY_STRIP - page-strip renderer: no 1KB buffer; drawing calls are
+ *                     recorded in a display list (display_list.h) and each
+ *                     refresh rasterizes the changed pages one 128-byte strip
+ *                     at a time, sending one strip while the next is drawn.
+ *                     The whole scene must be drawn every frame.
  *
  * USAGE
  *     Low-level approach (pixels, lines, bitmaps):
@@ -38,8 +48,9 @@
  *     
  *     Object-oriented approach (recommended for shapes):
  *         #include "shapes.h"
- *         Shape* circle = create_circle((Point){64, 32}, 15, 1);
- *         shape_draw(circle, COLOR_WHITE);
+ *         Shape circle;
+ *         create_circle(&circle, (Point){64, 32}, 15, 1, COLOR_WHITE);
+ *         draw(&circle);
  *         showScreen();
  *
  *==========================================================================*/
@@ -54,12 +65,46 @@
  *==========================================================================*/
 #define WIDTH   128                                                          // Display width in pixels
 #define HEIGHT  64                                                           // Display height in pixels
+#define PAGES   ((HEIGHT + 7) / 8)                                           // 8-pixel-tall pages in buffer
 
 /*============================================================================
  * DISPLAY COMMANDS
  *==========================================================================*/
 #define GRAYOLED_NORMALDISPLAY 0xA6                                          // Normal display mode (0=off, 1=on)
 #define GRAYOLED_INVERTDISPLAY 0xA7                                          // Inverted display mode (0=on, 1=off)
+#define SH1106_DISPLAYOFF      0xAE                                          // Panel off, controller asleep (RAM kept)
+#define SH1106_DISPLAYON       0xAF                                          // Panel on
+#define SH1106_SETLOWCOLUMN    0x00                                          // Lower nibble of column address
+#define SH1106_SETHIGHCOLUMN   0x10                                          // Upper nibble of column address
+#define SH1106_SETPAGE         0xB0                                          // Page address (0-7)
+#define SH1106_COLUMN_OFFSET   2                                             // 132-column RAM, 128 visible columns
+
+/*============================================================================
+ * POWER-UP TIMING (SH1106 datasheet minimums)
+ *==========================================================================*/
+#define SH1106_RESET_PULSE_US    10                                          // RES low time
+#define SH1106_RESET_RECOVERY_US 2                                           // RES high to first command
+#define SH1106_POWER_SETTLE_MS   100                                         // DC-DC on to display on
+
+/*============================================================================
+ * ASYNC REFRESH CONFIGURATION
+ *==========================================================================*/
+#ifdef DISPLAY_STRIP
+#define DISPLAY_STRIP_COUNT       2                                          // Page strips: one drawn, one sent
+#define DISPLAY_MAX_RUNS          1                                          // One strip per transfer
+
+// Static RAM of the driver: strips, sent page signatures, run, screen reader
+// (the display list itself: DISPLAY_LIST_RAM_BYTES)
+#define DISPLAY_RAM_BYTES (DISPLAY_STRIP_COUNT * WIDTH + PAGES * sizeof(uint16_t) + \
+                           DISPLAY_MAX_RUNS * (sizeof(const uint8_t*) + 3) + 2 * sizeof(const uint8_t*) + 4)
+#else
+#define DISPLAY_FRONT_BUFFER_SIZE 128                                        // Bytes of changes copied per swap (max 255)
+#define DISPLAY_MAX_RUNS          16                                         // Column windows per frame (>= PAGES)
+
+// Static RAM of the driver: buffer, dirty/drawn/streamed masks, front buffer, run list
+#define DISPLAY_RAM_BYTES (WIDTH * PAGES + 3 * PAGES * sizeof(uint16_t) + DISPLAY_FRONT_BUFFER_SIZE + \
+                           DISPLAY_MAX_RUNS * (sizeof(const uint8_t*) + 3))
+#endif
 
 /*============================================================================
  * TYPE DEFINITIONS
@@ -90,15 +135,28 @@ typedef struct {
  *==========================================================================*/
 /**
  * Initialize SPI peripheral
- * Configures SPI0 in host mode, Mode 3, at f_clk/8
- * Must be called before initScreen()
+ * Configures SPI0 in host mode, Mode 3, buffer mode, at f_clk / CLOCK_SPI_DIV
+ * Called by beginScreenInit() / initScreen()
  */
 void initSPI(void);
 
 /**
- * Initialize the OLED display
- * Performs hardware reset and sends initialization sequence
- * Must be called after initSPI()
+ * Start bringing up the OLED display
+ * Sets up SPI, resets the controller and sends the configuration (with
+ * the datasheet minimum timings), then returns while the panel's DC-DC
+ * converter settles. Requires init_delay().
+ */
+void beginScreenInit(void);
+
+/**
+ * Finish bringing up the OLED display
+ * Waits for whatever is left of SH1106_POWER_SETTLE_MS since
+ * beginScreenInit(), then switches the panel on
+ */
+void endScreenInit(void);
+
+/**
+ * Initialize the OLED display (beginScreenInit() + endScreenInit())
  */
 void initScreen(void);
 
@@ -109,6 +167,22 @@ void sendByteSPI(uint8_t byteToSend);
 void sendCommand(uint8_t commandByte);
 void sendData(uint8_t dataByte);
 
+/**
+ * Send a block of command bytes in one burst
+ * D/C is set once and CS stays low for the whole block
+ * @param commands Command bytes
+ * @param length Number of bytes
+ */
+void sendCommandBlock(const uint8_t* commands, uint16_t length);
+
+/**
+ * Send a block of display data bytes in one burst
+ * D/C is set once and CS stays low for the whole block
+ * @param data Data bytes (e.g. one page run of buffer)
+ * @param length Number of bytes
+ */
+void sendDataBlock(const uint8_t* data, uint16_t length);
+
 /*============================================================================
  * PIXEL OPERATIONS
  *==========================================================================*/
@@ -121,6 +195,7 @@ void drawPixel(Point pos, OLED_color color);
 
 /**
  * Get pixel state from display buffer
+ * Strip mode: only pixels of the page being rasterized are known
  * @param pos Pixel coordinates
  * @return Non-zero if pixel is set, 0 if clear or out of bounds
  */
@@ -138,11 +213,88 @@ uint8_t getPixel(Point pos);
  */
 void drawLine(Point start, Point end, OLED_color color);
 
+/*============================================================================
+ * SPAN FILLS
+ *==========================================================================*/
+/**
+ * Draw a vertical span (at most one masked byte per page)
+ * @param start Top pixel
+ * @param height Number of pixels (clipped to the screen)
+ * @param color Span color
+ */
+void drawVLine(Point start, int16_t height, OLED_color color);
+
+/**
+ * Draw a horizontal span (one masked byte per column)
+ * @param start Leftmost pixel
+ * @param width Number of pixels (clipped to the screen)
+ * @param color Span color
+ */
+void drawHLine(Point start, int16_t width, OLED_color color);
+
+/**
+ * Fill a rectangle with masked byte writes, one pass per page row
+ * @param tl Top-left pixel
+ * @param width Width in pixels (clipped to the screen)
+ * @param height Height in pixels (clipped to the screen)
+ * @param color Fill color
+ */
+void fillRect(Point tl, int16_t width, int16_t height, OLED_color color);
+
+/*============================================================================
+ * SPRITE BLIT
+ *==========================================================================*/
+/**
+ * Draw a pre-rasterized column sprite (shift-and-mask blit into buffer)
+ * @param x Left column (may be partly off-screen)
+ * @param y Top row (may be partly off-screen)
+ * @param columns One 16-bit mask per column, bit 0 = top row
+ * @param width Number of columns
+ * @param color Color for set bits
+ */
+void drawSprite(int16_t x, int16_t y, const uint16_t* columns, uint8_t width,
+                OLED_color color);
+
 /*============================================================================
  * BITMAP DRAWING
  *==========================================================================*/
 /**
- * Draw a monochrome bitmap
+ * Bitmap in display page order (the fast format)
+ * Column-major within 8-row pages, like buffer: byte [page * width + col]
+ * holds rows 8*page to 8*page+7 of a column, bit 0 = top. Rows past height
+ * in the last page are ignored. The ATtiny1627 maps flash into the data
+ * space, so a const bitmap is drawn straight from flash (no PROGMEM reads
+ * needed).
+ */
+typedef struct {
+    uint8_t width;                                                           // Columns
+    uint8_t height;                                                          // Rows
+    const uint8_t* data;                                                     // ((height + 7) / 8) * width bytes
+} PageBitmap;
+
+/**
+ * Draw a page-format bitmap
+ * Clipped once per blit; each column costs one byte per page when y is a
+ * multiple of 8, two otherwise
+ * @param x Left column (may be partly off-screen)
+ * @param y Top row (may be partly off-screen)
+ * @param bitmap Bitmap to draw
+ * @param color COLOR_WHITE sets (OR), COLOR_BLACK clears (AND-NOT),
+ *              COLOR_INVERT toggles (XOR) the bitmap's set pixels
+ */
+void drawPageBitmap(int16_t x, int16_t y, const PageBitmap* bitmap, OLED_color color);
+
+/**
+ * Convert a row-major MSB-first bitmap to page format (once, e.g. at init)
+ * @param rows Source: ((width + 7) / 8) bytes per row, MSB = left pixel
+ * @param width Bitmap width in pixels
+ * @param height Bitmap height in pixels
+ * @param pages Destination: ((height + 7) / 8) * width bytes
+ */
+void convertBitmap(const uint8_t* rows, uint8_t width, uint8_t height, uint8_t* pages);
+
+/**
+ * Draw a monochrome bitmap (compatibility format, slower than a PageBitmap)
  * Bitmap format: 1 bit per pixel, packed into bytes, MSB first
  * @param pos Top-left position
  * @param bitmap Pointer to bitmap data in memory
@@ -159,6 +311,7 @@ void drawBitmap(Point pos, uint8_t *bitmap, int16_t width, int16_t height,
 /**
  * Clear the display buffer (set all pixels to off)
  * Does not update physical display - call showScreen() to make visible
+ * Strip mode: empties the display list
  */
 void clearDisplay(void);
 
@@ -168,10 +321,102 @@ void clearDisplay(void);
  */
 void invertDisplay(uint8_t invert);
 
+/**
+ * Put the display to sleep or wake it up
+ * While asleep the panel is dark and its RAM (and buffer) is kept, so
+ * waking shows the same frame without a refresh
+ * @param sleep 1 to switch the panel off, 0 to switch it back on
+ */
+void sleepDisplay(uint8_t sleep);
+
 /**
  * Update the physical display with contents of buffer
  * Call this after drawing operations to make changes visible
+ * Only the column blocks that changed since the last refresh are sent
+ * (strip mode: the pages whose display list commands changed)
  */
 void refreshDisplay(void);
 
+/**
+ * Hand the changes drawn into buffer (back buffer) to the front
+ * Waits for a transfer still in progress, then copies the changed column
+ * windows into a small front buffer so drawing can carry on during the
+ * transfer. Called by refreshDisplayAsync() if not done explicitly.
+ * Strip mode: only waits for the transfer (the list is never latched)
+ */
+void swapBuffers(void);
+
+/**
+ * Start sending the front to the display in the background
+ * The SPI interrupt streams the page/column commands and data while the
+ * caller continues (input, physics, drawing the next frame).
+ * Returns once buffer may be drawn into again - immediately when the
+ * changes fit the front buffer, otherwise after the part that did not fit
+ * has been sent. Requires global interrupts to be enabled.
+ * Strip mode: rasterizes and sends the changed pages in turn, each strip in
+ * the background while the next page is rasterized; returns once the last
+ * one has started
+ */
+void refreshDisplayAsync(void);
+
+/**
+ * Check whether a background refresh is still being sent
+ * @return 1 while transferring, 0 when the display link is free
+ */
+uint8_t displayBusy(void);
+
+/**
+ * Check whether anything was drawn since the last refresh
+ * @return 1 if a refresh would send data, 0 if the display is up to date
+ */
+uint8_t displayChanged(void);
+
+/**
+ * Mark the whole buffer as changed
+ * The next refreshDisplay() resends every page, e.g. after the display
+ * RAM was overwritten outside of buffer
+ */
+void invalidateDisplay(void);
+
+/**
+ * Get the number of data bytes sent by the last refresh (sync or async)
+ * A full frame is 1024 bytes
+ * @return Data bytes sent (excludes command bytes)
+ */
+uint16_t getRefreshByteCount(void);
+
+#ifndef DISPLAY_STRIP
+/**
+ * Get the display buffer (read only), e.g. to checksum a frame
+ * @return WIDTH * PAGES bytes in page order
+ */
+const uint8_t* getDisplayBuffer(void);
+#endif
+
+/*============================================================================
+ * FULL-SCREEN IMAGES
+ *==========================================================================*/
+// Static screens are stored in flash run-length encoded, page after page in
+// buffer byte order (runs never cross a page):
+//     0nnnnnnn b0 .. bn    n+1 literal bytes
+//     1nnnnnnn b           byte b repeated n+1 times
+#define SCREEN_RUN_REPEAT 0x80
+#define SCREEN_RUN_MAX    128                                                // Bytes per run
+
+/**
+ * Send a full-screen image straight to the display
+ * Decodes the image into the page data writes without drawing it into
+ * buffer (waits for a transfer in progress first). 8-column blocks that
+ * are blank in the image and known to be blank on the display are skipped.
+ * Afterwards buffer is blank and nothing is left to send; the blocks the
+ * image inked are remembered, so the next clearDisplay() erases them on the
+ * display like drawn blocks.
+ * Anything drawn on top (e.g. a score) replaces whole 8-column blocks on
+ * the next refresh: keep it in blocks the image leaves blank.
+ * Strip mode: starts a new display list with the image, so it is decoded
+ * into each strip and anything drawn on top is merged with it
+ * @param image Encoded image (PAGES * WIDTH bytes once decoded)
+ */
+void streamScreen(const uint8_t* image);
+
 #endif // SH1106_GRAPHICS_H
\ No newline at end of file
@@ -3,13 +3,14 @@
  *============================================================================
  * Object-oriented shape abstraction layer for SH1106 graphics library
  * 
- * Implements polymorphic shape interface and all shape-specific drawing
- * code (circles, rectangles) using primitives from sh1106_graphics.c
+ * Implements the shape interface (dispatch on the type tag) and all
+ * shape-specific drawing code (circles, rectangles) using primitives from
+ * sh1106_graphics.c
  *==========================================================================*/
 
 #include "shapes.h"
 #include "sh1106_graphics.h"
-#include <stdlib.h>
+#include "display_list.h"
 #include <stddef.h>
 
 /*============================================================================
@@ -20,23 +21,31 @@
 #endif
 
 /*============================================================================
- * CIRCLE DRAWING PRIMITIVES
+ * CIRCLE RASTERIZATION
  *==========================================================================*/
+// The circle algorithms emit vertical spans relative to the center, so the
+// same pixels can go either straight into buffer or into a cached sprite
 
-static void drawCircle(Point center, int16_t radius, OLED_color color) {
-    int16_t centerX = center.x;
-    int16_t centerY = center.y;
-    
+/**
+ * Receives one vertical span of a circle
+ * @param ctx Sink-specific context
+ * @param dx Column offset from the center
+ * @param top First row offset from the center (inclusive)
+ * @param bottom Last row offset from the center (inclusive)
+ */
+typedef void (*SpanSink)(void* ctx, int16_t dx, int16_t top, int16_t bottom);
+
+static void rasterCircle(int16_t radius, SpanSink sink, void* ctx) {
     int16_t decisionParam = 1 - radius;
     int16_t deltaDecisionX = 1;
     int16_t deltaDecisionY = -2 * radius;
     int16_t x = 0;
     int16_t y = radius;
     
-    drawPixel((Point){centerX, centerY + radius}, color);
-    drawPixel((Point){centerX, centerY - radius}, color);
-    drawPixel((Point){centerX + radius, centerY}, color);
-    drawPixel((Point){centerX - radius, centerY}, color);
+    sink(ctx, 0, radius, radius);
+    sink(ctx, 0, -radius, -radius);
+    sink(ctx, radius, 0, 0);
+    sink(ctx, -radius, 0, 0);
     
     while (x < y) {
         if (decisionParam >= 0) {
@@ -48,26 +57,19 @@ static void drawCircle(Point center, int16_t radius, OLED_color color) {
         deltaDecisionX += 2;
         decisionParam += deltaDecisionX;
         
-        drawPixel((Point){centerX + x, centerY + y}, color);
-        drawPixel((Point){centerX - x, centerY + y}, color);
-        drawPixel((Point){centerX + x, centerY - y}, color);
-        drawPixel((Point){centerX - x, centerY - y}, color);
-        drawPixel((Point){centerX + y, centerY + x}, color);
-        drawPixel((Point){centerX - y, centerY + x}, color);
-        drawPixel((Point){centerX + y, centerY - x}, color);
-        drawPixel((Point){centerX - y, centerY - x}, color);
+        sink(ctx, x, y, y);
+        sink(ctx, -x, y, y);
+        sink(ctx, x, -y, -y);
+        sink(ctx, -x, -y, -y);
+        sink(ctx, y, x, x);
+        sink(ctx, -y, x, x);
+        sink(ctx, y, -x, -x);
+        sink(ctx, -y, -x, -x);
     }
 }
 
-static void drawFilledCircle(Point center, int16_t radius, OLED_color color) {
-    int16_t centerX = center.x;
-    int16_t centerY = center.y;
-    
-    int16_t top = centerY - radius;
-    int16_t bottom = centerY + radius;
-    if (top < 0) top = 0;
-    if (bottom >= HEIGHT) bottom = HEIGHT - 1;
-    drawLine((Point){centerX, top}, (Point){centerX, bottom}, color);
+static void rasterFilledCircle(int16_t radius, SpanSink sink, void* ctx) {
+    sink(ctx, 0, -radius, radius);
     
     int16_t decisionParam = 1 - radius;
     int16_t deltaDecisionX = 1;
@@ -88,33 +90,87 @@ static void drawFilledCircle(Point center, int16_t radius, OLED_color color) {
         deltaDecisionX += 2;
         decisionParam += deltaDecisionX;
         
-        int16_t lineTop = centerY - y;
-        int16_t lineBottom = centerY + y + delta;
-        if (lineTop < 0) lineTop = 0;
-        if (lineBottom >= HEIGHT) lineBottom = HEIGHT - 1;
-        
         if (x < (y + 1)) {
-            if (centerX + x < WIDTH)
-                drawLine((Point){centerX + x, lineTop}, (Point){centerX + x, lineBottom}, color);
-            if (centerX - x >= 0)
-                drawLine((Point){centerX - x, lineTop}, (Point){centerX - x, lineBottom}, color);
+            sink(ctx, x, -y, y + delta);
+            sink(ctx, -x, -y, y + delta);
         }
         if (y != prevY) {
-            int16_t prevLineTop = centerY - prevX;
-            int16_t prevLineBottom = centerY + prevX + delta;
-            if (prevLineTop < 0) prevLineTop = 0;
-            if (prevLineBottom >= HEIGHT) prevLineBottom = HEIGHT - 1;
-            
-            if (centerX + prevY < WIDTH)
-                drawLine((Point){centerX + prevY, prevLineTop}, (Point){centerX + prevY, prevLineBottom}, color);
-            if (centerX - prevY >= 0)
-                drawLine((Point){centerX - prevY, prevLineTop}, (Point){centerX - prevY, prevLineBottom}, color);
+            sink(ctx, prevY, -prevX, prevX + delta);
+            sink(ctx, -prevY, -prevX, prevX + delta);
             prevY = y;
         }
         prevX = x;
     }
 }
 
+/**
+ * Direct drawing target: center and color of the circle being drawn
+ */
+typedef struct {
+    Point center;
+    OLED_color color;
+} BufferTarget;
+
+/**
+ * Span sink that draws into buffer, clipped to the screen
+ */
+static void spanToBuffer(void* ctx, int16_t dx, int16_t top, int16_t bottom) {
+    BufferTarget* target = (BufferTarget*)ctx;
+    int16_t x = target->center.x + dx;
+    if (x < 0 || x >= WIDTH) return;
+
+    top += target->center.y;
+    bottom += target->center.y;
+    if (top < 0) top = 0;
+    drawVLine((Point){x, top}, bottom - top + 1, target->color);
+}
+
+/**
+ * Sprite target: the sprite being built and the circle's radius
+ */
+typedef struct {
+    CircleSprite* sprite;
+    int16_t radius;
+} SpriteTarget;
+
+/**
+ * Span sink that sets bits in a circle's sprite
+ * Sprite column 0 / bit 0 is offset (-radius, -radius) from the center
+ */
+static void spanToSprite(void* ctx, int16_t dx, int16_t top, int16_t bottom) {
+    SpriteTarget* target = (SpriteTarget*)ctx;
+    uint16_t* column = &target->sprite->columns[dx + target->radius];
+    for (int16_t row = top + target->radius; row <= bottom + target->radius; row++) {
+        *column |= (uint16_t)1 << row;
+    }
+}
+
+/**
+ * Rebuild a circle's sprite after its radius or fill state changed
+ * Circles too large for a sprite are rasterized directly on every draw
+ */
+static void rasterize_circle(Shape* shape) {
+    CircleSprite* sprite = shape->data.circle.sprite;
+    if (sprite == NULL) return;
+
+    SpriteTarget target = {sprite, shape->data.circle.radius};
+    if (target.radius > CIRCLE_SPRITE_MAX_RADIUS) {
+        sprite->width = 0;
+        return;
+    }
+
+    sprite->width = 2 * target.radius + 1;
+    for (uint8_t i = 0; i < sprite->width; i++) {
+        sprite->columns[i] = 0;
+    }
+
+    if (shape->is_filled) {
+        rasterFilledCircle(target.radius, spanToSprite, &target);
+    } else {
+        rasterCircle(target.radius, spanToSprite, &target);
+    }
+}
+
 /*============================================================================
  * RECTANGLE DRAWING PRIMITIVES
  *==========================================================================*/
@@ -164,10 +220,12 @@ static void drawRect(Point origin, int16_t width, int16_t height,
     calculate_rect_corners(origin, width, height, anchor, &tl, &br);
     
     // Draw outline - br is exclusive, so subtract 1 for actual edge
-    drawLine(tl, (Point){br.x - 1, tl.y}, color);           // Top edge
-    drawLine((Point){br.x - 1, tl.y}, (Point){br.x - 1, br.y - 1}, color);  // Right edge
-    drawLine((Point){br.x - 1, br.y - 1}, (Point){tl.x, br.y - 1}, color);  // Bottom edge
-    drawLine((Point){tl.x, br.y - 1}, tl, color);           // Left edge
+    int16_t width_px = br.x - tl.x;
+    int16_t height_px = br.y - tl.y;
+    drawHLine(tl, width_px, color);                                  // Top edge
+    drawVLine((Point){br.x - 1, tl.y}, height_px, color);            // Right edge
+    drawHLine((Point){tl.x, br.y - 1}, width_px, color);             // Bottom edge
+    drawVLine(tl, height_px, color);                                 // Left edge
 }
 
 static void writeFilledRect(Point origin, int16_t width, int16_t height,
@@ -181,10 +239,8 @@ static void writeFilledRect(Point origin, int16_t width, int16_t height,
     if (x2 < x1) _swap_int16_t(x1, x2);
     if (y2 < y1) _swap_int16_t(y1, y2);
     
-    // Fill rectangle - br is exclusive, so use < instead of <=
-    for (; x1 < x2; x1++) {
-        drawLine((Point){x1, y1}, (Point){x1, y2 - 1}, color);
-    }
+    // Fill rectangle - br is exclusive
+    fillRect((Point){x1, y1}, x2 - x1, y2 - y1, color);
 }
 
 /*============================================================================
@@ -192,21 +248,26 @@ static void writeFilledRect(Point origin, int16_t width, int16_t height,
  *==========================================================================*/
 
 static void draw_circle(Shape* self) {
-    if (self == NULL || self->shape_data == NULL) return;
-    
-    CircleData* data = (CircleData*)self->shape_data;
+    CircleData* data = &self->data.circle;
     
+    if (data->sprite != NULL && data->sprite->width > 0) {
+        // Cached raster: shift-and-mask blit
+        drawSprite((int16_t)self->origin.x - data->radius,
+                   (int16_t)self->origin.y - data->radius,
+                   data->sprite->columns, data->sprite->width, self->color);
+        return;
+    }
+
+    BufferTarget target = {self->origin, self->color};
     if (self->is_filled) {
-        drawFilledCircle(self->origin, data->radius, self->color);
+        rasterFilledCircle(data->radius, spanToBuffer, &target);
     } else {
-        drawCircle(self->origin, data->radius, self->color);
+        rasterCircle(data->radius, spanToBuffer, &target);
     }
 }
 
 static void draw_rectangle(Shape* self) {
-    if (self == NULL || self->shape_data == NULL) return;
-    
-    RectangleData* data = (RectangleData*)self->shape_data;
+    RectangleData* data = &self->data.rect;
     
     if (self->is_filled) {
         writeFilledRect(self->origin, data->width, data->height, data->anchor, self->color);
@@ -215,55 +276,49 @@ static void draw_rectangle(Shape* self) {
     }
 }
 
+/*============================================================================
+ * SHAPE POOLS
+ *==========================================================================*/
+
+static CircleSprite circle_sprites[SHAPE_POOL_CIRCLES];
+
 /*============================================================================
  * SHAPE CONSTRUCTORS
  *==========================================================================*/
 
-Shape* create_circle(Point origin, int16_t radius, uint8_t is_filled, OLED_color color) {
-    Shape* shape = (Shape*)malloc(sizeof(Shape));
-    if (shape == NULL) return NULL;
-    
-    CircleData* data = (CircleData*)malloc(sizeof(CircleData));
-    if (data == NULL) {
-        free(shape);
-        return NULL;
-    }
-    
-    data->radius = radius;
-    
+void init_circle(Shape* shape, CircleSprite* sprite, Point origin, int16_t radius,
+                 uint8_t is_filled, OLED_color color) {
     shape->origin = origin;
-    shape->draw_impl = draw_circle;
-    shape->shape_data = data;
     shape->type = SHAPE_CIRCLE;
     shape->is_filled = is_filled;
     shape->color = color;
+    shape->data.circle.radius = (uint8_t)radius;
+    shape->data.circle.sprite = sprite;
     
-    return shape;
+    rasterize_circle(shape);
 }
 
-Shape* create_rectangle(Point origin, int16_t width, int16_t height,
-                       RectangleAnchor anchor, uint8_t is_filled, OLED_color color) {
-    Shape* shape = (Shape*)malloc(sizeof(Shape));
-    if (shape == NULL) return NULL;
-    
-    RectangleData* data = (RectangleData*)malloc(sizeof(RectangleData));
-    if (data == NULL) {
-        free(shape);
-        return NULL;
-    }
-    
-    data->anchor = anchor;
-    data->width = width;
-    data->height = height;
-    
+void init_rectangle(Shape* shape, Point origin,
+                    int16_t width, int16_t height, RectangleAnchor anchor,
+                    uint8_t is_filled, OLED_color color) {
     shape->origin = origin;
-    shape->draw_impl = draw_rectangle;
-    shape->shape_data = data;
     shape->type = SHAPE_RECTANGLE;
     shape->is_filled = is_filled;
     shape->color = color;
-    
-    return shape;
+    shape->data.rect.width = (uint8_t)width;
+    shape->data.rect.height = (uint8_t)height;
+    shape->data.rect.anchor = anchor;
+}
+
+uint8_t create_circle(Shape* shape, Point origin, int16_t radius, uint8_t is_filled, OLED_color color) {
+    CircleSprite* sprite = NULL;
+    for (uint8_t slot = 0; slot < SHAPE_POOL_CIRCLES && sprite == NULL; slot++) {
+        if (circle_sprites[slot].owner == NULL) sprite = &circle_sprites[slot];
+    }
+    if (sprite != NULL) sprite->owner = shape;
+
+    init_circle(shape, sprite, origin, radius, is_filled, color);
+    return sprite != NULL;
 }
 
 /*============================================================================
@@ -271,20 +326,27 @@ Shape* create_rectangle(Point origin, int16_t width, int16_t height,
  *==========================================================================*/
 
 void draw(Shape* shape) {
-    if (shape != NULL && shape->draw_impl != NULL) {
-        shape->draw_impl(shape);
+    if (shape == NULL) return;
+    if (DISPLAY_LIST_SHAPE(shape)) return;
+
+    if (shape->type == SHAPE_CIRCLE) {
+        draw_circle(shape);
+    } else if (shape->type == SHAPE_RECTANGLE) {
+        draw_rectangle(shape);
     }
 }
 
 void set_shape_filled(Shape* shape, uint8_t is_filled) {
     if (shape != NULL) {
         shape->is_filled = is_filled;
+        if (shape->type == SHAPE_CIRCLE) rasterize_circle(shape);
     }
 }
 
 void toggle_shape_filled(Shape* shape) {
     if (shape != NULL) {
         shape->is_filled = !shape->is_filled;
+        if (shape->type == SHAPE_CIRCLE) rasterize_circle(shape);
     }
 }
 
@@ -299,20 +361,22 @@ void set_shape_color(Shape* shape, OLED_color color) {
 }
 
 OLED_color get_shape_color(Shape* shape) {
-    return (shape != NULL) ? shape->color : COLOR_BLACK;
+    return (shape != NULL) ? (OLED_color)shape->color : COLOR_BLACK;
 }
 
 ShapeType get_shape_type(Shape* shape) {
-    return (shape != NULL) ? shape->type : SHAPE_CIRCLE;
+    return (shape != NULL) ? (ShapeType)shape->type : SHAPE_NONE;
 }
 
 void destroy_shape(Shape* shape) {
-    if (shape != NULL) {
-        if (shape->shape_data != NULL) {
-            free(shape->shape_data);
-        }
-        free(shape);
+    if (shape == NULL) return;
+
+    // Only the shape that took a pool sprite releases it (copies share it)
+    if (shape->type == SHAPE_CIRCLE && shape->data.circle.sprite != NULL &&
+        shape->data.circle.sprite->owner == shape) {
+        shape->data.circle.sprite->owner = NULL;
     }
+    shape->type = SHAPE_NONE;
 }
 
 /*============================================================================
@@ -332,32 +396,55 @@ Point get_shape_position(Shape* shape) {
     return (Point){0, 0};
 }
 
+/**
+ * Clamp a coordinate to [0, limit]
+ */
+static uint8_t clamp_coordinate(int16_t value, int16_t limit) {
+    return (value < 0) ? 0 : ((value > limit) ? limit : value);
+}
+
+ShapeBounds get_shape_bounds(Shape* shape) {
+    ShapeBounds bounds = {{0, 0}, {0, 0}};
+    if (shape == NULL) return bounds;
+
+    if (shape->type == SHAPE_CIRCLE) {
+        // Filled raster reaches one row below center + radius
+        int16_t radius = shape->data.circle.radius;
+        bounds.tl.x = clamp_coordinate(shape->origin.x - radius, WIDTH);
+        bounds.tl.y = clamp_coordinate(shape->origin.y - radius, HEIGHT);
+        bounds.br.x = clamp_coordinate(shape->origin.x + radius + 1, WIDTH);
+        bounds.br.y = clamp_coordinate(shape->origin.y + radius + 2, HEIGHT);
+    } else if (shape->type == SHAPE_RECTANGLE) {
+        RectangleData* data = &shape->data.rect;
+        calculate_rect_corners(shape->origin, data->width, data->height,
+                               data->anchor, &bounds.tl, &bounds.br);
+    }
+    return bounds;
+}
+
 void set_circle_radius(Shape* shape, int16_t new_radius) {
-    if (shape != NULL && shape->type == SHAPE_CIRCLE && shape->shape_data != NULL) {
-        CircleData* data = (CircleData*)shape->shape_data;
-        data->radius = new_radius;
+    if (shape != NULL && shape->type == SHAPE_CIRCLE) {
+        shape->data.circle.radius = (uint8_t)new_radius;
+        rasterize_circle(shape);
     }
 }
 
 int16_t get_circle_radius(Shape* shape) {
-    if (shape != NULL && shape->type == SHAPE_CIRCLE && shape->shape_data != NULL) {
-        CircleData* data = (CircleData*)shape->shape_data;
-        return data->radius;
+    if (shape != NULL && shape->type == SHAPE_CIRCLE) {
+        return shape->data.circle.radius;
     }
     return 0;
 }
 
 void set_rectangle_dimensions(Shape* shape, int16_t new_width, int16_t new_height) {
-    if (shape != NULL && shape->type == SHAPE_RECTANGLE && shape->shape_data != NULL) {
-        RectangleData* data = (RectangleData*)shape->shape_data;
-        data->width = new_width;
-        data->height = new_height;
+    if (shape != NULL && shape->type == SHAPE_RECTANGLE) {
+        shape->data.rect.width = (uint8_t)new_width;
+        shape->data.rect.height = (uint8_t)new_height;
     }
 }
 
 void set_rectangle_anchor(Shape* shape, RectangleAnchor new_anchor) {
-    if (shape != NULL && shape->type == SHAPE_RECTANGLE && shape->shape_data != NULL) {
-        RectangleData* data = (RectangleData*)shape->shape_data;
-        data->anchor = new_anchor;
+    if (shape != NULL && shape->type == SHAPE_RECTANGLE) {
+        shape->data.rect.anchor = new_anchor;
     }
-}
\ No newline at end of file
+}
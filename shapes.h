@@ -3,18 +3,36 @@
  *============================================================================
  * Object-oriented shape abstraction layer for SH1106 graphics library
  * 
- * Provides polymorphic shape interface using function pointers for clean
- * separation between shape logic and low-level display operations.
+ * Provides a uniform shape interface, dispatched on the shape's type tag,
+ * for clean separation between shape logic and low-level display operations.
  *
  * All shape drawing code (circles, rectangles) is implemented here,
  * built on top of the primitives in sh1106_graphics.h (pixels, lines).
  *
+ * A Shape is a packed value (8 bytes on the ATtiny1627): one position, a
+ * type tag and the circle or rectangle parameters inline in a union, with
+ * 8-bit dimensions. It can be copied freely and embedded in other objects.
+ *
+ * Circles up to CIRCLE_SPRITE_MAX_RADIUS are rasterized once into a column
+ * sprite (on creation and whenever radius or fill state change), so drawing
+ * them is a single blit. The sprite is the only part kept outside the shape:
+ * circles of the same radius and fill can share one. Rectangles are drawn
+ * with page-masked span fills.
+ *
+ * Shapes never use the heap: create_circle() takes its sprite from a
+ * fixed-capacity pool (SHAPE_POOL_CIRCLES), init_circle() uses caller
+ * storage (or none: the circle is then rasterized on every draw).
+ *
  * USAGE:
- *     Shape* circle = create_circle((Point){64, 32}, 15, 1, COLOR_WHITE);
- *     draw(circle);
- *     set_shape_filled(circle, 0);
- *     draw(circle);
- *     shape_destroy(circle);
+ *     Shape circle;
+ *     create_circle(&circle, (Point){64, 32}, 5, 1, COLOR_WHITE);
+ *     draw(&circle);
+ *     set_shape_filled(&circle, 0);
+ *     draw(&circle);
+ *     destroy_shape(&circle);                 // Sprite back to the pool
+ *
+ *     static Shape box;
+ *     init_rectangle(&box, (Point){0, 0}, 10, 10, ANCHOR_TOP_LEFT, 1, COLOR_WHITE);
  *==========================================================================*/
 
 #ifndef SHAPES_H
@@ -28,7 +46,8 @@
  *==========================================================================*/
 typedef enum {
     SHAPE_CIRCLE,
-    SHAPE_RECTANGLE
+    SHAPE_RECTANGLE,
+    SHAPE_NONE                                      // Destroyed: not drawn, never collides
 } ShapeType;
 
 /*============================================================================
@@ -44,63 +63,114 @@ typedef enum {
  * SHAPE DATA STRUCTURES
  *==========================================================================*/
 
+#define CIRCLE_SPRITE_MAX_RADIUS 7                      // Filled raster is 2r+2 rows: must fit 16 bits
+#define CIRCLE_SPRITE_MAX_WIDTH  (2 * CIRCLE_SPRITE_MAX_RADIUS + 1)
+
+/**
+ * Cached raster of a circle
+ */
+typedef struct {
+    uint8_t width;                                  // Columns (0 = too large, drawn directly)
+    uint16_t columns[CIRCLE_SPRITE_MAX_WIDTH];      // Column masks, bit 0 = row (center.y - radius)
+    const struct Shape* owner;                      // Shape that took it from the pool (NULL = free)
+} CircleSprite;
+
 /**
  * Circle-specific data
- * Origin (center) is stored in parent Shape
+ * Origin (center) is stored in the Shape
  */
 typedef struct {
-    int16_t radius;
+    uint8_t radius;
+    CircleSprite* sprite;                           // Raster cache (NULL = rasterized on every draw)
 } CircleData;
 
 /**
  * Rectangle-specific data
- * Origin location depends on anchor setting, stored in parent Shape
+ * Origin location depends on anchor setting, stored in the Shape
  */
 typedef struct {
-    RectangleAnchor anchor;
-    int16_t width;
-    int16_t height;
+    uint8_t width;
+    uint8_t height;
+    uint8_t anchor;                                 // RectangleAnchor
 } RectangleData;
 
 /**
- * Base Shape structure (polymorphic interface)
- * All shapes contain this structure for uniform handling
+ * Screen-space bounding box of a drawn shape
+ * br is exclusive; both corners are clamped to the screen
+ */
+typedef struct {
+    Point tl;                                       // Top-left corner (inclusive)
+    Point br;                                       // Bottom-right corner (exclusive)
+} ShapeBounds;
+
+/**
+ * Shape (tagged union)
+ * The type tag selects the member of data and the draw routine
  */
 typedef struct Shape {
     Point origin;                                   // Position of shape (meaning depends on type/anchor)
-    void (*draw_impl)(struct Shape* self);          // Polymorphic draw implementation
-    void* shape_data;                               // Pointer to specific shape data
-    ShapeType type;                                 // Shape type identifier
+    uint8_t type;                                   // ShapeType
     uint8_t is_filled;                              // Fill state
-    OLED_color color;                               // Color to draw shape
+    uint8_t color;                                  // OLED_color to draw shape
+    union {
+        CircleData circle;
+        RectangleData rect;
+    } data;
 } Shape;
 
+/*============================================================================
+ * SHAPE POOLS
+ *==========================================================================*/
+
+#define SHAPE_POOL_CIRCLES    1                         // Ball (panic balls share its sprite)
+
+/**
+ * Static RAM taken by the shape pools
+ */
+#define SHAPE_POOL_BYTES (SHAPE_POOL_CIRCLES * sizeof(CircleSprite))
+
 /*============================================================================
  * SHAPE CONSTRUCTORS
  *==========================================================================*/
 
 /**
- * Create a new circle shape
+ * Initialize a circle
+ * @param shape Shape storage
+ * @param sprite Raster cache (must outlive the shape; may be shared by
+ *               circles of the same radius and fill), or NULL
  * @param origin Center coordinates
  * @param radius Circle radius in pixels
  * @param is_filled 1 for filled circle, 0 for outline
  * @param color Color to draw the circle
- * @return Pointer to new Shape, or NULL if allocation fails
  */
-Shape* create_circle(Point origin, int16_t radius, uint8_t is_filled, OLED_color color);
+void init_circle(Shape* shape, CircleSprite* sprite, Point origin, int16_t radius,
+                 uint8_t is_filled, OLED_color color);
 
 /**
- * Create a new rectangle shape
+ * Initialize a rectangle
+ * @param shape Shape storage
  * @param origin Origin point (meaning depends on anchor)
- * @param width Rectangle width in pixels
- * @param height Rectangle height in pixels
+ * @param width Rectangle width in pixels (0-255)
+ * @param height Rectangle height in pixels (0-255)
  * @param anchor Where origin is located (TOP_LEFT, BOTTOM_LEFT, CENTER)
  * @param is_filled 1 for filled rectangle, 0 for outline
  * @param color Color to draw the rectangle
- * @return Pointer to new Shape, or NULL if allocation fails
  */
-Shape* create_rectangle(Point origin, int16_t width, int16_t height, 
-                       RectangleAnchor anchor, uint8_t is_filled, OLED_color color);
+void init_rectangle(Shape* shape, Point origin,
+                    int16_t width, int16_t height, RectangleAnchor anchor,
+                    uint8_t is_filled, OLED_color color);
+
+/**
+ * Initialize a circle with a sprite from the pool
+ * Without a free sprite the circle is still usable (rasterized on every draw)
+ * @param shape Shape storage (takes the sprite, see destroy_shape())
+ * @param origin Center coordinates
+ * @param radius Circle radius in pixels
+ * @param is_filled 1 for filled circle, 0 for outline
+ * @param color Color to draw the circle
+ * @return 1 if a pool sprite was taken, 0 if the pool is exhausted
+ */
+uint8_t create_circle(Shape* shape, Point origin, int16_t radius, uint8_t is_filled, OLED_color color);
 
 /*============================================================================
  * SHAPE OPERATIONS (Polymorphic Interface)
@@ -108,7 +178,7 @@ Shape* create_rectangle(Point origin, int16_t width, int16_t height,
 
 /**
  * Draw a shape to the display buffer
- * Calls the appropriate draw function based on shape type
+ * Dispatches on the shape's type tag
  * Uses the shape's stored color
  * @param shape Pointer to shape to draw
  */
@@ -156,8 +226,9 @@ OLED_color get_shape_color(Shape* shape);
 ShapeType get_shape_type(Shape* shape);
 
 /**
- * Destroy a shape and free its memory
- * Always call this when done with a shape to prevent memory leaks
+ * Destroy a shape: it is no longer drawn or collided (type SHAPE_NONE)
+ * A circle from create_circle() returns its sprite to the pool; copies of
+ * it must not be drawn afterwards
  * @param shape Pointer to shape to destroy
  */
 void destroy_shape(Shape* shape);
@@ -182,10 +253,17 @@ void set_shape_position(Shape* shape, Point new_origin);
  */
 Point get_shape_position(Shape* shape);
 
+/**
+ * Get the screen area a shape covers when drawn (works for all shape types)
+ * @param shape Pointer to shape
+ * @return Bounds of every pixel draw() can touch (empty for NULL)
+ */
+ShapeBounds get_shape_bounds(Shape* shape);
+
 /**
  * Change a circle's radius
  * @param shape Pointer to circle shape
- * @param new_radius New radius in pixels
+ * @param new_radius New radius in pixels (0-255)
  */
 void set_circle_radius(Shape* shape, int16_t new_radius);
 
@@ -199,8 +277,8 @@ int16_t get_circle_radius(Shape* shape);
 /**
  * Change a rectangle's dimensions
  * @param shape Pointer to rectangle shape
- * @param new_width New width in pixels
- * @param new_height New height in pixels
+ * @param new_width New width in pixels (0-255)
+ * @param new_height New height in pixels (0-255)
  */
 void set_rectangle_dimensions(Shape* shape, int16_t new_width, int16_t new_height);
 
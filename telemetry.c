@@ -0,0 +1,176 @@
+/*============================================================================
+ * telemetry.c
+ *============================================================================
+ * Binary telemetry stream implementation
+ * Compiles to nothing unless TELEMETRY_ENABLED is defined
+ *==========================================================================*/
+
+#include "telemetry.h"
+
+#ifdef TELEMETRY_ENABLED
+
+#include <stddef.h>
+
+/*============================================================================
+ * INTERNAL STATE
+ *==========================================================================*/
+
+#define TELEMETRY_MASK (TELEMETRY_BUFFER_SIZE - 1)
+
+// Ring: the game loop writes at head, the interrupt sends from tail
+static uint8_t ring[TELEMETRY_BUFFER_SIZE];
+static volatile uint8_t head = 0;                                            // Written by the game loop only
+static volatile uint8_t tail = 0;                                            // Written by the interrupt only
+static uint8_t sequence = 0;
+static uint16_t tick = 0;
+static uint16_t dropped = 0;
+
+// Record being written (committed by end_record())
+static uint8_t write_index;
+static uint8_t check;
+
+/*============================================================================
+ * HELPER FUNCTIONS
+ *==========================================================================*/
+
+/**
+ * Data register empty interrupt: send the next byte, or stop when the
+ * ring is empty
+ */
+static void transmit_next(void) {
+    uint8_t index = tail;
+    if (index == head) {
+        hal_serial_set_interrupt(0);
+        return;
+    }
+    hal_serial_write(ring[index]);
+    tail = (index + 1) & TELEMETRY_MASK;
+}
+
+static void put8(uint8_t value) {
+    ring[write_index] = value;
+    write_index = (write_index + 1) & TELEMETRY_MASK;
+    check += value;
+}
+
+static void put16(uint16_t value) {
+    put8((uint8_t)value);
+    put8((uint8_t)(value >> 8));
+}
+
+/**
+ * Start a record if it fits in the free part of the ring
+ * @return 1 to write the payload, 0 if the record was dropped
+ */
+static uint8_t begin_record(uint8_t type, uint8_t length) {
+    uint8_t seq = sequence++;                                                // Used even when dropped
+    uint8_t free = (uint8_t)((tail - head - 1) & TELEMETRY_MASK);
+    if ((uint16_t)length + TELEMETRY_OVERHEAD > free) {
+        if (dropped < 0xFFFF) dropped++;
+        return 0;
+    }
+
+    write_index = head;
+    put8(TELEMETRY_SYNC);
+    check = 0;                                                               // Sync is not summed
+    put8(seq);
+    put8(type);
+    put8(length);
+    return 1;
+}
+
+/**
+ * Close the record and hand it to the interrupt
+ */
+static void end_record(void) {
+    put8((uint8_t)-check);
+    head = write_index;                                                      // Publish the whole record at once
+    hal_serial_set_interrupt(1);
+}
+
+/**
+ * Position and velocity of a ball (Q8.8)
+ */
+static void put_motion(const PhysicsObject* obj) {
+    put16(obj->position.x);
+    put16(obj->position.y);
+    put16((uint16_t)obj->velocity.x);
+    put16((uint16_t)obj->velocity.y);
+}
+
+/*============================================================================
+ * TELEMETRY INITIALIZATION
+ *==========================================================================*/
+
+void init_telemetry(void) {
+    head = 0;
+    tail = 0;
+    sequence = 0;
+    tick = 0;
+    dropped = 0;
+
+    hal_serial_init(TELEMETRY_BAUD);
+    hal_serial_set_handler(transmit_next);
+}
+
+/*============================================================================
+ * TELEMETRY OPERATIONS
+ *==========================================================================*/
+
+void telemetry_state(uint8_t state, uint16_t score, const PhysicsObject* paddles,
+                     int8_t velocity_x, int8_t velocity_y,
+                     const PhysicsObject* balls, uint8_t ball_count) {
+    if (begin_record(TELEMETRY_RECORD_STATE, TELEMETRY_STATE_BYTES(ball_count))) {
+        put16(tick);
+        put8(state);
+        put16(score);
+        put8((uint8_t)velocity_x);
+        put8((uint8_t)velocity_y);
+        for (uint8_t i = 0; i < 4; i++) {
+            put8((uint8_t)(paddles[i].position.x >> FIXED_SHIFT));
+            put8((uint8_t)(paddles[i].position.y >> FIXED_SHIFT));
+        }
+        put8(ball_count);
+        for (uint8_t i = 0; i < ball_count; i++) {
+            put_motion(&balls[i]);
+        }
+        end_record();
+    }
+    tick++;
+}
+
+void telemetry_collision(uint8_t ball, uint8_t target, uint8_t index,
+                         const Contact* contact, const PhysicsObject* obj) {
+    if (!begin_record(TELEMETRY_RECORD_COLLISION, TELEMETRY_COLLISION_BYTES)) return;
+
+    put16(tick);
+    put8(ball);
+    put8((uint8_t)((target << 4) | (index & 0x0F)));
+    put8((uint8_t)contact->normal.x);
+    put8((uint8_t)contact->normal.y);
+    put16(contact->time);
+    put_motion(obj);
+    end_record();
+}
+
+void telemetry_profile(const ProfileStats* stats, uint16_t misses) {
+    if (!begin_record(TELEMETRY_RECORD_PROFILE, TELEMETRY_PROFILE_BYTES)) return;
+
+    for (uint8_t i = 0; i < PROFILE_PHASE_COUNT; i++) {
+        put16(stats[i].min_us);
+        put16(stats[i].avg_us);
+        put16(stats[i].max_us);
+    }
+    put16(misses);
+    end_record();
+}
+
+uint8_t telemetry_busy(void) {
+    return head != tail;
+}
+
+uint16_t telemetry_dropped(void) {
+    return dropped;
+}
+
+#endif // TELEMETRY_ENABLED
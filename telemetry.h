@@ -0,0 +1,190 @@
+/*============================================================================
+ * telemetry.h
+ *============================================================================
+ * Binary telemetry stream on USART0 TX (PB2)
+ *
+ * Streams the game state of every tick, every listed ball contact
+ * (physics.h: up to PHYSICS_WORLD_MAX_CONTACTS per step) and every
+ * profiler window off the device while it is played. Records are packed
+ * into a TX ring buffer and sent by the data register empty interrupt, so
+ * the game loop never waits for the serial line. A record that does not
+ * fit in the free part of the ring is dropped whole (and counted); its
+ * sequence number is used anyway, so the receiver sees every gap.
+ *
+ * Record (little-endian, positions and velocities Q8.8 as in physics.h):
+ *     sync     TELEMETRY_SYNC
+ *     seq      Sequence number (+1 per record, dropped ones included)
+ *     type     TelemetryRecordType
+ *     length   Payload bytes
+ *     payload  See below
+ *     check    Makes seq + type + length + payload + check == 0 (mod 256)
+ *
+ * Payloads:
+ *     STATE      tick u16, state u8, score u16, paddle velocity x/y i8,
+ *                paddles 4 x (x u8, y u8) in pixels, ball count u8,
+ *                per ball: x u16, y u16, vx i16, vy i16
+ *     COLLISION  tick u16, ball u8, target u8 (TelemetryTarget << 4 |
+ *                index), normal x/y i8, time u16 (0 to FIXED_ONE),
+ *                ball x u16, y u16, vx i16, vy i16 (after the bounce)
+ *     PROFILE    per ProfilePhase: min u16, avg u16, max u16 (µs),
+ *                then deadline misses u16
+ *
+ * The tick is the number of STATE records before this one, so the
+ * collisions of a tick carry the tick of its STATE record.
+ * host/telemetry_decode.c prints a captured stream as text.
+ *
+ * Build flags:
+ *     TELEMETRY_ENABLED - compile the stream in (otherwise every
+ *                         TELEMETRY_* macro expands to nothing and
+ *                         telemetry.c is empty). Uses USART0, so it cannot
+ *                         be combined with PROFILER_SERIAL, LATENCY_TEST or
+ *                         BENCH_MODE
+ *     TELEMETRY_BUFFER_SIZE - ring size in bytes (power of two, 32-256)
+ *
+ * USAGE:
+ *     init_telemetry();
+ *
+ *     TELEMETRY_STATE(ctrl);                          // End of every tick
+ *     TELEMETRY_COLLISION(ball, target, index, &contact, ball_obj);
+ *     TELEMETRY_PROFILE(published, misses);           // Profiler window
+ *==========================================================================*/
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include "hal.h"
+#include "physics.h"
+#include "profiler.h"
+
+/*============================================================================
+ * TELEMETRY CONFIGURATION
+ *==========================================================================*/
+
+#define TELEMETRY_BAUD        115200UL                              // 180 bytes per tick
+#define TELEMETRY_SYNC        0xA5                                  // First byte of every record
+#define TELEMETRY_HEADER      4                                     // sync, seq, type, length
+#define TELEMETRY_OVERHEAD    (TELEMETRY_HEADER + 1)                // Header and check byte
+
+#ifndef TELEMETRY_BUFFER_SIZE
+#define TELEMETRY_BUFFER_SIZE 128                                   // Panic mode STATE record: 85
+#endif
+
+#if (TELEMETRY_BUFFER_SIZE & (TELEMETRY_BUFFER_SIZE - 1)) != 0 || \
+    TELEMETRY_BUFFER_SIZE < 32 || TELEMETRY_BUFFER_SIZE > 256
+#error "TELEMETRY_BUFFER_SIZE must be a power of two from 32 to 256"
+#endif
+
+/*============================================================================
+ * TELEMETRY TYPES
+ *==========================================================================*/
+
+/**
+ * Kinds of record
+ */
+typedef enum {
+    TELEMETRY_RECORD_STATE = 1,      // Game state, once per tick
+    TELEMETRY_RECORD_COLLISION,      // Ball contact
+    TELEMETRY_RECORD_PROFILE         // Profiler window (PROFILER_ENABLED)
+} TelemetryRecordType;
+
+/**
+ * What a ball touched (high nibble of a COLLISION's target byte)
+ */
+typedef enum {
+    TELEMETRY_TARGET_WALL,
+    TELEMETRY_TARGET_PADDLE,
+    TELEMETRY_TARGET_OBSTACLE,
+    TELEMETRY_TARGET_BALL
+} TelemetryTarget;
+
+// Payload sizes
+#define TELEMETRY_STATE_BYTES(balls) (16 + 8 * (balls))
+#define TELEMETRY_COLLISION_BYTES    16
+#define TELEMETRY_PROFILE_BYTES      (PROFILE_PHASE_COUNT * 6 + 2)
+
+#ifdef TELEMETRY_ENABLED
+// Static RAM: ring, head, tail, sequence number, tick, dropped count
+#define TELEMETRY_RAM_BYTES (TELEMETRY_BUFFER_SIZE + 3 + 2 + 2)
+#else
+#define TELEMETRY_RAM_BYTES 0
+#endif
+
+/*============================================================================
+ * TELEMETRY OPERATIONS
+ *==========================================================================*/
+
+#ifdef TELEMETRY_ENABLED
+
+#if defined(PROFILER_SERIAL) || defined(LATENCY_TEST) || defined(BENCH_MODE)
+#error "TELEMETRY_ENABLED needs USART0 to itself"
+#endif
+
+/**
+ * Set up USART0 at TELEMETRY_BAUD and empty the ring
+ */
+void init_telemetry(void);
+
+/**
+ * Queue a STATE record and start the next tick
+ * @param state GameState
+ * @param score Current score
+ * @param paddles The four paddles (top, bottom, left, right)
+ * @param velocity_x Horizontal paddle velocity (pixels per physics step)
+ * @param velocity_y Vertical paddle velocity (pixels per physics step)
+ * @param balls Balls in play
+ * @param ball_count Number of balls
+ */
+void telemetry_state(uint8_t state, uint16_t score, const PhysicsObject* paddles,
+                     int8_t velocity_x, int8_t velocity_y,
+                     const PhysicsObject* balls, uint8_t ball_count);
+
+/**
+ * Queue a COLLISION record
+ * @param ball Index of the ball
+ * @param target What it touched (TelemetryTarget)
+ * @param index Index of the touched wall, paddle, obstacle or ball
+ * @param contact Time of impact and normal (toward the ball)
+ * @param obj The ball, after the bounce
+ */
+void telemetry_collision(uint8_t ball, uint8_t target, uint8_t index,
+                         const Contact* contact, const PhysicsObject* obj);
+
+/**
+ * Queue a PROFILE record
+ * @param stats Published stats, one per ProfilePhase
+ * @param misses Deadline misses in the window
+ */
+void telemetry_profile(const ProfileStats* stats, uint16_t misses);
+
+/**
+ * Check whether bytes are still waiting to be sent
+ * @return 1 if the ring is not empty (USART0 needs its clock)
+ */
+uint8_t telemetry_busy(void);
+
+/**
+ * Get the number of records dropped since init (ring full)
+ * @return Dropped records (saturates at 65535)
+ */
+uint16_t telemetry_dropped(void);
+
+#define TELEMETRY_STATE(ctrl)   telemetry_state((uint8_t)(ctrl)->state, (ctrl)->score, (ctrl)->paddles, \
+                                                (ctrl)->paddle_current_velocity_x,                  \
+                                                (ctrl)->paddle_current_velocity_y,                  \
+                                                (ctrl)->balls, GAME_BALL_COUNT)
+#define TELEMETRY_COLLISION(ball, target, index, contact, obj) \
+                                telemetry_collision((ball), (target), (index), (contact), (obj))
+#define TELEMETRY_PROFILE(stats, misses) telemetry_profile((stats), (misses))
+#define TELEMETRY_BUSY()        telemetry_busy()
+
+#else
+
+#define TELEMETRY_STATE(ctrl)   ((void)0)
+#define TELEMETRY_COLLISION(ball, target, index, contact, obj) ((void)0)
+#define TELEMETRY_PROFILE(stats, misses) ((void)0)
+#define TELEMETRY_BUSY()        0
+
+#endif // TELEMETRY_ENABLED
+
+#endif // TELEMETRY_H
@@ -5,134 +5,238 @@
  *==========================================================================*/
 
 #include "text.h"
+#include "display_list.h"
 #include <stddef.h>
 
 /*============================================================================
- * DIGIT BITMAPS (3x5 pixels)
+ * GLYPH BITMAPS (3x5 pixels, column-major page format)
  *==========================================================================*/
 
 /**
- * Digit bitmaps stored as 5 rows of 3 bits each
- * Each row is stored in lowest 3 bits of a uint8_t
- * Bit pattern: 0bXXX where 1=pixel on, 0=pixel off
+ * Glyphs stored as 3 columns of 5 bits each, in the display's page format:
+ * bit 0 is the top row, so a column is written into buffer with one masked
+ * byte per page instead of pixel by pixel
  *
  * Example for '0':
- *   ###  -> 0b111 = 7
- *   # #  -> 0b101 = 5
- *   # #  -> 0b101 = 5
- *   # #  -> 0b101 = 5
- *   ###  -> 0b111 = 7
+ *   ###      column 0 = 0b11111 = 0x1F
+ *   # #      column 1 = 0b10001 = 0x11
+ *   # #      column 2 = 0b11111 = 0x1F
+ *   # #
+ *   ###
+ *
+ * Each glyph list is expanded into a table per pre-scaled size below
  */
-static const uint8_t DIGIT_BITMAPS[10][5] = {
-    {0b111, 0b101, 0b101, 0b101, 0b111},  // 0
-    {0b010, 0b110, 0b010, 0b010, 0b111},  // 1
-    {0b111, 0b001, 0b111, 0b100, 0b111},  // 2
-    {0b111, 0b001, 0b111, 0b001, 0b111},  // 3
-    {0b101, 0b101, 0b111, 0b001, 0b001},  // 4
-    {0b111, 0b100, 0b111, 0b001, 0b111},  // 5
-    {0b111, 0b100, 0b111, 0b101, 0b111},  // 6
-    {0b111, 0b001, 0b001, 0b001, 0b001},  // 7
-    {0b111, 0b101, 0b111, 0b101, 0b111},  // 8
-    {0b111, 0b101, 0b111, 0b001, 0b111},  // 9
-};
+#define DIGIT_GLYPHS(GLYPH) \
+    GLYPH(0x1F, 0x11, 0x1F)  /* 0 */ \
+    GLYPH(0x12, 0x1F, 0x10)  /* 1 */ \
+    GLYPH(0x1D, 0x15, 0x17)  /* 2 */ \
+    GLYPH(0x15, 0x15, 0x1F)  /* 3 */ \
+    GLYPH(0x07, 0x04, 0x1F)  /* 4 */ \
+    GLYPH(0x17, 0x15, 0x1D)  /* 5 */ \
+    GLYPH(0x1F, 0x15, 0x1D)  /* 6 */ \
+    GLYPH(0x01, 0x01, 0x1F)  /* 7 */ \
+    GLYPH(0x1F, 0x15, 0x1F)  /* 8 */ \
+    GLYPH(0x17, 0x15, 0x1F)  /* 9 */
+
+// Letters A-Z (uppercase only)
+#define LETTER_GLYPHS(GLYPH) \
+    GLYPH(0x1F, 0x05, 0x1F)  /* A */ \
+    GLYPH(0x1F, 0x15, 0x0A)  /* B */ \
+    GLYPH(0x1F, 0x11, 0x11)  /* C */ \
+    GLYPH(0x1F, 0x11, 0x0E)  /* D */ \
+    GLYPH(0x1F, 0x15, 0x15)  /* E */ \
+    GLYPH(0x1F, 0x05, 0x05)  /* F */ \
+    GLYPH(0x1F, 0x11, 0x1D)  /* G */ \
+    GLYPH(0x1F, 0x04, 0x1F)  /* H */ \
+    GLYPH(0x11, 0x1F, 0x11)  /* I */ \
+    GLYPH(0x19, 0x11, 0x1F)  /* J */ \
+    GLYPH(0x1F, 0x0A, 0x11)  /* K */ \
+    GLYPH(0x1F, 0x10, 0x10)  /* L */ \
+    GLYPH(0x1F, 0x06, 0x1F)  /* M */ \
+    GLYPH(0x1F, 0x0E, 0x1F)  /* N */ \
+    GLYPH(0x1F, 0x11, 0x1F)  /* O */ \
+    GLYPH(0x1F, 0x05, 0x07)  /* P */ \
+    GLYPH(0x0F, 0x09, 0x1F)  /* Q */ \
+    GLYPH(0x1F, 0x05, 0x1B)  /* R */ \
+    GLYPH(0x17, 0x15, 0x1D)  /* S */ \
+    GLYPH(0x01, 0x1F, 0x01)  /* T */ \
+    GLYPH(0x1F, 0x10, 0x1F)  /* U */ \
+    GLYPH(0x0F, 0x10, 0x0F)  /* V */ \
+    GLYPH(0x1F, 0x0C, 0x1F)  /* W */ \
+    GLYPH(0x1B, 0x04, 0x1B)  /* X */ \
+    GLYPH(0x03, 0x1C, 0x03)  /* Y */ \
+    GLYPH(0x19, 0x15, 0x13)  /* Z */
+
+#define DIGIT_GLYPH_COUNT  10
+#define LETTER_GLYPH_COUNT 26
+
+// Repeat every row of a column s times (s-bit mask m per row), at compile time
+#define SCALE_ROWS(c, s, m) (((c) & 0x01 ? (m)                 : 0) | \
+                             ((c) & 0x02 ? (m) << (1 * (s))    : 0) | \
+                             ((c) & 0x04 ? (m) << (2 * (s))    : 0) | \
+                             ((c) & 0x08 ? (m) << (3 * (s))    : 0) | \
+                             ((c) & 0x10 ? (m) << (4 * (s))    : 0))
+
+#define GLYPH_X1(a, b, c) {(a), (b), (c)},
+#define GLYPH_X2(a, b, c) {SCALE_ROWS(a, 2, 0x3u), SCALE_ROWS(b, 2, 0x3u), SCALE_ROWS(c, 2, 0x3u)},
+#define GLYPH_X6(a, b, c) {SCALE_ROWS(a, 6, 0x3FUL), SCALE_ROWS(b, 6, 0x3FUL), SCALE_ROWS(c, 6, 0x3FUL)},
+
+// Scale 1: profiler overlay, labels
+static const uint8_t DIGIT_BITMAPS[DIGIT_GLYPH_COUNT][DIGIT_WIDTH] = { DIGIT_GLYPHS(GLYPH_X1) };
+static const uint8_t LETTER_BITMAPS[LETTER_GLYPH_COUNT][DIGIT_WIDTH] = { LETTER_GLYPHS(GLYPH_X1) };
+
+// Scale 2 (10 rows): titles and scores
+static const uint16_t DIGIT_BITMAPS_X2[DIGIT_GLYPH_COUNT][DIGIT_WIDTH] = { DIGIT_GLYPHS(GLYPH_X2) };
+static const uint16_t LETTER_BITMAPS_X2[LETTER_GLYPH_COUNT][DIGIT_WIDTH] = { LETTER_GLYPHS(GLYPH_X2) };
+
+// Scale 6 (30 rows): countdown digits
+static const uint32_t DIGIT_BITMAPS_X6[DIGIT_GLYPH_COUNT][DIGIT_WIDTH] = { DIGIT_GLYPHS(GLYPH_X6) };
 
 /*============================================================================
- * LETTER BITMAPS (3x5 pixels)
+ * NUMBER CACHE
  *==========================================================================*/
 
 /**
- * Letter bitmaps for A-Z (uppercase only)
- * Same format as digits: 5 rows of 3 bits each
+ * Digits of a recently drawn number, most significant first
+ * Two entries keep the score and the countdown from evicting each other
  */
-static const uint8_t LETTER_BITMAPS[26][5] = {
-    {0b111, 0b101, 0b111, 0b101, 0b101},  // A
-    {0b110, 0b101, 0b110, 0b101, 0b110},  // B
-    {0b111, 0b100, 0b100, 0b100, 0b111},  // C
-    {0b110, 0b101, 0b101, 0b101, 0b110},  // D
-    {0b111, 0b100, 0b111, 0b100, 0b111},  // E
-    {0b111, 0b100, 0b111, 0b100, 0b100},  // F
-    {0b111, 0b100, 0b101, 0b101, 0b111},  // G
-    {0b101, 0b101, 0b111, 0b101, 0b101},  // H
-    {0b111, 0b010, 0b010, 0b010, 0b111},  // I
-    {0b111, 0b001, 0b001, 0b101, 0b111},  // J
-    {0b101, 0b110, 0b100, 0b110, 0b101},  // K
-    {0b100, 0b100, 0b100, 0b100, 0b111},  // L
-    {0b101, 0b111, 0b111, 0b101, 0b101},  // M
-    {0b101, 0b111, 0b111, 0b111, 0b101},  // N
-    {0b111, 0b101, 0b101, 0b101, 0b111},  // O
-    {0b111, 0b101, 0b111, 0b100, 0b100},  // P
-    {0b111, 0b101, 0b101, 0b111, 0b001},  // Q
-    {0b111, 0b101, 0b110, 0b101, 0b101},  // R
-    {0b111, 0b100, 0b111, 0b001, 0b111},  // S
-    {0b111, 0b010, 0b010, 0b010, 0b010},  // T
-    {0b101, 0b101, 0b101, 0b101, 0b111},  // U
-    {0b101, 0b101, 0b101, 0b101, 0b010},  // V
-    {0b101, 0b101, 0b111, 0b111, 0b101},  // W
-    {0b101, 0b101, 0b010, 0b101, 0b101},  // X
-    {0b101, 0b101, 0b010, 0b010, 0b010},  // Y
-    {0b111, 0b001, 0b010, 0b100, 0b111},  // Z
+typedef struct {
+    uint16_t number;
+    uint8_t digit_count;
+    uint8_t digits[5];                                   // Max 5 digits for uint16_t (65535)
+} NumberDigits;
+
+static NumberDigits number_cache[TEXT_NUMBER_CACHE_SIZE] = {
+    {0, 1, {0}}, {0, 1, {0}}                             // Both hold "0"
 };
+static uint8_t number_cache_next = 0;                    // Entry replaced on the next miss
+
+static const uint16_t POWERS_OF_TEN[] = {10000, 1000, 100, 10};
+
+/**
+ * Get the digits of a number, formatting it only on a cache miss
+ */
+static const NumberDigits* numberDigits(uint16_t number) {
+    for (uint8_t i = 0; i < TEXT_NUMBER_CACHE_SIZE; i++) {
+        if (number_cache[i].number == number) return &number_cache[i];
+    }
+
+    NumberDigits* entry = &number_cache[number_cache_next];
+    if (++number_cache_next == TEXT_NUMBER_CACHE_SIZE) number_cache_next = 0;
+
+    // Extract digits left to right by subtracting powers of ten (no
+    // division on the AVR); leading zeros are skipped, the units digit is not
+    uint8_t count = 0;
+    uint16_t rest = number;
+    for (uint8_t i = 0; i < sizeof(POWERS_OF_TEN) / sizeof(POWERS_OF_TEN[0]); i++) {
+        uint8_t digit = 0;
+        while (rest >= POWERS_OF_TEN[i]) {
+            rest -= POWERS_OF_TEN[i];
+            digit++;
+        }
+        if (digit != 0 || count != 0) {
+            entry->digits[count++] = digit;
+        }
+    }
+    entry->digits[count++] = (uint8_t)rest;
+
+    entry->number = number;
+    entry->digit_count = count;
+    return entry;
+}
 
 /*============================================================================
  * HELPER FUNCTIONS
  *==========================================================================*/
 
 /**
- * Draw a single character at specified position
- * Handles uppercase letters (A-Z), digits (0-9), and space
- * @param x X position (top-left)
- * @param y Y position (top-left)
- * @param c Character to draw
- * @param color Color to draw
- * @param scale Scale factor (1=normal, 2=2x, etc.)
+ * Map a character to its glyph
+ * @return 0-9 for digits, 10-35 for letters (any case), 0xFF otherwise
  */
-static void drawChar(uint8_t x, uint8_t y, char c, OLED_color color, uint8_t scale) {
-    if (scale == 0) scale = 1;  // Prevent divide by zero
+static uint8_t glyphIndex(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'Z') return DIGIT_GLYPH_COUNT + (c - 'A');
+    if (c >= 'a' && c <= 'z') return DIGIT_GLYPH_COUNT + (c - 'a');  // Convert lowercase to uppercase
+    return 0xFF;                                                     // Space or unsupported
+}
+
+/**
+ * Get one column of a glyph scaled vertically (bit 0 = top row)
+ * Uses the pre-scaled tables where there is one, otherwise spreads the
+ * rows now
+ * @param glyph Glyph index from glyphIndex()
+ * @param col Column (0 to DIGIT_WIDTH - 1)
+ * @param scale Scale factor (1 to TEXT_MAX_SCALE)
+ */
+static uint32_t glyphColumn(uint8_t glyph, uint8_t col, uint8_t scale) {
+    uint8_t is_digit = glyph < DIGIT_GLYPH_COUNT;
+    uint8_t letter = glyph - DIGIT_GLYPH_COUNT;
 
-    const uint8_t* bitmap = NULL;
-
-    // Determine which bitmap to use
-    if (c >= '0' && c <= '9') {
-        bitmap = DIGIT_BITMAPS[c - '0'];
-    } else if (c >= 'A' && c <= 'Z') {
-        bitmap = LETTER_BITMAPS[c - 'A'];
-    } else if (c >= 'a' && c <= 'z') {
-        bitmap = LETTER_BITMAPS[c - 'a'];  // Convert lowercase to uppercase
-    } else if (c == ' ') {
-        return;  // Space - just skip (spacing handled by caller)
-    } else {
-        return;  // Unsupported character
+    switch (scale) {
+        case 1: return is_digit ? DIGIT_BITMAPS[glyph][col] : LETTER_BITMAPS[letter][col];
+        case 2: return is_digit ? DIGIT_BITMAPS_X2[glyph][col] : LETTER_BITMAPS_X2[letter][col];
+        case 6: if (is_digit) return DIGIT_BITMAPS_X6[glyph][col]; break;
+        default: break;
     }
 
-    // Draw each row of the character
-    for (uint8_t row = 0; row < DIGIT_HEIGHT; row++) {
-        uint8_t row_data = bitmap[row];
-
-        // Draw each pixel in the row (3 bits)
-        for (uint8_t col = 0; col < DIGIT_WIDTH; col++) {
-            if (row_data & (1 << (DIGIT_WIDTH - 1 - col))) {
-                // Draw scaled pixel (scale x scale block)
-                for (uint8_t sy = 0; sy < scale; sy++) {
-                    for (uint8_t sx = 0; sx < scale; sx++) {
-                        drawPixel((Point){x + col * scale + sx, y + row * scale + sy}, color);
-                    }
-                }
+    uint8_t rows = is_digit ? DIGIT_BITMAPS[glyph][col] : LETTER_BITMAPS[letter][col];
+    uint32_t row_mask = (1UL << scale) - 1;
+    uint32_t column = 0;
+    for (uint8_t row = 0; row < DIGIT_HEIGHT; row++, row_mask <<= scale) {
+        if (rows & (1 << row)) column |= row_mask;
+    }
+    return column;
+}
+
+/**
+ * Draw a glyph larger than TEXT_MAX_SCALE as one filled block per pixel
+ */
+static void drawGlyphBlocks(uint8_t x, uint8_t y, uint8_t glyph, OLED_color color, uint8_t scale) {
+    for (uint8_t col = 0; col < DIGIT_WIDTH; col++) {
+        uint8_t rows = (uint8_t)glyphColumn(glyph, col, 1);
+        for (uint8_t row = 0; row < DIGIT_HEIGHT; row++) {
+            if (rows & (1 << row)) {
+                fillRect((Point){x + col * scale, y + row * scale}, scale, scale, color);
             }
         }
     }
 }
 
 /**
- * Draw a single digit at specified position
+ * Draw a single character at specified position
+ * Handles uppercase letters (A-Z), digits (0-9), and space
+ * Every glyph column is blitted as a sprite of scale identical columns
+ * (two when taller than 16 rows), i.e. a few masked byte writes per page
  * @param x X position (top-left)
  * @param y Y position (top-left)
- * @param digit Digit to draw (0-9)
+ * @param c Character to draw
  * @param color Color to draw
  * @param scale Scale factor (1=normal, 2=2x, etc.)
  */
-static void drawDigit(uint8_t x, uint8_t y, uint8_t digit, OLED_color color, uint8_t scale) {
-    if (digit > 9) return;  // Invalid digit
-    drawChar(x, y, '0' + digit, color, scale);
+static void drawChar(uint8_t x, uint8_t y, char c, OLED_color color, uint8_t scale) {
+    if (scale == 0) scale = 1;  // Prevent divide by zero
+
+    uint8_t glyph = glyphIndex(c);
+    if (glyph == 0xFF) return;  // Space - just skip (spacing handled by caller)
+
+    if (scale > TEXT_MAX_SCALE) {
+        drawGlyphBlocks(x, y, glyph, color, scale);
+        return;
+    }
+
+    uint16_t run[TEXT_MAX_SCALE];
+    int16_t left = x;
+    for (uint8_t col = 0; col < DIGIT_WIDTH; col++, left += scale) {
+        uint32_t column = glyphColumn(glyph, col, scale);
+
+        // Rows 0-15, then rows 16-31
+        for (uint8_t half = 0; half < 2; half++, column >>= 16) {
+            uint16_t part = (uint16_t)column;
+            if (part == 0) continue;
+            for (uint8_t i = 0; i < scale; i++) run[i] = part;
+            drawSprite(left, (int16_t)y + half * 16, run, scale, color);
+        }
+    }
 }
 
 /*============================================================================
@@ -141,30 +245,17 @@ static void drawDigit(uint8_t x, uint8_t y, uint8_t digit, OLED_color color, uin
 
 void drawNumber(uint8_t x, uint8_t y, uint16_t number, OLED_color color, uint8_t scale) {
     if (scale == 0) scale = 1;  // Prevent issues
+    if (DISPLAY_LIST_TEXT(x, y, NULL, number, color, scale)) return;
 
-    // Handle zero as special case
-    if (number == 0) {
-        drawDigit(x, y, 0, color, scale);
-        return;
-    }
-
-    // Extract digits (right to left)
-    uint8_t digits[5];  // Max 5 digits for uint16_t (65535)
-    uint8_t digit_count = 0;
-
-    uint16_t temp = number;
-    while (temp > 0 && digit_count < 5) {
-        digits[digit_count++] = temp % 10;
-        temp /= 10;
-    }
+    const NumberDigits* text = numberDigits(number);
 
-    // Draw digits (left to right, so reverse the array)
+    // Draw digits (left to right)
     uint8_t current_x = x;
     uint8_t scaled_width = DIGIT_WIDTH * scale;
     uint8_t scaled_spacing = DIGIT_SPACING * scale;
 
-    for (int8_t i = digit_count - 1; i >= 0; i--) {
-        drawDigit(current_x, y, digits[i], color, scale);
+    for (uint8_t i = 0; i < text->digit_count; i++) {
+        drawChar(current_x, y, '0' + text->digits[i], color, scale);
         current_x += scaled_width + scaled_spacing;
     }
 }
@@ -172,6 +263,7 @@ void drawNumber(uint8_t x, uint8_t y, uint16_t number, OLED_color color, uint8_t
 void drawText(uint8_t x, uint8_t y, const char* text, OLED_color color, uint8_t scale) {
     if (text == NULL || scale == 0) return;
     if (scale == 0) scale = 1;
+    if (DISPLAY_LIST_TEXT(x, y, text, 0, color, scale)) return;
 
     uint8_t current_x = x;
     uint8_t scaled_width = DIGIT_WIDTH * scale;
@@ -5,6 +5,12 @@
  *
  * Provides minimal text rendering capability for displaying numeric values
  * (score, lives, etc.) using tiny 3x5 pixel digit bitmaps.
+ *
+ * Glyphs are stored in the display's page format and blitted column by
+ * column with masked byte writes (drawSprite()); scales 1, 2 and 6 (digits)
+ * use pre-scaled tables. drawNumber() keeps the digits of the last
+ * TEXT_NUMBER_CACHE_SIZE numbers, so an unchanged number is not divided
+ * again.
  *==========================================================================*/
 
 #ifndef TEXT_H
@@ -21,6 +27,9 @@
 #define DIGIT_HEIGHT 5   // Height of each digit in pixels
 #define DIGIT_SPACING 1  // Space between digits in pixels
 
+#define TEXT_MAX_SCALE 6          // Largest scale blitted by columns (5 x 6 = 30 rows)
+#define TEXT_NUMBER_CACHE_SIZE 2  // Recently drawn numbers kept formatted
+
 /*============================================================================
  * TEXT RENDERING FUNCTIONS
  *==========================================================================*/
@@ -0,0 +1,97 @@
+/*============================================================================
+ * timer.c
+ *============================================================================
+ * Fixed-rate tick timer implementation
+ *==========================================================================*/
+
+#include "timer.h"
+#include "hal.h"
+
+/*============================================================================
+ * TICK COUNTER
+ *==========================================================================*/
+
+static volatile uint16_t tick_count = 0;
+
+/**
+ * Tick handler - runs from the RTC periodic interrupt (via the HAL)
+ */
+static void on_tick(void) {
+    tick_count++;
+}
+
+/*============================================================================
+ * TIMER INITIALIZATION
+ *==========================================================================*/
+
+void init_timer(void) {
+    hal_tick_init(on_tick);                                                  // RTC PIT: 32768 / 512 = 64 Hz
+}
+
+/*============================================================================
+ * TIMER OPERATIONS
+ *==========================================================================*/
+
+uint16_t timer_ticks(void) {
+    // 16-bit read is not atomic on AVR - re-read until stable
+    uint16_t ticks;
+    do {
+        ticks = tick_count;
+    } while (ticks != tick_count);
+    return ticks;
+}
+
+uint8_t timer_tick_elapsed(uint16_t tick) {
+    return (int16_t)(timer_ticks() - tick) >= 0;
+}
+
+/*============================================================================
+ * DELAYS AND UPTIME
+ *==========================================================================*/
+
+// Counter cycles per µs in Q14 (fits 65535 µs in 32 bits up to 4 MHz counters)
+#define TIMER_COUNTS_PER_US_Q14 ((HAL_COUNTER_HZ * 16384UL + 999999UL) / 1000000UL)
+
+static uint32_t uptime_counts = 0;                       // Cycles up to uptime_last
+static uint16_t uptime_last = 0;                         // Counter at the last read
+static uint16_t boot_ms = 0;
+
+void init_delay(void) {
+    hal_counter_init();
+    uptime_last = hal_counter_read();
+    uptime_counts = 0;
+}
+
+uint32_t timer_uptime(void) {
+    uint16_t now = hal_counter_read();
+    uptime_counts += (uint16_t)(now - uptime_last);                          // Wrap-safe
+    uptime_last = now;
+    return uptime_counts;
+}
+
+/**
+ * Wait until a number of counter cycles has passed
+ */
+static void wait_counts(uint32_t counts) {
+    uint32_t start = timer_uptime();
+    while (timer_uptime() - start < counts) {}
+}
+
+void delay_us(uint16_t us) {
+    // +1: the first cycle may already be partly over
+    wait_counts((((uint32_t)us * TIMER_COUNTS_PER_US_Q14) >> 14) + 1);
+}
+
+void delay_ms(uint16_t ms) {
+    wait_counts((uint32_t)ms * TIMER_COUNTS_PER_MS + 1);
+}
+
+void timer_mark_boot_done(void) {
+    if (boot_ms != 0) return;
+    uint32_t ms = timer_uptime() / TIMER_COUNTS_PER_MS;
+    boot_ms = (ms == 0) ? 1 : (ms > 0xFFFF) ? 0xFFFF : (uint16_t)ms;
+}
+
+uint16_t timer_boot_ms(void) {
+    return boot_ms;
+}
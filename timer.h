@@ -0,0 +1,118 @@
+/*============================================================================
+ * timer.h
+ *============================================================================
+ * Fixed-rate tick timer for the game loop, and busy-wait delays
+ *
+ * The RTC periodic interrupt (PIT) runs from the internal 32.768 kHz
+ * oscillator and counts simulation ticks at TICK_RATE_HZ, independent of
+ * CPU clock, SPI speed and how long a frame takes to render.
+ *
+ * Short delays (display bring-up) and the boot time are measured with the
+ * HAL free-running counter instead, so they do not depend on loop timing,
+ * optimisation level or interrupts being enabled.
+ *
+ * Architecture:
+ *     main.c (runs one update per elapsed tick, renders when link is free)
+ *         ↓
+ *     timer.c (tick counter)
+ *         ↓
+ *     hal.h (ATtiny1627 RTC/PIT, or host mock)
+ *
+ * USAGE:
+ *     init_delay();                     // First thing in main()
+ *     delay_us(10);
+ *
+ *     init_timer();
+ *     hal_interrupts_enable();
+ *
+ *     uint16_t next_tick = timer_ticks();
+ *     while (1) {
+ *         while (timer_tick_elapsed(next_tick)) {
+ *             update_game_controller(&game);
+ *             next_tick++;
+ *         }
+ *     }
+ *==========================================================================*/
+
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <stdint.h>
+#include "hal.h"
+
+/*============================================================================
+ * TIMER CONFIGURATION
+ *==========================================================================*/
+
+#define TIMER_RTC_CLOCK_HZ 32768UL                       // RTC source (internal ULP oscillator)
+#define TICK_RATE_HZ       64                            // Simulation ticks per second (PIT, 512 RTC cycles)
+
+#define TIMER_COUNTS_PER_MS ((HAL_COUNTER_HZ + 999UL) / 1000UL)          // Counter cycles per ms (rounded up)
+
+/*============================================================================
+ * TIMER OPERATIONS
+ *==========================================================================*/
+
+/**
+ * Initialize the RTC periodic interrupt as the simulation tick source
+ * Ticks are counted from the interrupt, so global interrupts must be enabled
+ */
+void init_timer(void);
+
+/**
+ * Get the number of ticks since init_timer()
+ * Wraps after 65536 ticks (~17 minutes); compare with timer_tick_elapsed()
+ * @return Current tick count
+ */
+uint16_t timer_ticks(void);
+
+/**
+ * Check whether a given tick has been reached (wrap-safe)
+ * @param tick Tick number to test
+ * @return 1 if the tick count is at or past tick, 0 otherwise
+ */
+uint8_t timer_tick_elapsed(uint16_t tick);
+
+/*============================================================================
+ * DELAYS AND UPTIME
+ *==========================================================================*/
+
+/**
+ * Start the HAL free-running counter used by delays, boot time, the
+ * power manager and the profiler
+ */
+void init_delay(void);
+
+/**
+ * Get the counter cycles since init_delay() (HAL_COUNTER_HZ)
+ * Extends the 16-bit counter, so it must be read at least once per
+ * counter period (0.42 s at 10 MHz); the delays below do
+ * @return Elapsed counter cycles
+ */
+uint32_t timer_uptime(void);
+
+/**
+ * Busy-wait for at least a number of microseconds
+ * @param us Minimum delay (rounded up to the counter resolution)
+ */
+void delay_us(uint16_t us);
+
+/**
+ * Busy-wait for at least a number of milliseconds
+ * @param ms Minimum delay
+ */
+void delay_ms(uint16_t ms);
+
+/**
+ * Record that start-up is complete (first frame shown)
+ * Only the first call counts
+ */
+void timer_mark_boot_done(void);
+
+/**
+ * Get the time from init_delay() to timer_mark_boot_done()
+ * @return Boot time in ms, 0 until marked
+ */
+uint16_t timer_boot_ms(void);
+
+#endif // TIMER_H